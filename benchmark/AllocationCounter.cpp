@@ -0,0 +1,103 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "Benchmark.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<size_t> allocations(0);
+std::atomic<size_t> liveBytes(0);
+std::atomic<size_t> peakBytes(0);
+
+void updatePeak(size_t bytes) {
+  size_t peak = peakBytes.load(std::memory_order_relaxed);
+  while (bytes > peak &&
+         !peakBytes.compare_exchange_weak(peak, bytes,
+                                          std::memory_order_relaxed)) {
+  }
+}
+
+// Every block is prefixed with its size so that deletions can be accounted.
+const size_t HEADER_SIZE = alignof(std::max_align_t);
+
+void* allocate(size_t size) {
+  void* block = std::malloc(size + HEADER_SIZE);
+  if (block == NULL) throw std::bad_alloc();
+
+  *static_cast<size_t*>(block) = size;
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  updatePeak(liveBytes.fetch_add(size, std::memory_order_relaxed) + size);
+  return static_cast<char*>(block) + HEADER_SIZE;
+}
+
+void deallocate(void* pointer) {
+  if (pointer == NULL) return;
+
+  void* block = static_cast<char*>(pointer) - HEADER_SIZE;
+  liveBytes.fetch_sub(*static_cast<size_t*>(block), std::memory_order_relaxed);
+  std::free(block);
+}
+}
+
+void* operator new(size_t size) { return allocate(size); }
+void* operator new[](size_t size) { return allocate(size); }
+void operator delete(void* pointer) noexcept { deallocate(pointer); }
+void operator delete[](void* pointer) noexcept { deallocate(pointer); }
+
+namespace intent {
+namespace benchmark {
+AllocationStats allocationStats() {
+  AllocationStats stats;
+  stats.allocations = allocations.load(std::memory_order_relaxed);
+  stats.liveBytes = liveBytes.load(std::memory_order_relaxed);
+  stats.peakBytes = peakBytes.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void resetPeakBytes() {
+  peakBytes.store(liveBytes.load(std::memory_order_relaxed),
+                  std::memory_order_relaxed);
+}
+}
+}
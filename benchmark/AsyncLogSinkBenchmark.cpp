@@ -0,0 +1,136 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "Benchmark.hpp"
+
+#include "intent/utils/AsyncLogSink.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <thread>
+
+using namespace intent;
+using namespace intent::benchmark;
+
+namespace {
+const size_t PRODUCER_COUNT = 4;
+const size_t MESSAGES_PER_PRODUCER = 20000;
+
+typedef std::function<void(const std::string&)> LogFunction;
+
+/**
+ * \brief Log from several threads and return the latencies of the calls in
+ * nanoseconds, sorted.
+ */
+std::vector<double> measureLatencies(const LogFunction& logFunction) {
+  std::vector<std::vector<double>> latencies(PRODUCER_COUNT);
+  std::vector<std::thread> producers;
+  for (size_t p = 0; p < PRODUCER_COUNT; ++p) {
+    producers.emplace_back([&logFunction, &latencies, p]() {
+      std::string message =
+          "Intent resolved for message of producer " + std::to_string(p);
+      latencies[p].reserve(MESSAGES_PER_PRODUCER);
+      for (size_t i = 0; i < MESSAGES_PER_PRODUCER; ++i) {
+        std::chrono::steady_clock::time_point start =
+            std::chrono::steady_clock::now();
+        logFunction(message);
+        std::chrono::steady_clock::time_point end =
+            std::chrono::steady_clock::now();
+        latencies[p].push_back(
+            std::chrono::duration<double, std::nano>(end - start).count());
+      }
+    });
+  }
+  for (std::thread& producer : producers) producer.join();
+
+  std::vector<double> allLatencies;
+  for (const std::vector<double>& producerLatencies : latencies)
+    allLatencies.insert(allLatencies.end(), producerLatencies.begin(),
+                        producerLatencies.end());
+  std::sort(allLatencies.begin(), allLatencies.end());
+  return allLatencies;
+}
+
+void reportLatencies(const std::string& name,
+                     const std::vector<double>& latencies) {
+  report(name + " p50", latencies[latencies.size() / 2]);
+  report(name + " p99", latencies[latencies.size() * 99 / 100]);
+  report(name + " max", latencies.back());
+}
+}
+
+int main() {
+  // A flushed write per message, like the synchronous stdout sink.
+  FILE* output = std::fopen("/dev/null", "w");
+  std::mutex outputMutex;
+  auto write = [output, &outputMutex](const std::string& message) {
+    std::lock_guard<std::mutex> lock(outputMutex);
+    std::fprintf(output, "%s\n", message.c_str());
+    std::fflush(output);
+  };
+
+  reportLatencies("synchronous", measureLatencies(write));
+
+  {
+    log::AsyncLogSink sink(
+        8192, log::AsyncLogSink::OverflowPolicy::BLOCK,
+        [&write](int, const std::string& message) { write(message); });
+    reportLatencies("asynchronous (block)",
+                    measureLatencies([&sink](const std::string& message) {
+                      sink.push(0, message);
+                    }));
+  }
+
+  {
+    log::AsyncLogSink sink(
+        8192, log::AsyncLogSink::OverflowPolicy::DROP_NEWEST,
+        [&write](int, const std::string& message) { write(message); });
+    reportLatencies("asynchronous (drop newest)",
+                    measureLatencies([&sink](const std::string& message) {
+                      sink.push(0, message);
+                    }));
+    sink.flush();
+    reportCount("asynchronous (drop newest) dropped messages",
+                sink.droppedMessages());
+  }
+
+  std::fclose(output);
+  return 0;
+}
@@ -0,0 +1,162 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef INTENT_BENCHMARK_HPP
+#define INTENT_BENCHMARK_HPP
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace intent {
+namespace benchmark {
+/**
+ * \brief Number of allocations and bytes allocated by the process.
+ *
+ * The counters are maintained by the global operator new and delete
+ * replacements of AllocationCounter.cpp that every benchmark links.
+ */
+struct AllocationStats {
+  size_t allocations;
+  size_t liveBytes;
+  // The highest number of live bytes since the last resetPeakBytes call.
+  size_t peakBytes;
+};
+
+AllocationStats allocationStats();
+
+/**
+ * \brief Restart the tracking of the peak from the current live bytes.
+ */
+void resetPeakBytes();
+
+/**
+ * \brief Run a function several times and return the mean duration of one run
+ * in nanoseconds.
+ */
+template <typename Function>
+double measure(Function function, size_t iterations) {
+  std::chrono::steady_clock::time_point start =
+      std::chrono::steady_clock::now();
+  for (size_t i = 0; i < iterations; ++i) function();
+  std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+  return std::chrono::duration<double, std::nano>(end - start).count() /
+         iterations;
+}
+
+/**
+ * \brief Generate a random lowercase word.
+ */
+inline std::string randomWord(std::mt19937& generator, size_t minLength,
+                              size_t maxLength) {
+  std::uniform_int_distribution<size_t> length(minLength, maxLength);
+  std::uniform_int_distribution<int> letter('a', 'z');
+
+  std::string word(length(generator), ' ');
+  for (char& c : word) c = static_cast<char>(letter(generator));
+  return word;
+}
+
+/**
+ * \brief Introduce one substitution in a word.
+ */
+inline std::string misspell(std::mt19937& generator, const std::string& word) {
+  if (word.empty()) return word;
+  std::uniform_int_distribution<size_t> position(0, word.size() - 1);
+  std::string misspelled = word;
+  misspelled[position(generator)] = 'z';
+  return misspelled;
+}
+
+/**
+ * \brief Generate the JSON document of a model with random terms and aliases
+ * and intents made of two entities.
+ */
+inline std::string generateModelDocument(std::mt19937& generator,
+                                         size_t entityCount,
+                                         size_t termsPerEntity,
+                                         size_t aliasesPerTerm,
+                                         size_t intentCount) {
+  std::stringstream ss;
+  ss << "{\"entities\": {";
+  for (size_t e = 0; e < entityCount; ++e) {
+    if (e > 0) ss << ", ";
+    ss << "\"@entity" << e << "\": {";
+    for (size_t t = 0; t < termsPerEntity; ++t) {
+      if (t > 0) ss << ", ";
+      ss << "\"" << randomWord(generator, 4, 12) << t << "\": [";
+      for (size_t a = 0; a < aliasesPerTerm; ++a) {
+        if (a > 0) ss << ", ";
+        ss << "\"" << randomWord(generator, 4, 12) << "\"";
+      }
+      ss << "]";
+    }
+    ss << "}";
+  }
+  ss << "}, \"intents\": [";
+  for (size_t i = 0; i < intentCount; ++i) {
+    if (i > 0) ss << ", ";
+    ss << "{\"id\": \"intent" << i << "\", \"intent\": [\"@entity"
+       << i % entityCount << "\", \"@entity" << (i + 1) % entityCount
+       << "\"]}";
+  }
+  ss << "]}";
+  return ss.str();
+}
+
+inline void report(const std::string& name, double nanoseconds) {
+  std::printf("%-50s %12.1f ns\n", name.c_str(), nanoseconds);
+}
+
+inline void reportCount(const std::string& name, double count) {
+  std::printf("%-50s %12.1f\n", name.c_str(), count);
+}
+
+inline void reportBytes(const std::string& name, size_t bytes) {
+  std::printf("%-50s %12zu bytes\n", name.c_str(), bytes);
+}
+}
+}
+
+#endif  // INTENT_BENCHMARK_HPP
@@ -0,0 +1,103 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "Benchmark.hpp"
+
+#include "intent/utils/Deserializer.hpp"
+
+#include <sstream>
+
+using namespace intent;
+using namespace intent::benchmark;
+
+namespace {
+template <typename Function>
+void measureLoad(const std::string& name, Function function) {
+  size_t liveBytesBefore = allocationStats().liveBytes;
+  resetPeakBytes();
+  double nanoseconds = measure(function, 1);
+  AllocationStats stats = allocationStats();
+  reportBytes(name + " peak memory", stats.peakBytes - liveBytesBefore);
+  reportBytes(name + " model memory", stats.liveBytes - liveBytesBefore);
+  report(name + " load time", nanoseconds);
+}
+}
+
+int main() {
+  std::mt19937 generator(42);
+  std::string document = generateModelDocument(generator, 20, 5000, 3, 200);
+  reportBytes("document size", document.size());
+
+  Deserializer deserializer;
+  IntentServiceModel model;
+
+  measureLoad("DOM", [&document, &deserializer, &model]() {
+    std::istringstream is(document);
+    std::istreambuf_iterator<char> eos;
+    std::string content(std::istreambuf_iterator<char>(is), eos);
+    model = deserializer.deserialize<IntentServiceModel>(
+        nlohmann::json::parse(content));
+  });
+  model = IntentServiceModel();
+
+  measureLoad("stream", [&document, &deserializer, &model]() {
+    std::istringstream is(document);
+    model = deserializer.deserialize<IntentServiceModel>(is);
+  });
+  reportCount("terms", model.dictionaryModel->dictionary.size());
+  model = IntentServiceModel();
+
+  // The floor of the loaders: the same number of terms pushed one by one in
+  // the order of their ids, without any document.
+  measureLoad("pushed terms", [&generator, &model]() {
+    model.dictionaryModel.reset(new DictionaryModel());
+    for (int termId = 0; termId < 20 * 5000; ++termId) {
+      Term term;
+      term.term = randomWord(generator, 4, 12);
+      term.termId = termId;
+      term.entityId = termId / 5000;
+      for (int a = 0; a < 3; ++a)
+        term.alias.push_back(randomWord(generator, 4, 12));
+      model.dictionaryModel->dictionary.pushTerm(term);
+    }
+    model.dictionaryModel->dictionary.compact();
+  });
+  return 0;
+}
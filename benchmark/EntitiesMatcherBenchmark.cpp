@@ -0,0 +1,156 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "Benchmark.hpp"
+
+#include "intent/intent_service/DictionaryModel.hpp"
+#include "intent/intent_service/EntitiesMatcher.hpp"
+
+#include <algorithm>
+
+using namespace intent;
+using namespace intent::benchmark;
+
+namespace {
+const size_t TERM_COUNT = 500;
+const size_t TOKENS_PER_RUN = 100000;
+
+DictionaryModel generateDictionary(std::mt19937& generator,
+                                   std::vector<std::string>& words) {
+  DictionaryModel dictionaryModel;
+  for (size_t i = 0; i < TERM_COUNT; ++i) {
+    Term term;
+    term.term = randomWord(generator, 4, 10);
+    term.termId = i;
+    term.entityId = i % 20;
+    // Every other term also has a multi-word alias to exercise the lookahead.
+    if (i % 2 == 0)
+      term.alias.push_back(term.term + " " + randomWord(generator, 3, 6));
+    words.push_back(term.term);
+    dictionaryModel.dictionary.pushTerm(term);
+  }
+  dictionaryModel.dictionary.compact();
+  return dictionaryModel;
+}
+
+/**
+ * \brief A message where one token out of four is a term of the dictionary.
+ */
+Tokenizer::Tokens generateMessage(std::mt19937& generator,
+                                  const std::vector<std::string>& words,
+                                  size_t tokenCount) {
+  Tokenizer::Tokens tokens;
+  for (size_t i = 0; i < tokenCount; ++i) {
+    if (i % 4 == 0)
+      tokens.push_back(words[generator() % words.size()]);
+    else
+      tokens.push_back(randomWord(generator, 2, 8));
+  }
+  return tokens;
+}
+
+/**
+ * \brief The matching loop EntitiesMatcher used to run, copying the rest of
+ * the sentence for each token. Kept here as a baseline.
+ */
+size_t matchWithCopiedLookahead(const Tokenizer::Tokens& tokens,
+                                const DictionaryModel& dictionaryModel) {
+  size_t matches = 0;
+  Tokenizer::Tokens::const_iterator it = tokens.begin();
+  while (it != tokens.end()) {
+    int tokensPopped = 1;
+    const std::vector<std::string> tokenBuffer(it, tokens.end());
+    if (dictionaryModel.dictionary.findTerm(*it, tokenBuffer, tokensPopped)
+            .termId != -1)
+      ++matches;
+    it += tokensPopped;
+  }
+  return matches;
+}
+
+/**
+ * \brief The matching loop without the exact phrase lookup, every token going
+ * through the fuzzy matching.
+ */
+size_t matchWithFuzzyMatchingOnly(const Tokenizer::TokenViews& tokens,
+                                  const DictionaryModel& dictionaryModel) {
+  size_t matches = 0;
+  Tokenizer::TokenViews::const_iterator it = tokens.begin();
+  while (it != tokens.end()) {
+    int tokensPopped = 1;
+    if (dictionaryModel.dictionary
+            .findApproximateTerm(*it, it, tokens.end(), tokensPopped)
+            .termId != -1)
+      ++matches;
+    it += tokensPopped;
+  }
+  return matches;
+}
+}
+
+int main() {
+  std::mt19937 generator(42);
+  std::vector<std::string> words;
+  DictionaryModel dictionaryModel = generateDictionary(generator, words);
+
+  size_t checksum = 0;
+  for (size_t tokenCount = 10; tokenCount <= 10000; tokenCount *= 10) {
+    Tokenizer::Tokens tokens = generateMessage(generator, words, tokenCount);
+    Tokenizer::TokenViews views(tokens.begin(), tokens.end());
+    size_t iterations = std::max<size_t>(1, TOKENS_PER_RUN / tokenCount);
+    std::string size = std::to_string(tokenCount) + " tokens";
+
+    report(size + ": copied lookahead per token",
+           measure([&]() {
+             checksum += matchWithCopiedLookahead(tokens, dictionaryModel);
+           }, iterations) / tokenCount);
+    report(size + ": fuzzy matching only per token",
+           measure([&]() {
+             checksum += matchWithFuzzyMatchingOnly(views, dictionaryModel);
+           }, iterations) / tokenCount);
+    report(size + ": EntitiesMatcher per token",
+           measure([&]() {
+             checksum += EntitiesMatcher::match(views, dictionaryModel).size();
+           }, iterations) / tokenCount);
+  }
+
+  std::printf("checksum %zu\n", checksum);
+  return 0;
+}
@@ -0,0 +1,145 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "Benchmark.hpp"
+
+#include "intent/intent_service/IntentService.hpp"
+#include "intent/utils/Deserializer.hpp"
+#include "intent/utils/Logger.hpp"
+
+#include <thread>
+
+using namespace intent;
+using namespace intent::benchmark;
+
+namespace {
+const size_t ENTITY_COUNT = 10;
+const size_t TERMS_PER_ENTITY = 50;
+const size_t INTENT_COUNT = 30;
+const size_t MESSAGE_COUNT = 20000;
+
+nlohmann::json generateModel(std::mt19937& generator,
+                             std::vector<std::string>& words) {
+  nlohmann::json json;
+  json["version"] = 1;
+  for (size_t e = 0; e < ENTITY_COUNT; ++e) {
+    nlohmann::json terms;
+    for (size_t t = 0; t < TERMS_PER_ENTITY; ++t) {
+      std::string term = randomWord(generator, 4, 10);
+      std::string alias = randomWord(generator, 4, 10);
+      terms[term] = {alias};
+      words.push_back(term);
+      words.push_back(alias);
+    }
+    json["entities"]["@entity" + std::to_string(e)] = terms;
+  }
+
+  nlohmann::json intents = nlohmann::json::array();
+  for (size_t i = 0; i < INTENT_COUNT; ++i) {
+    nlohmann::json entities = nlohmann::json::array();
+    for (size_t k = 0; k < 2 + i % 2; ++k) {
+      size_t entity = generator() % ENTITY_COUNT;
+      entities.push_back("@entity" + std::to_string(entity));
+    }
+    intents.push_back({{"id", "intent" + std::to_string(i)},
+                       {"intent", entities},
+                       {"example", ""}});
+  }
+  json["intents"] = intents;
+  return json;
+}
+
+std::vector<std::string> generateMessages(
+    std::mt19937& generator, const std::vector<std::string>& words) {
+  std::vector<std::string> messages;
+  for (size_t i = 0; i < MESSAGE_COUNT; ++i) {
+    std::string message;
+    size_t wordCount = 8 + generator() % 8;
+    for (size_t w = 0; w < wordCount; ++w) {
+      if (w != 0) message += " ";
+      message += (w % 3 == 0) ? words[generator() % words.size()]
+                              : randomWord(generator, 2, 8);
+    }
+    messages.push_back(message);
+  }
+  return messages;
+}
+}
+
+int main() {
+  log::Logger::initialize(log::Logger::SeverityLevel::FATAL);
+
+  std::mt19937 generator(42);
+  std::vector<std::string> words;
+  nlohmann::json json = generateModel(generator, words);
+  IntentServiceModel model =
+      Deserializer().deserialize<IntentServiceModel>(json);
+  IntentService intentService(model);
+
+  std::vector<std::string> messages = generateMessages(generator, words);
+  IntentService::Inputs inputs(messages.begin(), messages.end());
+
+  size_t found = 0;
+  report("evaluate on the calling thread, per message", measure([&]() {
+           for (const std::string& message : messages)
+             found += intentService.evaluate(message).found;
+         }, 1) / MESSAGE_COUNT);
+
+  std::vector<size_t> threadCounts;
+  size_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+  for (size_t threads = 1; threads < hardwareThreads; threads *= 2)
+    threadCounts.push_back(threads);
+  threadCounts.push_back(hardwareThreads);
+
+  for (size_t threads : threadCounts) {
+    ThreadPool threadPool(threads);
+    report("evaluateBatch with " + std::to_string(threads) +
+               " threads, per message",
+           measure([&]() {
+             IntentService::Results results =
+                 intentService.evaluateBatch(inputs, threadPool);
+             for (const IntentService::Result& result : results)
+               found += result.found;
+           }, 1) / MESSAGE_COUNT);
+  }
+
+  std::printf("checksum %zu\n", found);
+  return 0;
+}
@@ -0,0 +1,233 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "Benchmark.hpp"
+
+#include "intent/interpreter/Interpreter.hpp"
+#include "intent/interpreter/InterpreterCache.hpp"
+#include "intent/utils/Deserializer.hpp"
+#include "intent/utils/Logger.hpp"
+
+#include <fstream>
+#include <thread>
+
+using namespace intent;
+using namespace intent::benchmark;
+
+namespace {
+const size_t ENTITY_COUNT = 10;
+const size_t TERMS_PER_ENTITY = 50;
+const size_t SCENARIO_COUNT = 2000;
+const size_t STEPS_PER_SCENARIO = 4;
+
+nlohmann::json generateDictionary(std::mt19937& generator,
+                                  std::vector<std::string>& words) {
+  nlohmann::json json;
+  json["version"] = 1;
+  for (size_t e = 0; e < ENTITY_COUNT; ++e) {
+    nlohmann::json terms;
+    for (size_t t = 0; t < TERMS_PER_ENTITY; ++t) {
+      std::string term = randomWord(generator, 4, 10);
+      terms[term] = {randomWord(generator, 4, 10)};
+      words.push_back(term);
+    }
+    json["entities"]["@entity" + std::to_string(e)] = terms;
+  }
+  return json;
+}
+
+std::string generateSentence(std::mt19937& generator,
+                             const std::vector<std::string>& words) {
+  std::string sentence;
+  size_t wordCount = 4 + generator() % 6;
+  for (size_t w = 0; w < wordCount; ++w) {
+    if (w != 0) sentence += " ";
+    sentence += (w % 2 == 0) ? words[generator() % words.size()]
+                             : randomWord(generator, 2, 8);
+  }
+  return sentence;
+}
+
+/**
+ * \brief Generate a script where every scenario walks through a few states,
+ * reusing sentences across scenarios as real scripts do.
+ */
+std::string generateScript(std::mt19937& generator,
+                           const std::vector<std::string>& words) {
+  std::vector<std::string> sentences;
+  for (size_t i = 0; i < SCENARIO_COUNT / 4; ++i)
+    sentences.push_back(generateSentence(generator, words));
+
+  std::stringstream ss;
+  for (size_t s = 0; s < SCENARIO_COUNT; ++s) {
+    ss << "{\n@" << (s == 0 ? std::string("root") : "state" + std::to_string(s))
+       << "\n";
+    for (size_t step = 0; step < STEPS_PER_SCENARIO; ++step) {
+      ss << "    -" << sentences[generator() % sentences.size()] << "\n";
+      ss << "        #action" << generator() % 100 << "\n";
+      ss << "    -" << randomWord(generator, 4, 10) << " _ "
+         << randomWord(generator, 4, 10) << "\n";
+      if (step + 1 < STEPS_PER_SCENARIO)
+        ss << "@state" << s << "_" << step << "\n";
+    }
+    ss << "@root\n}\n";
+  }
+  return ss.str();
+}
+
+std::string readFile(const char* path) {
+  std::ifstream file(path);
+  std::stringstream ss;
+  ss << file.rdbuf();
+  return ss.str();
+}
+
+/**
+ * \brief Compile a real script many times.
+ */
+void benchmarkScript(const char* dictionaryPath, const char* scriptPath) {
+  std::ifstream dictionaryFile(dictionaryPath);
+  DictionaryModel::SharedPtr dictionaryModel =
+      Deserializer().deserialize<DictionaryModel::SharedPtr>(dictionaryFile);
+  std::string script = readFile(scriptPath);
+  reportBytes("script size", script.size());
+
+  size_t edges = 0;
+  report("build the script", measure([&]() {
+           InterpreterFeedback feedback;
+           ChatbotModel model =
+               Interpreter::build(script, dictionaryModel, feedback);
+           edges += model.intentStoryServiceModel.intentStoryModel->graph
+                        .edgeCount();
+         }, 1000));
+  std::printf("checksum %zu\n", edges);
+}
+}
+
+int main(int argc, char* argv[]) {
+  log::Logger::initialize(log::Logger::SeverityLevel::FATAL);
+
+  if (argc == 3) {
+    benchmarkScript(argv[1], argv[2]);
+    return 0;
+  }
+
+  std::mt19937 generator(42);
+  std::vector<std::string> words;
+  DictionaryModel::SharedPtr dictionaryModel =
+      Deserializer().deserialize<DictionaryModel::SharedPtr>(
+          generateDictionary(generator, words));
+  std::string script = generateScript(generator, words);
+  reportBytes("script size", script.size());
+
+  size_t edges = 0;
+  report("build on the calling thread, per scenario", measure([&]() {
+           InterpreterFeedback feedback;
+           ChatbotModel model =
+               Interpreter::build(script, dictionaryModel, feedback);
+           edges += model.intentStoryServiceModel.intentStoryModel->graph
+                        .edgeCount();
+         }, 3) / SCENARIO_COUNT);
+
+  std::vector<size_t> threadCounts;
+  size_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+  for (size_t threads = 1; threads < hardwareThreads; threads *= 2)
+    threadCounts.push_back(threads);
+  threadCounts.push_back(hardwareThreads);
+
+  for (size_t threads : threadCounts) {
+    ThreadPool threadPool(threads);
+    report("build with " + std::to_string(threads) + " threads, per scenario",
+           measure([&]() {
+             InterpreterFeedback feedback;
+             ChatbotModel model = Interpreter::build(script, dictionaryModel,
+                                                     feedback, threadPool);
+             edges += model.intentStoryServiceModel.intentStoryModel->graph
+                          .edgeCount();
+           }, 3) / SCENARIO_COUNT);
+  }
+
+  // The peak heap of a build, beyond the model it returns, from the script
+  // read in a string and from the script streamed line by line.
+  {
+    std::stringstream scriptStream(script);
+    size_t live = allocationStats().liveBytes;
+    resetPeakBytes();
+    std::string content((std::istreambuf_iterator<char>(scriptStream)),
+                        std::istreambuf_iterator<char>());
+    InterpreterFeedback feedback;
+    ChatbotModel model = Interpreter::build(content, dictionaryModel, feedback);
+    size_t modelBytes = allocationStats().liveBytes - live - content.size();
+    reportBytes("peak heap of a build from a string",
+                allocationStats().peakBytes - live - modelBytes);
+  }
+  {
+    std::stringstream scriptStream(script);
+    size_t live = allocationStats().liveBytes;
+    resetPeakBytes();
+    InterpreterFeedback feedback;
+    ChatbotModel model =
+        Interpreter::build(scriptStream, dictionaryModel, feedback);
+    size_t modelBytes = allocationStats().liveBytes - live;
+    reportBytes("peak heap of a build from a stream",
+                allocationStats().peakBytes - live - modelBytes);
+  }
+
+  // Every build sees one scenario edited since the previous one.
+  std::string editedScript = script;
+  size_t position =
+      editedScript.find("@state" + std::to_string(SCENARIO_COUNT / 2));
+  editedScript.insert(editedScript.find("-", position) + 1, "edited ");
+  InterpreterCache cache;
+  InterpreterFeedback feedback;
+  Interpreter::build(script, dictionaryModel, feedback, cache);
+  size_t iteration = 0;
+  report("build with one edited scenario, per scenario", measure([&]() {
+           InterpreterFeedback feedback;
+           ChatbotModel model = Interpreter::build(
+               (iteration++ % 2 == 0) ? editedScript : script,
+               dictionaryModel, feedback, cache);
+           edges += model.intentStoryServiceModel.intentStoryModel->graph
+                        .edgeCount();
+         }, 10) / SCENARIO_COUNT);
+
+  std::printf("checksum %zu\n", edges);
+  return 0;
+}
@@ -0,0 +1,103 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "Benchmark.hpp"
+
+#include "intent/utils/Levenshtein.hpp"
+
+#include <utility>
+
+using namespace intent;
+using namespace intent::benchmark;
+
+namespace {
+const size_t PAIR_COUNT = 1000;
+const size_t ITERATIONS = 200000;
+
+typedef std::vector<std::pair<std::string, std::string>> WordPairs;
+
+WordPairs generatePairs(std::mt19937& generator, size_t minLength,
+                        size_t maxLength, bool similar) {
+  WordPairs pairs;
+  for (size_t i = 0; i < PAIR_COUNT; ++i) {
+    std::string word = randomWord(generator, minLength, maxLength);
+    std::string other = similar ? misspell(generator, word)
+                                : randomWord(generator, minLength, maxLength);
+    pairs.push_back(std::make_pair(word, other));
+  }
+  return pairs;
+}
+
+void run(const std::string& name, const WordPairs& pairs) {
+  size_t i = 0;
+  unsigned int checksum = 0;
+
+  AllocationStats before = allocationStats();
+  report(name + ": full distance", measure([&]() {
+           const std::pair<std::string, std::string>& p =
+               pairs[i++ % PAIR_COUNT];
+           checksum += Levenshtein::distance(p.first, p.second);
+         }, ITERATIONS));
+  AllocationStats after = allocationStats();
+  reportCount(name + ": full distance allocations per call",
+         double(after.allocations - before.allocations) / ITERATIONS);
+
+  before = allocationStats();
+  report(name + ": distance bounded to 2", measure([&]() {
+           const std::pair<std::string, std::string>& p =
+               pairs[i++ % PAIR_COUNT];
+           checksum += Levenshtein::distance(p.first, p.second, 2);
+         }, ITERATIONS));
+  after = allocationStats();
+  reportCount(name + ": bounded distance allocations per call",
+         double(after.allocations - before.allocations) / ITERATIONS);
+
+  std::printf("checksum %u\n", checksum);
+}
+}
+
+int main() {
+  std::mt19937 generator(42);
+
+  run("similar words", generatePairs(generator, 4, 12, true));
+  run("different words", generatePairs(generator, 4, 12, false));
+  run("similar sentences", generatePairs(generator, 70, 120, true));
+  return 0;
+}
@@ -0,0 +1,99 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "Benchmark.hpp"
+
+#include "intent/utils/Deserializer.hpp"
+#include "intent/utils/ModelSnapshot.hpp"
+
+#include <cstdio>
+#include <fstream>
+
+using namespace intent;
+using namespace intent::benchmark;
+
+int main() {
+  std::mt19937 generator(42);
+  std::string document = generateModelDocument(generator, 20, 5000, 3, 200);
+  reportBytes("document size", document.size());
+
+  Deserializer deserializer;
+  ChatbotModel model;
+  report("JSON load", measure([&document, &deserializer, &model]() {
+           std::istringstream is(document);
+           model = deserializer.deserialize<ChatbotModel>(is);
+         }, 1));
+
+  const std::string snapshotPath = "model-snapshot-benchmark.snapshot";
+  {
+    std::ofstream snapshotFile(snapshotPath, std::ios::binary);
+    report("snapshot write", measure([&model, &snapshotFile]() {
+             ModelSnapshot::write(model, snapshotFile);
+           }, 1));
+    reportBytes("snapshot size", static_cast<size_t>(snapshotFile.tellp()));
+  }
+
+  // The heap of a model is private to each process while the mapping of an
+  // attached snapshot is shared by all the processes attaching it.
+  model = ChatbotModel();
+  const size_t baseBytes = allocationStats().liveBytes;
+  report("snapshot load", measure([&snapshotPath, &model]() {
+           model = ModelSnapshot::load(snapshotPath);
+         }, 1));
+  reportCount("terms", model.intentStoryServiceModel.intentServiceModel
+                           .dictionaryModel->dictionary.size());
+  reportBytes("loaded model heap", allocationStats().liveBytes - baseBytes);
+
+  model = ChatbotModel();
+  report("snapshot attach", measure([&snapshotPath, &model]() {
+           model = ModelSnapshot::attachFile(snapshotPath);
+         }, 1));
+  reportBytes("attached model heap", allocationStats().liveBytes - baseBytes);
+
+  // Verifying the checksum reads every page of the snapshot.
+  model = ChatbotModel();
+  report("snapshot attach with checksum", measure([&snapshotPath, &model]() {
+           model = ModelSnapshot::attachFile(snapshotPath,
+                                             ModelSnapshot::CHECKSUM);
+         }, 1));
+
+  std::remove(snapshotPath.c_str());
+  return 0;
+}
@@ -0,0 +1,201 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "Benchmark.hpp"
+
+#include "intent/chatbot/MultiSessionChatbot.hpp"
+#include "intent/chatbot/SessionScheduler.hpp"
+#include "intent/interpreter/Interpreter.hpp"
+#include "intent/utils/Deserializer.hpp"
+#include "intent/utils/Logger.hpp"
+
+#include <atomic>
+#include <thread>
+
+using namespace intent;
+using namespace intent::benchmark;
+
+namespace {
+const size_t SESSION_COUNT = 1000000;
+const size_t STATE_COUNT = 8;
+const size_t MESSAGES_PER_SESSION = 4;
+
+typedef MultiSessionChatbot<uint64_t> SessionChatbot;
+
+class NoAction : public SessionChatbot::UserDefinedActionHandler {
+ public:
+  void operator()(const uint64_t&, const std::string&,
+                  const Chatbot::VariablesMap&, Chatbot::VariablesMap&) {}
+};
+
+/**
+ * \brief Generate a story going around a ring of states. Every state expects
+ * a sentence with a term of its own entity.
+ */
+ChatbotModel generateModel(std::mt19937& generator,
+                           std::vector<std::string>& messages) {
+  nlohmann::json dictionary;
+  dictionary["version"] = 1;
+  std::stringstream script;
+  script << "{\n@root\n";
+  for (size_t s = 0; s < STATE_COUNT; ++s) {
+    std::string term = randomWord(generator, 4, 10);
+    dictionary["entities"]["@entity" + std::to_string(s)][term] = {
+        randomWord(generator, 4, 10)};
+    messages.push_back("je voudrais " + term + " merci");
+
+    script << "    -je voudrais " << term << "\n"
+           << "        #action" << s << "\n"
+           << "    -ok\n";
+    script << (s + 1 < STATE_COUNT ? "@state" + std::to_string(s) : "@root")
+           << "\n";
+  }
+  script << "}\n";
+
+  DictionaryModel::SharedPtr dictionaryModel =
+      Deserializer().deserialize<DictionaryModel::SharedPtr>(dictionary);
+  InterpreterFeedback feedback;
+  return Interpreter::build(script.str(), dictionaryModel, feedback);
+}
+
+/**
+ * \brief Every thread sends messages to its own sessions, so that the messages
+ * of a session stay in order.
+ */
+double treatMessages(SessionChatbot& chatbot,
+                     const std::vector<std::string>& messages,
+                     size_t threadCount, size_t& replyCount) {
+  std::vector<size_t> replies(threadCount, 0);
+  double nanoseconds = measure([&]() {
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threadCount; ++t) {
+      threads.push_back(std::thread([&, t]() {
+        for (size_t m = 0; m < MESSAGES_PER_SESSION; ++m) {
+          for (uint64_t session = t; session < SESSION_COUNT;
+               session += threadCount) {
+            replies[t] +=
+                chatbot.treatMessage(session, messages[m % messages.size()])
+                    .size();
+          }
+        }
+      }));
+    }
+    for (std::thread& thread : threads) thread.join();
+  }, 1);
+
+  for (size_t r : replies) replyCount += r;
+  return nanoseconds / (SESSION_COUNT * MESSAGES_PER_SESSION);
+}
+
+/**
+ * \brief One thread submits the messages of all the sessions to a scheduler
+ * which keeps the messages of a session in order. The sessions go on around
+ * the ring from the state treatMessages left them in.
+ */
+double scheduleMessages(SessionChatbot::SharedPtr chatbot,
+                        const std::vector<std::string>& messages,
+                        size_t workerCount, size_t& replyCount,
+                        size_t& queuedMessages) {
+  std::atomic<size_t> replies(0);
+  SessionScheduler<uint64_t>::ReplyCallback countReplies =
+      [&replies](const SessionScheduler<uint64_t>::Replies& r,
+                 std::exception_ptr) {
+        replies.fetch_add(r.size(), std::memory_order_relaxed);
+      };
+
+  SessionScheduler<uint64_t> scheduler(chatbot, workerCount);
+  double nanoseconds = measure([&]() {
+    for (size_t m = 0; m < MESSAGES_PER_SESSION; ++m) {
+      for (uint64_t session = 0; session < SESSION_COUNT; ++session)
+        scheduler.submit(session,
+                         messages[(MESSAGES_PER_SESSION + m) % messages.size()],
+                         countReplies);
+    }
+    queuedMessages = scheduler.queueDepth();
+    scheduler.flush();
+  }, 1);
+
+  replyCount += replies.load();
+  return nanoseconds / (SESSION_COUNT * MESSAGES_PER_SESSION);
+}
+}
+
+int main() {
+  log::Logger::initialize(log::Logger::SeverityLevel::FATAL);
+
+  std::mt19937 generator(42);
+  std::vector<std::string> messages;
+  ChatbotModel model = generateModel(generator, messages);
+
+  std::vector<size_t> threadCounts;
+  size_t hardwareThreads = std::max(1u, std::thread::hardware_concurrency());
+  for (size_t threads = 1; threads < hardwareThreads; threads *= 2)
+    threadCounts.push_back(threads);
+  threadCounts.push_back(hardwareThreads);
+
+  size_t replyCount = 0;
+  for (size_t threads : threadCounts) {
+    SessionChatbot::SharedPtr chatbot =
+        std::make_shared<SessionChatbot>(model, std::make_shared<NoAction>());
+
+    AllocationStats before = allocationStats();
+    report("add a session", measure([&]() {
+             for (uint64_t session = 0; session < SESSION_COUNT; ++session)
+               chatbot->addSession(session);
+           }, 1) / SESSION_COUNT);
+    AllocationStats after = allocationStats();
+    reportBytes("heap per session",
+                (after.liveBytes - before.liveBytes) / SESSION_COUNT);
+
+    // Every message goes to the next state, the sessions of the first rounds
+    // are in the root state.
+    report("treat a message with " + std::to_string(threads) + " threads",
+           treatMessages(*chatbot, messages, threads, replyCount));
+
+    size_t queuedMessages = 0;
+    report("schedule a message on " + std::to_string(threads) + " workers",
+           scheduleMessages(chatbot, messages, threads, replyCount,
+                            queuedMessages));
+    reportCount("messages queued once all submitted", queuedMessages);
+  }
+
+  std::printf("checksum %zu\n", replyCount);
+  return 0;
+}
@@ -0,0 +1,107 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "Benchmark.hpp"
+
+#include "intent/chatbot/Chatbot.hpp"
+#include "intent/chatbot/SessionStore.hpp"
+
+#include <map>
+
+using namespace intent;
+using namespace intent::benchmark;
+
+namespace {
+const size_t SESSION_COUNT = 10000000;
+
+typedef SessionStore<uint64_t, Chatbot::Context> Store;
+
+void benchmarkStore(const std::string& name, const Store::Options& options) {
+  AllocationStats before = allocationStats();
+  Store store(options);
+  report(name + ": insert a session", measure([&]() {
+           Chatbot::Context context;
+           for (uint64_t session = 0; session < SESSION_COUNT; ++session) {
+             context.currentState = static_cast<uint32_t>(session % 100);
+             store.insert(session, context);
+           }
+         }, 1) / SESSION_COUNT);
+  AllocationStats after = allocationStats();
+  reportCount(name + ": sessions", store.size());
+  reportBytes(name + ": heap per session",
+              (after.liveBytes - before.liveBytes) / store.size());
+
+  size_t found = 0;
+  report(name + ": find a session", measure([&]() {
+           Chatbot::Context context;
+           for (uint64_t session = 0; session < SESSION_COUNT; ++session)
+             found += store.find(session, context);
+         }, 1) / SESSION_COUNT);
+  std::printf("checksum %zu\n", found);
+}
+}
+
+int main() {
+  reportBytes("record size", Store::recordSize());
+
+  // The node-based map the sessions used to be kept in.
+  {
+    AllocationStats before = allocationStats();
+    std::map<uint64_t, Chatbot::Context> sessions;
+    Chatbot::Context context;
+    report("std::map: insert a session", measure([&]() {
+             for (uint64_t session = 0; session < SESSION_COUNT; ++session)
+               sessions.insert(std::make_pair(session, context));
+           }, 1) / SESSION_COUNT);
+    AllocationStats after = allocationStats();
+    reportBytes("std::map: heap per session",
+                (after.liveBytes - before.liveBytes) / SESSION_COUNT);
+  }
+
+  Store::Options options;
+  options.idleTimeout = std::chrono::seconds(3600);
+  benchmarkStore("store", options);
+
+  // The cap holds the records of half of the sessions, the least recently
+  // used sessions are evicted.
+  options.maxBytes = SESSION_COUNT / 2 * Store::recordSize();
+  benchmarkStore("store capped", options);
+  return 0;
+}
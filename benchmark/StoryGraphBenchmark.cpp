@@ -0,0 +1,102 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "Benchmark.hpp"
+
+#include "intent/intent_story_service/IntentStoryModel.hpp"
+
+using namespace intent;
+using namespace intent::benchmark;
+
+namespace {
+const size_t STATE_COUNT = 200000;
+const size_t EDGES_PER_STATE = 4;
+const size_t ITERATIONS = 2000000;
+
+typedef IntentStoryModel::StoryGraph StoryGraph;
+
+void buildGraph(std::mt19937& generator, StoryGraph& graph) {
+  std::uniform_int_distribution<size_t> stateDistribution(0, STATE_COUNT - 1);
+
+  for (size_t i = 0; i < STATE_COUNT; ++i) {
+    IntentStoryModel::VertexInfo vertexInfo;
+    vertexInfo.stateId = "@state" + std::to_string(i);
+    graph.addVertex(vertexInfo);
+  }
+
+  // The edges are added in the order of a script, not grouped by source.
+  for (size_t i = 0; i < STATE_COUNT * EDGES_PER_STATE; ++i) {
+    IntentStoryModel::EdgeInfo edgeInfo;
+    edgeInfo.intent.intentId = "intent" + std::to_string(i % 100);
+    edgeInfo.actionId = "action" + std::to_string(i % 50);
+    graph.addEdge(graph.vertexAt(i % STATE_COUNT),
+                  graph.vertexAt(stateDistribution(generator)), edgeInfo);
+  }
+}
+}
+
+int main() {
+  std::mt19937 generator(42);
+
+  StoryGraph graph;
+  buildGraph(generator, graph);
+  report("freeze " + std::to_string(graph.edgeCount()) + " edges",
+         measure([&]() { graph.freeze(); }, 1));
+
+  // Walk the graph the way evaluate does: look at the edges going out of the
+  // current state and follow one of them.
+  StoryGraph::Vertex vertex = graph.vertexAt(0);
+  size_t step = 0;
+  size_t checksum = 0;
+
+  AllocationStats before = allocationStats();
+  report("walk one edge", measure([&]() {
+           StoryGraph::Edges edges = graph.nextEdges(vertex);
+           for (const StoryGraph::Edge& edge : edges)
+             checksum += edge.getInfo().actionId.size();
+           vertex = edges[step++ % edges.size()].getTarget();
+         }, ITERATIONS));
+  AllocationStats after = allocationStats();
+  reportCount("walk allocations per edge",
+              double(after.allocations - before.allocations) / ITERATIONS);
+
+  std::printf("checksum %zu\n", checksum);
+  return 0;
+}
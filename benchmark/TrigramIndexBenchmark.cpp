@@ -0,0 +1,180 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "Benchmark.hpp"
+
+#include "intent/intent_service/TermIndex.hpp"
+#include "intent/utils/TrigramHelper.hpp"
+
+#include <memory>
+#include <set>
+#include <unordered_map>
+
+using namespace intent;
+using namespace intent::benchmark;
+
+namespace {
+const size_t TERM_COUNT = 20000;
+const size_t ALIAS_COUNT = 2;
+const size_t QUERY_COUNT = 2000;
+
+/**
+ * \brief The map of sets trigram index TermIndex used to rely on, kept here as
+ * a baseline.
+ */
+typedef std::unordered_map<std::string, std::set<int>> MapOfSetsIndex;
+
+void pushWord(MapOfSetsIndex& index, const std::string& word, int termId) {
+  std::vector<std::string> trigrams;
+  TrigramHelper::generateTrigrams(word, trigrams);
+  for (const std::string& trigram : trigrams) index[trigram].insert(termId);
+}
+
+size_t scoreWithMapOfSets(const MapOfSetsIndex& index,
+                          const std::vector<std::string>& trigrams) {
+  std::unordered_map<int, int> scores;
+  for (const std::string& trigram : trigrams) {
+    MapOfSetsIndex::const_iterator it = index.find(trigram);
+    if (it != index.end()) {
+      std::set<int> termIds = it->second;
+      for (int termId : termIds) ++scores[termId];
+    }
+  }
+  return scores.size();
+}
+
+size_t scoreWithTrigramIndex(const TrigramIndex& index,
+                             const std::vector<int>& termIdBySlot,
+                             const std::vector<std::string>& trigrams) {
+  std::unordered_map<int, int> scores;
+  for (const std::string& trigram : trigrams) {
+    TrigramIndex::TrigramCode code;
+    if (!TrigramIndex::encode(trigram, code)) continue;
+    index.visitPostings(code, [&scores, &termIdBySlot](TrigramIndex::Slot s) {
+      ++scores[termIdBySlot[s]];
+    });
+  }
+  return scores.size();
+}
+
+std::vector<Term> generateTerms(std::mt19937& generator) {
+  std::vector<Term> terms;
+  for (size_t i = 0; i < TERM_COUNT; ++i) {
+    Term term;
+    term.term = randomWord(generator, 4, 12);
+    term.termId = i;
+    term.entityId = i % 50;
+    for (size_t k = 0; k < ALIAS_COUNT; ++k)
+      term.alias.push_back(randomWord(generator, 4, 12));
+    terms.push_back(term);
+  }
+  return terms;
+}
+}
+
+int main() {
+  std::mt19937 generator(42);
+  std::vector<Term> terms = generateTerms(generator);
+
+  std::vector<std::vector<std::string>> queries;
+  std::vector<std::string> queryWords;
+  for (size_t i = 0; i < QUERY_COUNT; ++i) {
+    const Term& term = terms[generator() % terms.size()];
+    queryWords.push_back(misspell(generator, term.term));
+    queries.push_back(std::vector<std::string>());
+    TrigramHelper::generateTrigrams(queryWords.back(), queries.back());
+  }
+
+  // Baseline
+  size_t before = allocationStats().liveBytes;
+  std::unique_ptr<MapOfSetsIndex> mapOfSets(new MapOfSetsIndex());
+  for (const Term& term : terms) {
+    pushWord(*mapOfSets, term.term, term.termId);
+    for (const std::string& alias : term.alias)
+      pushWord(*mapOfSets, alias, term.termId);
+  }
+  reportBytes("map of sets: memory", allocationStats().liveBytes - before);
+
+  // Packed index, built the same way TermIndex does.
+  before = allocationStats().liveBytes;
+  std::vector<int> termIdBySlot;
+  std::unique_ptr<TrigramIndex> packed(new TrigramIndex());
+  {
+    TrigramIndex::Postings postings;
+    for (const Term& term : terms) {
+      termIdBySlot.push_back(term.termId);
+      std::vector<std::string> trigrams;
+      TrigramHelper::generateTrigrams(term.term, trigrams);
+      for (const std::string& alias : term.alias)
+        TrigramHelper::generateTrigrams(alias, trigrams);
+      for (const std::string& trigram : trigrams) {
+        TrigramIndex::TrigramCode code;
+        TrigramIndex::encode(trigram, code);
+        postings.push_back(TrigramIndex::Posting(code, term.termId));
+      }
+    }
+    packed->build(postings);
+  }
+  reportBytes("packed trigram index: memory",
+              allocationStats().liveBytes - before);
+
+  size_t query = 0;
+  size_t checksum = 0;
+  report("map of sets: score one token", measure([&]() {
+           checksum += scoreWithMapOfSets(*mapOfSets,
+                                          queries[query++ % queries.size()]);
+         }, 20 * QUERY_COUNT));
+  report("packed trigram index: score one token", measure([&]() {
+           checksum += scoreWithTrigramIndex(*packed, termIdBySlot,
+                                             queries[query++ % queries.size()]);
+         }, 20 * QUERY_COUNT));
+
+  TermIndex termIndex;
+  for (const Term& term : terms) termIndex.pushTerm(term);
+  termIndex.compact();
+  report("TermIndex::findTerm", measure([&]() {
+           checksum +=
+               termIndex.findTerm(queryWords[query++ % queryWords.size()])
+                   .termId;
+         }, 5 * QUERY_COUNT));
+
+  std::printf("checksum %zu\n", checksum);
+  return 0;
+}
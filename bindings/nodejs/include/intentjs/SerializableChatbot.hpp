@@ -54,8 +54,9 @@ class SerializableUserDefinedActionsHandler
  public:
   SerializableUserDefinedActionsHandler(Isolate *isolate, Local<Function> cb,
                                         Local<Object> &v8context,
+                                        const iChatbot &chatbot,
                                         intent::Chatbot::Context &context)
-      : m_context(context), m_v8context(v8context) {
+      : m_chatbot(chatbot), m_context(context), m_v8context(v8context) {
     m_isolate = isolate;
     m_callback = cb;
   }
@@ -64,9 +65,9 @@ class SerializableUserDefinedActionsHandler
                   const intent::Chatbot::VariablesMap &intentVariables,
                   intent::Chatbot::VariablesMap &userDefinedVariables) {
     // set the new state in context for it to be saved correctly
-    m_v8context->Set(
-        String::NewFromUtf8(m_isolate, "_state"),
-        String::NewFromUtf8(m_isolate, m_context.currentStateId.c_str()));
+    const std::string &stateId = m_chatbot.getStateId(m_context.currentState);
+    m_v8context->Set(String::NewFromUtf8(m_isolate, "_state"),
+                     String::NewFromUtf8(m_isolate, stateId.c_str()));
 
     const unsigned argc = 3;
     Local<Object> intentVariablesObject = Object::New(m_isolate);
@@ -114,6 +115,7 @@ class SerializableUserDefinedActionsHandler
  private:
   Local<Function> m_callback;
   Isolate *m_isolate;
+  const iChatbot &m_chatbot;
   intent::Chatbot::Context &m_context;
   Local<Object> &m_v8context;
 };
@@ -128,6 +130,11 @@ class SerializableChatbot : public node::ObjectWrap {
   static void InstantiateFromOIML(
       const v8::FunctionCallbackInfo<v8::Value> &args);
 
+  static void InstantiateFromSharedMemory(
+      const v8::FunctionCallbackInfo<v8::Value> &args);
+
+  static void ShareOIMLModel(const v8::FunctionCallbackInfo<v8::Value> &args);
+
  private:
   explicit SerializableChatbot(iChatbot::SharedPtr chatbot);
 
@@ -140,6 +147,7 @@ class SerializableChatbot : public node::ObjectWrap {
 
   static v8::Persistent<v8::Function> constructorFromJsonModel;
   static v8::Persistent<v8::Function> constructorFromOIML;
+  static v8::Persistent<v8::Function> constructorFromSharedMemory;
 
  public:
   iChatbot::SharedPtr m_chatbot;
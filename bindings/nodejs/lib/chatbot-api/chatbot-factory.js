@@ -51,5 +51,16 @@ function createFromJsonModel(jsonModel, sessionManagerDriver, userCommandsDriver
         userCommandsDriver);
 }
 
+function shareOIML(dictionaryModel, openIntentMLModel, segmentName) {
+    OpenIntent.shareOIMLModel(JSON.stringify(dictionaryModel), openIntentMLModel, segmentName);
+}
+
+function createFromSharedMemory(segmentName, sessionManagerDriver, userCommandsDriver) {
+    return new ChatbotInterface(OpenIntent.createSerializableChatbotFromSharedMemory(segmentName),
+        sessionManagerDriver, userCommandsDriver);
+}
+
 module.exports.fromOIML = createFromOIML;
 module.exports.fromJsonModel = createFromJsonModel;
+module.exports.shareOIML = shareOIML;
+module.exports.fromSharedMemory = createFromSharedMemory;
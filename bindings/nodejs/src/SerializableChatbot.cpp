@@ -44,6 +44,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "intent/chatbot/ChatbotFactory.hpp"
 #include "intent/intent_story_service/IntentStoryModelSerializer.hpp"
 #include "intent/utils/Logger.hpp"
+#include "intent/utils/ModelSnapshot.hpp"
 
 using v8::Function;
 using v8::FunctionCallbackInfo;
@@ -65,23 +66,27 @@ void parseV8String(Isolate *isolate, const Local<String> &currentStateStr,
   currentState = content.c_str();
 }
 
-void parseContext(Isolate *isolate, const Local<Object> &sessionContext,
-                  intent::Chatbot::Context &context) {
+bool parseContext(Isolate *isolate, const Local<Object> &sessionContext,
+                  const iChatbot &chatbot, intent::Chatbot::Context &context) {
   Local<Value> currentStateKey = v8::String::NewFromUtf8(isolate, "_state");
   if (sessionContext->Has(currentStateKey)) {
     Local<Value> currentStateValue = sessionContext->Get(currentStateKey);
 
     if (currentStateValue->IsString()) {
-      parseV8String(isolate, currentStateValue->ToString(),
-                    context.currentStateId);
+      // The state ID is only resolved here, the chatbot works on handles.
+      std::string currentStateId;
+      parseV8String(isolate, currentStateValue->ToString(), currentStateId);
+      context.currentState = chatbot.findState(currentStateId);
     } else {
       std::string error = "Current state must be a string.";
       INTENT_LOG_ERROR() << error << "\n";
 
       isolate->ThrowException(v8::Exception::TypeError(
           String::NewFromUtf8(isolate, error.c_str())));
+      return false;
     }
   }
+  return true;
 }
 }
 
@@ -90,6 +95,7 @@ SerializableChatbot::SerializableChatbot(iChatbot::SharedPtr chatbot)
 
 Persistent<Function> SerializableChatbot::constructorFromJsonModel;
 Persistent<Function> SerializableChatbot::constructorFromOIML;
+Persistent<Function> SerializableChatbot::constructorFromSharedMemory;
 
 void SerializableChatbot::Init(Isolate *isolate) {
   Local<FunctionTemplate> fromJsonModelTemplate =
@@ -123,6 +129,24 @@ void SerializableChatbot::Init(Isolate *isolate) {
   NODE_SET_PROTOTYPE_METHOD(fromOIMLTemplate, "prepareReplies", PrepareReplies);
 
   constructorFromOIML.Reset(isolate, fromOIMLTemplate->GetFunction());
+
+  Local<FunctionTemplate> fromSharedMemoryTemplate =
+      FunctionTemplate::New(isolate, InstantiateFromSharedMemory);
+  fromSharedMemoryTemplate->SetClassName(
+      String::NewFromUtf8(isolate, "SerializableChatbot"));
+  fromSharedMemoryTemplate->InstanceTemplate()->SetInternalFieldCount(4);
+
+  // Prototype
+  NODE_SET_PROTOTYPE_METHOD(fromSharedMemoryTemplate, "treatMessage",
+                            TreatMessage);
+  NODE_SET_PROTOTYPE_METHOD(fromSharedMemoryTemplate, "getInitialState",
+                            GetInitialState);
+  NODE_SET_PROTOTYPE_METHOD(fromSharedMemoryTemplate, "getGraph", GetGraph);
+  NODE_SET_PROTOTYPE_METHOD(fromSharedMemoryTemplate, "prepareReplies",
+                            PrepareReplies);
+
+  constructorFromSharedMemory.Reset(isolate,
+                                    fromSharedMemoryTemplate->GetFunction());
 }
 
 /**
@@ -165,9 +189,10 @@ void SerializableChatbot::TreatMessage(
   Local<Function> userDefinedActionsCallback = Local<Function>::Cast(args[2]);
 
   intent::Chatbot::Context context;
-  parseContext(isolate, sessionContext, context);
+  if (!parseContext(isolate, sessionContext, *obj->m_chatbot, context)) return;
   SerializableUserDefinedActionsHandler userDefinedActionHandler(
-      isolate, userDefinedActionsCallback, sessionContext, context);
+      isolate, userDefinedActionsCallback, sessionContext, *obj->m_chatbot,
+      context);
 
   std::string message = std::string(*messageValue);
 
@@ -316,6 +341,7 @@ void SerializableChatbot::InstantiateFromJsonModel(
       INTENT_LOG_ERROR() << error << "\n";
       isolate->ThrowException(v8::Exception::TypeError(
           String::NewFromUtf8(isolate, error.c_str())));
+      return;
     }
 
     SerializableChatbot *obj = new SerializableChatbot(chatbot);
@@ -394,11 +420,13 @@ void SerializableChatbot::InstantiateFromOIML(
       std::string error = "Error while interpreting the model.";
       INTENT_LOG_ERROR() << error << "\n";
       isolate->ThrowException(interpreterFeedback);
+      return;
     } else if (!chatbot.get()) {
       std::string error = "Error while creating chatbot.";
       INTENT_LOG_ERROR() << error << "\n";
       isolate->ThrowException(v8::Exception::TypeError(
           String::NewFromUtf8(isolate, error.c_str())));
+      return;
     }
 
     SerializableChatbot *obj = new SerializableChatbot(chatbot);
@@ -417,4 +445,98 @@ void SerializableChatbot::InstantiateFromOIML(
       args.GetReturnValue().Set(instance.ToLocalChecked());
   }
 }
+
+void SerializableChatbot::InstantiateFromSharedMemory(
+    const v8::FunctionCallbackInfo<v8::Value> &args) {
+  Isolate *isolate = args.GetIsolate();
+
+  if (!args[0]->IsString()) {
+    isolate->ThrowException(v8::Exception::TypeError(
+        String::NewFromUtf8(isolate, "segment name must be a string")));
+    return;
+  }
+  Local<Value> segmentNameValue(args[0]->ToString());
+
+  if (args.IsConstructCall()) {
+    v8::String::Utf8Value v0(segmentNameValue);
+    std::string segmentName = std::string(*v0);
+
+    iChatbot::SharedPtr chatbot =
+        intent::ChatbotFactory::createChatbotFromSharedMemory(segmentName);
+
+    if (!chatbot.get()) {
+      std::string error = "Error while attaching chatbot to " + segmentName;
+      INTENT_LOG_ERROR() << error << "\n";
+      isolate->ThrowException(v8::Exception::TypeError(
+          String::NewFromUtf8(isolate, error.c_str())));
+      return;
+    }
+
+    SerializableChatbot *obj = new SerializableChatbot(chatbot);
+    obj->Wrap(args.This());
+    args.GetReturnValue().Set(args.This());
+  } else {
+    int argc = 1;
+    Local<Value> argv[argc] = {segmentNameValue};
+
+    Local<Context> context = isolate->GetCurrentContext();
+    Local<Function> cons =
+        Local<Function>::New(isolate, constructorFromSharedMemory);
+
+    MaybeLocal<Object> instance = cons->NewInstance(context, argc, argv);
+
+    if (!instance.IsEmpty())
+      args.GetReturnValue().Set(instance.ToLocalChecked());
+  }
+}
+
+/**
+ * @brief SerializableChatbot::ShareOIMLModel
+ * @param args : dictionary, script, segmentName
+ */
+void SerializableChatbot::ShareOIMLModel(
+    const v8::FunctionCallbackInfo<v8::Value> &args) {
+  Isolate *isolate = args.GetIsolate();
+
+  if (!args[0]->IsString() || !args[1]->IsString() || !args[2]->IsString()) {
+    isolate->ThrowException(v8::Exception::TypeError(String::NewFromUtf8(
+        isolate, "dictionary, script and segment name must be strings")));
+    return;
+  }
+  v8::String::Utf8Value v0(args[0]->ToString());
+  v8::String::Utf8Value v1(args[1]->ToString());
+  v8::String::Utf8Value v2(args[2]->ToString());
+
+  std::stringstream dictionaryStream, interpreterModelStream;
+  dictionaryStream << std::string(*v0);
+  interpreterModelStream << std::string(*v1);
+  std::string segmentName = std::string(*v2);
+
+  intent::InterpreterFeedback feedback;
+  iChatbot::SharedPtr chatbot = intent::ChatbotFactory::createChatbotFromOIML(
+      dictionaryStream, interpreterModelStream, feedback);
+
+  if (!feedback.empty()) {
+    Local<Object> interpreterFeedback = Object::New(isolate);
+    wrapInterpreterFeedback(isolate, interpreterFeedback, feedback);
+    INTENT_LOG_ERROR() << "Error while interpreting the model.\n";
+    isolate->ThrowException(interpreterFeedback);
+    return;
+  } else if (!chatbot.get()) {
+    std::string error = "Error while creating chatbot.";
+    INTENT_LOG_ERROR() << error << "\n";
+    isolate->ThrowException(v8::Exception::TypeError(
+        String::NewFromUtf8(isolate, error.c_str())));
+    return;
+  }
+
+  try {
+    intent::ModelSnapshot::createSharedMemory(chatbot->getChatbotModel(),
+                                              segmentName);
+  } catch (const intent::ModelSnapshotException &e) {
+    INTENT_LOG_ERROR() << e.message() << "\n";
+    isolate->ThrowException(v8::Exception::Error(
+        String::NewFromUtf8(isolate, e.message().c_str())));
+  }
+}
 }
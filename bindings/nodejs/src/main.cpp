@@ -63,12 +63,24 @@ void CreateSerializableChatbotFromOIML(
   intentjs::SerializableChatbot::InstantiateFromOIML(args);
 }
 
+void CreateSerializableChatbotFromSharedMemory(
+    const FunctionCallbackInfo<Value>& args) {
+  intentjs::SerializableChatbot::InstantiateFromSharedMemory(args);
+}
+
+void ShareOIMLModel(const FunctionCallbackInfo<Value>& args) {
+  intentjs::SerializableChatbot::ShareOIMLModel(args);
+}
+
 void InitAll(Local<Object> exports) {
   intentjs::SerializableChatbot::Init(exports->GetIsolate());
   NODE_SET_METHOD(exports, "createSerializableChatbotFromJsonModel",
                   CreateSerializableChatbotFromJsonModel);
   NODE_SET_METHOD(exports, "createSerializableChatbotFromOIML",
                   CreateSerializableChatbotFromOIML);
+  NODE_SET_METHOD(exports, "createSerializableChatbotFromSharedMemory",
+                  CreateSerializableChatbotFromSharedMemory);
+  NODE_SET_METHOD(exports, "shareOIMLModel", ShareOIMLModel);
 }
 
 NODE_MODULE(addon, InitAll)
@@ -58,5 +58,36 @@ var file = path.resolve(__dirname, 'res/interpreter_model.txt');
 var interpreterModel = fs.readFileSync(file, "utf-8");
 
 describe("Test Open Intent chatbot factory", function() {
+    describe("When the model is shared in memory", function() {
+        it('should attach a chatbot to the shared model and interact with it', function(done) {
+            var SEGMENT_NAME = 'open-intent-factory-test';
+            var sessionManager = new StandaloneSessionManager();
+            var userDefinedActionDriver = new SimpleUserCommandsDriver(userCommands);
 
+            OpenIntentChatbot.shareOIML(model, interpreterModel, SEGMENT_NAME);
+            var chatbot = OpenIntentChatbot.fromSharedMemory(SEGMENT_NAME, sessionManager,
+                userDefinedActionDriver);
+
+            chatbot.talk('abc', 'Bob')
+                .then(function(replies) {
+                    expect(replies).to.deep.equal(['Que puis-je vous offrir ?']);
+                    done();
+                })
+                .fail(done);
+        });
+
+        it('should throw when the segment does not exist', function() {
+            var sessionManager = new StandaloneSessionManager();
+            var userDefinedActionDriver = new SimpleUserCommandsDriver(userCommands);
+            var chatbot = undefined;
+
+            var fn = function() {
+                chatbot = OpenIntentChatbot.fromSharedMemory('open-intent-unexisting-segment',
+                    sessionManager, userDefinedActionDriver);
+            };
+
+            expect(fn).to.throw(TypeError, 'Error while attaching chatbot to open-intent-unexisting-segment');
+            expect(chatbot).to.be.undefined;
+        });
+    });
 });
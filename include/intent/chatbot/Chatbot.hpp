@@ -42,6 +42,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define INTENT_CHATBOT_HPP
 
 #include <string>
+#include <boost/utility/string_ref.hpp>
+
 #include "ChatbotModel.hpp"
 
 namespace intent {
@@ -63,10 +65,12 @@ class Chatbot {
 
   typedef std::shared_ptr<Chatbot> SharedPtr;
 
+  typedef IntentStoryModel::StateHandle StateHandle;
+
   /**
    *
-   * \brief The Context of the automaton. It contains the current state ID and
-   * the user defined variables.
+   * \brief The Context of the automaton. It contains the current state handle
+   * and the user defined variables.
    *
    * Context represents the state of the finite state automaton and the
    * variables going through every
@@ -75,10 +79,13 @@ class Chatbot {
    * to replace variable placeholders in a template reply.
    */
   struct Context {
+    Context() : currentState(IntentStoryModel::NO_STATE) {}
+
     /**
-      * The state of the finite state automaton.
+      * The state of the finite state automaton. State IDs are resolved with
+      * findState and getStateId.
       */
-    std::string currentStateId;
+    StateHandle currentState;
   };
 
   /**
@@ -133,7 +140,7 @@ class Chatbot {
    * execute the transition of the
    * finite state automaton to the next state.
    */
-  bool treatMessage(const std::string& message, Context& context,
+  bool treatMessage(boost::string_ref message, Context& context,
                     UserDefinedActionHandler& userDefinedActionHandler,
                     VariablesMap& intentVariables,
                     VariablesMap& userDefinedVariables);
@@ -158,6 +165,25 @@ class Chatbot {
    */
   std::string getInitialState() const;
 
+  /**
+   * \brief Returns a context in the initial state of the model
+   */
+  Context getInitialContext() const;
+
+  /**
+   * \brief Returns the handle of a state, or NO_STATE if it does not exist.
+   */
+  StateHandle findState(const std::string& stateId) const {
+    return m_intentStoryService.findState(stateId);
+  }
+
+  /**
+   * \brief Returns the ID of a state, or an empty string for NO_STATE.
+   */
+  const std::string& getStateId(StateHandle state) const {
+    return m_intentStoryService.getStateId(state);
+  }
+
   inline ChatbotModel getChatbotModel() const {
     ChatbotModel chatbotModel;
     chatbotModel.chatbotActionModel = m_chatbotActionModel;
@@ -44,6 +44,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "MultiSessionChatbot.hpp"
 #include "SingleSessionChatbot.hpp"
 #include "intent/interpreter/Interpreter.hpp"
+#include "intent/interpreter/InterpreterCache.hpp"
 
 namespace intent {
 /**
@@ -74,6 +75,46 @@ class ChatbotFactory {
       std::istream& dictionaryModel, std::istream& interpreterModel,
       InterpreterFeedback& feedback);
 
+  /**
+   * \param dictionaryModel             The data model to be loaded in the
+   * chatbot.
+   * \param interpreterModel            The data model describing the dialogs
+   * enabled by the chatbot.
+   * \param feedback                    The feedback of the interpreter
+   * \param cache                       The scenarios compiled by the previous
+   * creation of the chatbot, only the edited ones are compiled again.
+   * \return A Chatbot.
+   *
+   * \brief Create a chatbot from an OpenIntent markup language, a dictionary
+   * model
+   */
+  static Chatbot::SharedPtr createChatbotFromOIML(
+      std::istream& dictionaryModel, std::istream& interpreterModel,
+      InterpreterFeedback& feedback, InterpreterCache& cache);
+
+  /**
+   * \param snapshotFilename  The snapshot file written by ModelSnapshot.
+   * \return A Chatbot.
+   *
+   * \brief Create a chatbot from a binary model snapshot mapped in memory.
+   * The dictionary is read in place, the processes mapping the same file
+   * share it.
+   */
+  static Chatbot::SharedPtr createChatbotFromSnapshot(
+      const std::string& snapshotFilename);
+
+  /**
+   * \param segmentName       The shared memory segment written by
+   * ModelSnapshot::createSharedMemory.
+   * \return A Chatbot.
+   *
+   * \brief Create a chatbot from a binary model snapshot in shared memory.
+   * The dictionary is read in place, the processes attached to the same
+   * segment share it.
+   */
+  static Chatbot::SharedPtr createChatbotFromSharedMemory(
+      const std::string& segmentName);
+
   /**
    * \param model             The data model to be loaded in the chatbot.
    * \param userDefinedActionHandler  The user implementation of the
@@ -108,6 +149,34 @@ class ChatbotFactory {
       std::istream& dictionaryModel, std::istream& interpreterModel,
       Chatbot::UserDefinedActionHandler::SharedPtr userDefinedActionHandler);
 
+  /**
+   * \param snapshotFilename  The snapshot file written by ModelSnapshot.
+   * \param userDefinedActionHandler  The user implementation of the
+   * userDefinedActionHandler that will be used by the chatbot.
+   * \return A SingleSessionChatbot.
+   *
+   * \brief Create a single session chatbot from a binary model snapshot
+   * mapped in memory.
+   */
+  static SingleSessionChatbot::SharedPtr createSingleSessionChatbotFromSnapshot(
+      const std::string& snapshotFilename,
+      Chatbot::UserDefinedActionHandler::SharedPtr userDefinedActionHandler);
+
+  /**
+   * \param segmentName       The shared memory segment written by
+   * ModelSnapshot::createSharedMemory.
+   * \param userDefinedActionHandler  The user implementation of the
+   * userDefinedActionHandler that will be used by the chatbot.
+   * \return A SingleSessionChatbot.
+   *
+   * \brief Create a single session chatbot from a binary model snapshot in
+   * shared memory.
+   */
+  static SingleSessionChatbot::SharedPtr
+  createSingleSessionChatbotFromSharedMemory(
+      const std::string& segmentName,
+      Chatbot::UserDefinedActionHandler::SharedPtr userDefinedActionHandler);
+
   /**
    * \param modelFilename             The data model file to be loaded in the
    * chatbot.
@@ -154,13 +223,51 @@ class ChatbotFactory {
       typename MultiSessionChatbot<SessionIdType>::UserDefinedActionHandler::
           SharedPtr userDefinedActionHandler);
 
+  /**
+   * \param snapshotFilename  The snapshot file written by ModelSnapshot.
+   * \param userDefinedActionHandler  The user implementation of the
+   * userDefinedActionHandler that will be used by the chatbot.
+   * \return A MultiSessionChatbot.
+   *
+   * \brief Create a multi session chatbot from a binary model snapshot
+   * mapped in memory.
+   */
+  template <typename SessionIdType>
+  static typename MultiSessionChatbot<SessionIdType>::SharedPtr
+  createMultiSessionChatbotFromSnapshot(
+      const std::string& snapshotFilename,
+      typename MultiSessionChatbot<SessionIdType>::UserDefinedActionHandler::
+          SharedPtr userDefinedActionHandler);
+
+  /**
+   * \param segmentName       The shared memory segment written by
+   * ModelSnapshot::createSharedMemory.
+   * \param userDefinedActionHandler  The user implementation of the
+   * userDefinedActionHandler that will be used by the chatbot.
+   * \return A MultiSessionChatbot.
+   *
+   * \brief Create a multi session chatbot from a binary model snapshot in
+   * shared memory.
+   */
+  template <typename SessionIdType>
+  static typename MultiSessionChatbot<SessionIdType>::SharedPtr
+  createMultiSessionChatbotFromSharedMemory(
+      const std::string& segmentName,
+      typename MultiSessionChatbot<SessionIdType>::UserDefinedActionHandler::
+          SharedPtr userDefinedActionHandler);
+
  private:
   static bool loadFromJsonModel(std::istream& model,
                                 ChatbotModel& chatbotModel);
   static bool loadFromOIML(std::istream& dictionaryModel,
                            std::istream& interpreterModel,
                            ChatbotModel& chatbotModel,
-                           InterpreterFeedback& feedback);
+                           InterpreterFeedback& feedback,
+                           InterpreterCache* cache = NULL);
+  static bool loadFromSnapshot(const std::string& snapshotFilename,
+                               ChatbotModel& chatbotModel);
+  static bool loadFromSharedMemory(const std::string& segmentName,
+                                   ChatbotModel& chatbotModel);
 };
 }
 
@@ -80,6 +80,38 @@ ChatbotFactory::createMultiSessionChatbotFromOIML(
   }
   return chatbot;
 }
+
+template <typename SessionIdType>
+typename MultiSessionChatbot<SessionIdType>::SharedPtr
+ChatbotFactory::createMultiSessionChatbotFromSnapshot(
+    const std::string& snapshotFilename,
+    typename MultiSessionChatbot<SessionIdType>::UserDefinedActionHandler::
+        SharedPtr userDefinedActionHandler) {
+  typename intent::MultiSessionChatbot<SessionIdType>::SharedPtr chatbot;
+
+  ChatbotModel chatbotModel;
+  if (ChatbotFactory::loadFromSnapshot(snapshotFilename, chatbotModel)) {
+    chatbot.reset(new intent::MultiSessionChatbot<SessionIdType>(
+        chatbotModel, userDefinedActionHandler));
+  }
+  return chatbot;
+}
+
+template <typename SessionIdType>
+typename MultiSessionChatbot<SessionIdType>::SharedPtr
+ChatbotFactory::createMultiSessionChatbotFromSharedMemory(
+    const std::string& segmentName,
+    typename MultiSessionChatbot<SessionIdType>::UserDefinedActionHandler::
+        SharedPtr userDefinedActionHandler) {
+  typename intent::MultiSessionChatbot<SessionIdType>::SharedPtr chatbot;
+
+  ChatbotModel chatbotModel;
+  if (ChatbotFactory::loadFromSharedMemory(segmentName, chatbotModel)) {
+    chatbot.reset(new intent::MultiSessionChatbot<SessionIdType>(
+        chatbotModel, userDefinedActionHandler));
+  }
+  return chatbot;
+}
 }
 
 #endif  // INTENT_CHATBOTFACTORY_INL_HPP_HPP
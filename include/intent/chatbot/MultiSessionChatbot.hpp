@@ -43,20 +43,35 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "intent/chatbot/Chatbot.hpp"
 #include "intent/chatbot/ChatbotModel.hpp"
+#include "intent/chatbot/SessionStore.hpp"
 
-#include <map>
 #include <memory>
 
 namespace intent {
 /**
  * \brief An implementation of Chatbot that uses a multiple sessions registered
  * by the user.
+ *
+ * The sessions can be added, removed and receive messages from several threads
+ * at once: the messages of different sessions are treated in parallel on the
+ * shared model. The messages of one session must still be treated one after
+ * the other. SessionIdType must be hashable by std::hash.
+ *
+ * Sessions can expire after some idle time, and be evicted from the least
+ * recently used once the memory cap of the sessions is reached.
  */
 template <typename SessionIdType>
 class MultiSessionChatbot : protected Chatbot {
  public:
   typedef std::shared_ptr<MultiSessionChatbot> SharedPtr;
 
+  typedef SessionStore<SessionIdType, Chatbot::Context> SessionIndex;
+
+  /**
+   * \brief The idle timeout, memory cap and eviction callback of the sessions.
+   */
+  typedef typename SessionIndex::Options SessionOptions;
+
   /**
    * \brief The specific UserDefinedActionHandler for multi session chatbots
    */
@@ -80,6 +95,14 @@ class MultiSessionChatbot : protected Chatbot {
       const ChatbotModel& chatbotModel,
       typename UserDefinedActionHandler::SharedPtr userDefinedActionHandler);
 
+  /**
+   * \param sessionOptions    How the sessions are stored and evicted.
+   */
+  MultiSessionChatbot(
+      const ChatbotModel& chatbotModel,
+      typename UserDefinedActionHandler::SharedPtr userDefinedActionHandler,
+      const SessionOptions& sessionOptions);
+
   /**
    * \brief Handles a user intent for a particular session and reply or perform
    * actions
@@ -108,9 +131,13 @@ class MultiSessionChatbot : protected Chatbot {
    */
   inline size_t sessionCount() const { return m_sessionIndex.size(); }
 
- private:
-  using SessionIndex = std::map<SessionIdType, Chatbot::Context>;
+  /**
+   * \brief Remove the sessions idle for longer than the idle timeout.
+   * \return The number of removed sessions.
+   */
+  inline size_t expireSessions() { return m_sessionIndex.expire(); }
 
+ private:
   /**
    * \brief The data model used by the Chatbot.
    */
@@ -153,7 +180,8 @@ class MultiSessionChatbot : protected Chatbot {
     }
 
    private:
-    const std::string m_state;
+    // The ID of the state the message was received in, owned by the model.
+    const std::string& m_state;
     typename MultiSessionChatbot::UserDefinedActionHandler::SharedPtr
         m_userDefinedActionHandler;
     SessionIdType m_sessionId;
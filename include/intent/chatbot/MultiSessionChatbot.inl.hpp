@@ -49,23 +49,33 @@ MultiSessionChatbot<SessionIdType>::MultiSessionChatbot(
     : Chatbot(chatbotModel),
       m_userDefinedActionHandler(userDefinedActionHandler) {}
 
+template <typename SessionIdType>
+MultiSessionChatbot<SessionIdType>::MultiSessionChatbot(
+    const ChatbotModel& chatbotModel,
+    typename UserDefinedActionHandler::SharedPtr userDefinedActionHandler,
+    const SessionOptions& sessionOptions)
+    : Chatbot(chatbotModel),
+      m_sessionIndex(sessionOptions),
+      m_userDefinedActionHandler(userDefinedActionHandler) {}
+
 template <typename SessionIdType>
 std::vector<std::string> MultiSessionChatbot<SessionIdType>::treatMessage(
     const SessionIdType& sessionId, const std::string& message) {
-  typename SessionIndex::iterator it = m_sessionIndex.find(sessionId);
-
   std::vector<std::string> replies;
 
-  if (it != m_sessionIndex.end()) {
-    UserDefinedActionHandlerAdapter actionHandler(it->second.currentStateId,
-                                                  *this, replies, it->first,
-                                                  m_userDefinedActionHandler);
+  // The context is copied so that the shard of the session is not locked
+  // while the message is treated.
+  Chatbot::Context context;
+  if (m_sessionIndex.find(sessionId, context)) {
+    UserDefinedActionHandlerAdapter actionHandler(
+        getStateId(context.currentState), *this, replies, sessionId,
+        m_userDefinedActionHandler);
 
     Chatbot::VariablesMap userDefinedVariables;
     Chatbot::VariablesMap intentVariables;
-    std::string currentStateId = it->second.currentStateId;
-    Chatbot::treatMessage(message, it->second, actionHandler, intentVariables,
-                          userDefinedVariables);
+    if (Chatbot::treatMessage(message, context, actionHandler, intentVariables,
+                              userDefinedVariables))
+      m_sessionIndex.update(sessionId, context);
   }
   return replies;
 }
@@ -73,11 +83,7 @@ std::vector<std::string> MultiSessionChatbot<SessionIdType>::treatMessage(
 template <typename SessionIdType>
 void MultiSessionChatbot<SessionIdType>::addSession(
     const SessionIdType& sessionId) {
-  Chatbot::Context sessionContext;
-  sessionContext.currentStateId =
-      m_intentStoryService.getIntentStoryServiceModel()
-          .intentStoryModel->rootStateId;
-  m_sessionIndex.insert(std::make_pair(sessionId, sessionContext));
+  m_sessionIndex.insert(sessionId, getInitialContext());
 }
 
 template <typename SessionIdType>
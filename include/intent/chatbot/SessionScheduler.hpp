@@ -0,0 +1,184 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef INTENT_SESSIONSCHEDULER_HPP
+#define INTENT_SESSIONSCHEDULER_HPP
+
+#include "intent/chatbot/MultiSessionChatbot.hpp"
+#include "intent/utils/MpscQueue.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace intent {
+/**
+ * \brief Treats the messages of a MultiSessionChatbot on a set of workers.
+ *
+ * Each session is bound to one worker by the hash of its ID. The messages
+ * are pushed into the lock-free queue of that worker, so that the messages
+ * of one session are treated one after the other in the order they were
+ * submitted while the sessions of different workers are treated in parallel.
+ */
+template <typename SessionIdType>
+class SessionScheduler {
+ public:
+  typedef std::vector<std::string> Replies;
+
+  /**
+   * \brief Receive the replies of a message, called from a worker thread.
+   * The error is the exception thrown while treating the message, if any, in
+   * which case there is no reply.
+   */
+  typedef std::function<void(const Replies& replies, std::exception_ptr error)>
+      ReplyCallback;
+
+  /**
+   * \param chatbot       The chatbot treating the messages.
+   * \param workerCount   The number of worker threads, one per hardware thread
+   * if 0.
+   */
+  explicit SessionScheduler(
+      typename MultiSessionChatbot<SessionIdType>::SharedPtr chatbot,
+      size_t workerCount = 0);
+
+  /**
+   * \brief Treat the queued messages and join the workers. No message must be
+   * submitted concurrently.
+   */
+  ~SessionScheduler();
+
+  SessionScheduler(const SessionScheduler&) = delete;
+  SessionScheduler& operator=(const SessionScheduler&) = delete;
+
+  /**
+   * \brief Queue a message and call back with its replies once treated.
+   *
+   * The callback is always called, with the exception thrown by the chatbot
+   * when the message fails. An exception thrown by the callback is logged.
+   */
+  void submit(const SessionIdType& sessionId, std::string message,
+              ReplyCallback callback);
+
+  /**
+   * \brief Queue a message.
+   * \return The replies, or the exception thrown by the chatbot.
+   */
+  std::future<Replies> submit(const SessionIdType& sessionId,
+                              std::string message);
+
+  /**
+   * \brief Wait until the messages submitted so far have been treated.
+   */
+  void flush();
+
+  size_t workerCount() const { return m_workers.size(); }
+
+  /**
+   * \brief The worker treating the messages of a session.
+   */
+  size_t workerOf(const SessionIdType& sessionId) const;
+
+  /**
+   * \brief The number of messages queued on a worker and not yet taken.
+   */
+  size_t queueDepth(size_t worker) const;
+
+  /**
+   * \brief The number of messages queued on all the workers.
+   */
+  size_t queueDepth() const;
+
+  /**
+   * \brief The number of messages treated since the start.
+   */
+  size_t treatedMessages() const;
+
+ private:
+  struct Job {
+    SessionIdType sessionId;
+    std::string message;
+    ReplyCallback callback;
+    std::shared_ptr<std::promise<Replies>> promise;
+  };
+
+  struct Worker {
+    Worker()
+        : submittedMessages(0),
+          takenMessages(0),
+          treatedMessages(0),
+          waiting(false),
+          stopping(false) {}
+
+    MpscQueue<Job> queue;
+    std::atomic<size_t> submittedMessages;
+    std::atomic<size_t> takenMessages;
+    std::atomic<size_t> treatedMessages;
+
+    std::atomic<bool> waiting;
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    bool stopping;
+  };
+
+  void push(Job job);
+  void wakeWorker(Worker& worker);
+  void treat(Worker& worker, Job& job);
+  void run(Worker& worker);
+
+  typename MultiSessionChatbot<SessionIdType>::SharedPtr m_chatbot;
+  std::hash<SessionIdType> m_hash;
+
+  std::vector<std::unique_ptr<Worker>> m_workers;
+  std::vector<std::thread> m_threads;
+};
+}
+
+#include "SessionScheduler.inl.hpp"
+
+#endif  // INTENT_SESSIONSCHEDULER_HPP
@@ -0,0 +1,232 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef INTENT_SESSIONSCHEDULER_INL_HPP
+#define INTENT_SESSIONSCHEDULER_INL_HPP
+
+#include "intent/utils/Logger.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <utility>
+
+namespace intent {
+template <typename SessionIdType>
+SessionScheduler<SessionIdType>::SessionScheduler(
+    typename MultiSessionChatbot<SessionIdType>::SharedPtr chatbot,
+    size_t workerCount)
+    : m_chatbot(chatbot) {
+  if (workerCount == 0)
+    workerCount = std::max(1u, std::thread::hardware_concurrency());
+
+  for (size_t i = 0; i < workerCount; ++i)
+    m_workers.push_back(std::unique_ptr<Worker>(new Worker));
+  for (size_t i = 0; i < workerCount; ++i)
+    m_threads.push_back(std::thread(&SessionScheduler::run, this,
+                                    std::ref(*m_workers[i])));
+}
+
+template <typename SessionIdType>
+SessionScheduler<SessionIdType>::~SessionScheduler() {
+  for (std::unique_ptr<Worker>& worker : m_workers) {
+    {
+      std::lock_guard<std::mutex> lock(worker->wakeMutex);
+      worker->stopping = true;
+    }
+    worker->wake.notify_one();
+  }
+  for (std::thread& thread : m_threads) thread.join();
+}
+
+template <typename SessionIdType>
+void SessionScheduler<SessionIdType>::submit(const SessionIdType& sessionId,
+                                             std::string message,
+                                             ReplyCallback callback) {
+  Job job;
+  job.sessionId = sessionId;
+  job.message = std::move(message);
+  job.callback = std::move(callback);
+  push(std::move(job));
+}
+
+template <typename SessionIdType>
+std::future<typename SessionScheduler<SessionIdType>::Replies>
+SessionScheduler<SessionIdType>::submit(const SessionIdType& sessionId,
+                                        std::string message) {
+  Job job;
+  job.sessionId = sessionId;
+  job.message = std::move(message);
+  job.promise = std::make_shared<std::promise<Replies>>();
+  std::future<Replies> replies = job.promise->get_future();
+  push(std::move(job));
+  return replies;
+}
+
+template <typename SessionIdType>
+void SessionScheduler<SessionIdType>::flush() {
+  const std::chrono::microseconds pollingPeriod(100);
+  for (std::unique_ptr<Worker>& worker : m_workers) {
+    size_t submittedMessages =
+        worker->submittedMessages.load(std::memory_order_acquire);
+    while (worker->treatedMessages.load(std::memory_order_acquire) <
+           submittedMessages)
+      std::this_thread::sleep_for(pollingPeriod);
+  }
+}
+
+template <typename SessionIdType>
+size_t SessionScheduler<SessionIdType>::workerOf(
+    const SessionIdType& sessionId) const {
+  // Fibonacci hashing like the session store, whose shards are picked by the
+  // same high bits: the sessions of a worker mostly share the same shards.
+  uint64_t mixed =
+      static_cast<uint64_t>(m_hash(sessionId)) * UINT64_C(11400714819323198485);
+  return static_cast<size_t>(((mixed >> 32) * m_workers.size()) >> 32);
+}
+
+template <typename SessionIdType>
+size_t SessionScheduler<SessionIdType>::queueDepth(size_t worker) const {
+  // The taken messages are read first, they never outnumber the submitted
+  // ones read after.
+  size_t takenMessages =
+      m_workers[worker]->takenMessages.load(std::memory_order_acquire);
+  return m_workers[worker]->submittedMessages.load(std::memory_order_acquire) -
+         takenMessages;
+}
+
+template <typename SessionIdType>
+size_t SessionScheduler<SessionIdType>::queueDepth() const {
+  size_t depth = 0;
+  for (size_t i = 0; i < m_workers.size(); ++i) depth += queueDepth(i);
+  return depth;
+}
+
+template <typename SessionIdType>
+size_t SessionScheduler<SessionIdType>::treatedMessages() const {
+  size_t messages = 0;
+  for (const std::unique_ptr<Worker>& worker : m_workers)
+    messages += worker->treatedMessages.load(std::memory_order_relaxed);
+  return messages;
+}
+
+template <typename SessionIdType>
+void SessionScheduler<SessionIdType>::push(Job job) {
+  Worker& worker = *m_workers[workerOf(job.sessionId)];
+  worker.submittedMessages.fetch_add(1, std::memory_order_relaxed);
+  worker.queue.push(std::move(job));
+
+  // Pairs with the fence of the worker so that either it sees the message or
+  // the message sees it waiting.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (worker.waiting.load(std::memory_order_relaxed)) wakeWorker(worker);
+}
+
+template <typename SessionIdType>
+void SessionScheduler<SessionIdType>::wakeWorker(Worker& worker) {
+  std::lock_guard<std::mutex> lock(worker.wakeMutex);
+  worker.wake.notify_one();
+}
+
+template <typename SessionIdType>
+void SessionScheduler<SessionIdType>::treat(Worker& worker, Job& job) {
+  worker.takenMessages.fetch_add(1, std::memory_order_release);
+  Replies replies;
+  std::exception_ptr error;
+  try {
+    replies = m_chatbot->treatMessage(job.sessionId, job.message);
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  if (job.promise) {
+    if (error)
+      job.promise->set_exception(error);
+    else
+      job.promise->set_value(std::move(replies));
+  } else if (job.callback) {
+    try {
+      job.callback(replies, error);
+    } catch (const std::exception& e) {
+      INTENT_LOG_ERROR() << "[SessionScheduler] A reply callback failed: "
+                         << e.what();
+    } catch (...) {
+      INTENT_LOG_ERROR() << "[SessionScheduler] A reply callback failed.";
+    }
+  }
+  job.callback = nullptr;
+  job.promise.reset();
+  worker.treatedMessages.fetch_add(1, std::memory_order_release);
+}
+
+template <typename SessionIdType>
+void SessionScheduler<SessionIdType>::run(Worker& worker) {
+  // The worker also wakes up periodically, a notification missed while it
+  // goes to sleep then only delays the messages.
+  const std::chrono::milliseconds workerTimeout(50);
+
+  Job job;
+  for (;;) {
+    if (worker.queue.tryPop(job)) {
+      treat(worker, job);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(worker.wakeMutex);
+    if (worker.stopping) break;
+
+    worker.waiting.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (worker.queue.tryPop(job)) {
+      worker.waiting.store(false, std::memory_order_relaxed);
+      lock.unlock();
+      treat(worker, job);
+      continue;
+    }
+    worker.wake.wait_for(lock, workerTimeout);
+    worker.waiting.store(false, std::memory_order_relaxed);
+  }
+
+  while (worker.queue.tryPop(job)) treat(worker, job);
+}
+}
+
+#endif  // INTENT_SESSIONSCHEDULER_INL_HPP
@@ -0,0 +1,266 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef INTENT_SESSIONSTORE_HPP
+#define INTENT_SESSIONSTORE_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace intent {
+/**
+ * \brief A table of sessions that can be used from several threads at once.
+ *
+ * The sessions are spread over shards by the hash of their ID and every shard
+ * has its own lock, so that the sessions of different shards are reached in
+ * parallel. Values are copied in and out of the store so that no reference
+ * to a stored value outlives a lock.
+ *
+ * Every shard is an open addressing table of fixed-size records holding the
+ * key, the value and the time of the last activity of a session, linked from
+ * the most to the least recently used. Sessions idle for longer than the idle
+ * timeout are removed, and once the memory cap is reached a new session
+ * evicts the least recently used session of its shard.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class SessionStore {
+ public:
+  static const size_t DEFAULT_SHARD_COUNT = 64;
+
+  enum class EvictionReason { IDLE_TIMEOUT, MEMORY_CAP };
+
+  /**
+   * \brief Called with the sessions removed by the store itself, once the
+   * shard is unlocked. Sessions removed with erase are not reported.
+   */
+  typedef std::function<void(const Key& key, const Value& value,
+                             EvictionReason reason)> EvictionCallback;
+
+  typedef std::function<std::chrono::steady_clock::time_point()> Clock;
+
+  struct Options {
+    Options();
+
+    /**
+     * \brief The number of shards, rounded up to a power of two.
+     */
+    size_t shardCount;
+
+    /**
+     * \brief The time after which an idle session is removed, with a
+     * precision of one second. Sessions never expire if it is zero.
+     */
+    std::chrono::seconds idleTimeout;
+
+    /**
+     * \brief The memory the records can use, split evenly between the shards.
+     * Memory owned by the keys and values themselves is not counted. There is
+     * no cap if it is zero.
+     */
+    size_t maxBytes;
+
+    EvictionCallback evictionCallback;
+
+    /**
+     * \brief The clock giving the time of the activities, steady_clock by
+     * default.
+     */
+    Clock clock;
+  };
+
+  /**
+   * \param shardCount    The number of shards, rounded up to a power of two.
+   */
+  explicit SessionStore(size_t shardCount = DEFAULT_SHARD_COUNT);
+
+  explicit SessionStore(const Options& options);
+
+  /**
+   * \brief Add a session if it does not exist yet.
+   * \return true if the session has been added.
+   */
+  bool insert(const Key& key, const Value& value);
+
+  /**
+   * \brief Remove a session.
+   * \return true if the session existed.
+   */
+  bool erase(const Key& key);
+
+  /**
+   * \brief Copy the value of a session and mark it as active.
+   * \return true if the session exists.
+   */
+  bool find(const Key& key, Value& value);
+
+  /**
+   * \brief Replace the value of a session and mark it as active. A removed
+   * session is not added back.
+   * \return true if the session exists.
+   */
+  bool update(const Key& key, const Value& value);
+
+  /**
+   * \brief Remove the idle sessions of every shard. Idle sessions are
+   * otherwise only removed from the shards that are used.
+   * \return The number of removed sessions.
+   */
+  size_t expire();
+
+  /**
+   * \brief Returns the number of sessions. It is only a snapshot when other
+   * threads add or remove sessions.
+   */
+  size_t size() const;
+
+  /**
+   * \brief Returns the memory used by the records of the shards.
+   */
+  size_t recordBytes() const;
+
+  /**
+   * \brief Returns the size of the record of a session.
+   */
+  static size_t recordSize() { return sizeof(Record); }
+
+ private:
+  struct Record {
+    Key key;
+    Value value;
+
+    /**
+     * \brief Seconds since the creation of the store.
+     */
+    uint32_t lastActivity;
+
+    /**
+     * \brief The neighbours in the list from the most to the least recently
+     * used records. previous is EMPTY_SLOT for a free slot.
+     */
+    uint32_t previous;
+    uint32_t next;
+  };
+
+  struct Shard {
+    Shard() : count(0), head(NO_SLOT), tail(NO_SLOT) {}
+
+    mutable std::mutex mutex;
+    std::vector<Record> records;
+    uint32_t count;
+
+    /**
+     * \brief The most recently used record.
+     */
+    uint32_t head;
+
+    /**
+     * \brief The least recently used record.
+     */
+    uint32_t tail;
+
+    // Keeps the locks of neighbour shards on separate cache lines.
+    char padding[64];
+  };
+
+  struct Eviction {
+    Key key;
+    Value value;
+    EvictionReason reason;
+  };
+
+  typedef std::vector<Eviction> Evictions;
+
+  static const uint32_t NO_SLOT = 0xfffffffe;
+  static const uint32_t EMPTY_SLOT = 0xffffffff;
+  static const size_t MIN_SLOTS = 8;
+
+  void initialize();
+
+  static uint32_t distance(uint32_t from, uint32_t to, size_t slotCount) {
+    return static_cast<uint32_t>(to >= from ? to - from
+                                            : to + slotCount - from);
+  }
+
+  uint64_t mix(const Key& key) const;
+  Shard& shardOf(uint64_t mixed);
+  uint32_t homeSlot(uint64_t mixed, size_t slotCount) const;
+  uint32_t now() const;
+
+  uint32_t locate(const Shard& shard, const Key& key, uint64_t mixed) const;
+  uint32_t place(const Shard& shard, uint64_t mixed) const;
+  void link(Shard& shard, uint32_t slot);
+  void unlink(Shard& shard, uint32_t slot);
+  void move(Shard& shard, uint32_t from, uint32_t to);
+  void touch(Shard& shard, uint32_t slot, uint32_t time);
+  void remove(Shard& shard, uint32_t slot);
+  void grow(Shard& shard);
+  void evict(Shard& shard, uint32_t slot, EvictionReason reason,
+             Evictions& evictions);
+  void removeIdle(Shard& shard, uint32_t time, Evictions& evictions);
+  void notify(const Evictions& evictions) const;
+
+  std::vector<Shard> m_shards;
+
+  /**
+   * \brief The shard of a key is given by the high bits of its mixed hash, the
+   * following bits give its slot in the shard.
+   */
+  unsigned int m_shardShift;
+
+  /**
+   * \brief The maximum numbers of slots and records of a shard.
+   */
+  size_t m_maxSlots;
+  size_t m_maxRecords;
+
+  Options m_options;
+  std::chrono::steady_clock::time_point m_epoch;
+  Hash m_hash;
+};
+}
+
+#include "SessionStore.inl.hpp"
+
+#endif  // INTENT_SESSIONSTORE_HPP
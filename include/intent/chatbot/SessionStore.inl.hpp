@@ -0,0 +1,409 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef INTENT_SESSIONSTORE_INL_HPP
+#define INTENT_SESSIONSTORE_INL_HPP
+
+namespace intent {
+template <typename Key, typename Value, typename Hash>
+const size_t SessionStore<Key, Value, Hash>::DEFAULT_SHARD_COUNT;
+
+template <typename Key, typename Value, typename Hash>
+const uint32_t SessionStore<Key, Value, Hash>::NO_SLOT;
+
+template <typename Key, typename Value, typename Hash>
+const uint32_t SessionStore<Key, Value, Hash>::EMPTY_SLOT;
+
+template <typename Key, typename Value, typename Hash>
+const size_t SessionStore<Key, Value, Hash>::MIN_SLOTS;
+
+template <typename Key, typename Value, typename Hash>
+SessionStore<Key, Value, Hash>::Options::Options()
+    : shardCount(DEFAULT_SHARD_COUNT),
+      idleTimeout(0),
+      maxBytes(0),
+      clock(&std::chrono::steady_clock::now) {}
+
+template <typename Key, typename Value, typename Hash>
+SessionStore<Key, Value, Hash>::SessionStore(size_t shardCount) {
+  m_options.shardCount = shardCount;
+  initialize();
+}
+
+template <typename Key, typename Value, typename Hash>
+SessionStore<Key, Value, Hash>::SessionStore(const Options& options)
+    : m_options(options) {
+  initialize();
+}
+
+template <typename Key, typename Value, typename Hash>
+void SessionStore<Key, Value, Hash>::initialize() {
+  size_t shardCount = 1;
+  m_shardShift = 64;
+  while (shardCount < m_options.shardCount) {
+    shardCount *= 2;
+    --m_shardShift;
+  }
+  m_shards = std::vector<Shard>(shardCount);
+
+  // A shard keeps at least one free slot to end the probes, and a fifth of
+  // its slots free to keep them short.
+  m_maxSlots = NO_SLOT;
+  if (m_options.maxBytes > 0) {
+    m_maxSlots = std::min<size_t>(
+        m_maxSlots, m_options.maxBytes / shardCount / sizeof(Record));
+    m_maxSlots = std::max<size_t>(m_maxSlots, 2);
+  }
+  m_maxRecords = std::min<size_t>(m_maxSlots / 5 * 4, m_maxSlots - 1);
+  m_maxRecords = std::max<size_t>(m_maxRecords, 1);
+
+  if (!m_options.clock) m_options.clock = &std::chrono::steady_clock::now;
+  m_epoch = m_options.clock();
+}
+
+template <typename Key, typename Value, typename Hash>
+uint64_t SessionStore<Key, Value, Hash>::mix(const Key& key) const {
+  // Fibonacci hashing spreads the keys whose hashes only differ in their low
+  // bits, like the identity hash of integers.
+  return static_cast<uint64_t>(m_hash(key)) * UINT64_C(11400714819323198485);
+}
+
+template <typename Key, typename Value, typename Hash>
+typename SessionStore<Key, Value, Hash>::Shard&
+SessionStore<Key, Value, Hash>::shardOf(uint64_t mixed) {
+  return m_shards[m_shardShift == 64 ? 0 : mixed >> m_shardShift];
+}
+
+template <typename Key, typename Value, typename Hash>
+uint32_t SessionStore<Key, Value, Hash>::homeSlot(uint64_t mixed,
+                                                  size_t slotCount) const {
+  uint64_t bits = (mixed << (64 - m_shardShift)) >> 32;
+  return static_cast<uint32_t>((bits * slotCount) >> 32);
+}
+
+template <typename Key, typename Value, typename Hash>
+uint32_t SessionStore<Key, Value, Hash>::now() const {
+  if (m_options.idleTimeout.count() == 0) return 0;
+  std::chrono::seconds elapsed =
+      std::chrono::duration_cast<std::chrono::seconds>(m_options.clock() -
+                                                       m_epoch);
+  return static_cast<uint32_t>(elapsed.count());
+}
+
+template <typename Key, typename Value, typename Hash>
+uint32_t SessionStore<Key, Value, Hash>::locate(const Shard& shard,
+                                                const Key& key,
+                                                uint64_t mixed) const {
+  size_t slotCount = shard.records.size();
+  if (slotCount == 0) return NO_SLOT;
+
+  for (uint32_t slot = homeSlot(mixed, slotCount);
+       shard.records[slot].previous != EMPTY_SLOT;) {
+    if (shard.records[slot].key == key) return slot;
+    if (++slot == slotCount) slot = 0;
+  }
+  return NO_SLOT;
+}
+
+template <typename Key, typename Value, typename Hash>
+uint32_t SessionStore<Key, Value, Hash>::place(const Shard& shard,
+                                               uint64_t mixed) const {
+  size_t slotCount = shard.records.size();
+  uint32_t slot = homeSlot(mixed, slotCount);
+  while (shard.records[slot].previous != EMPTY_SLOT)
+    if (++slot == slotCount) slot = 0;
+  return slot;
+}
+
+template <typename Key, typename Value, typename Hash>
+void SessionStore<Key, Value, Hash>::link(Shard& shard, uint32_t slot) {
+  Record& record = shard.records[slot];
+  record.previous = NO_SLOT;
+  record.next = shard.head;
+  if (shard.head != NO_SLOT)
+    shard.records[shard.head].previous = slot;
+  else
+    shard.tail = slot;
+  shard.head = slot;
+}
+
+template <typename Key, typename Value, typename Hash>
+void SessionStore<Key, Value, Hash>::unlink(Shard& shard, uint32_t slot) {
+  const Record& record = shard.records[slot];
+  if (record.previous != NO_SLOT)
+    shard.records[record.previous].next = record.next;
+  else
+    shard.head = record.next;
+  if (record.next != NO_SLOT)
+    shard.records[record.next].previous = record.previous;
+  else
+    shard.tail = record.previous;
+}
+
+template <typename Key, typename Value, typename Hash>
+void SessionStore<Key, Value, Hash>::move(Shard& shard, uint32_t from,
+                                          uint32_t to) {
+  Record& record = shard.records[to];
+  record = std::move(shard.records[from]);
+  if (record.previous != NO_SLOT)
+    shard.records[record.previous].next = to;
+  else
+    shard.head = to;
+  if (record.next != NO_SLOT)
+    shard.records[record.next].previous = to;
+  else
+    shard.tail = to;
+}
+
+template <typename Key, typename Value, typename Hash>
+void SessionStore<Key, Value, Hash>::touch(Shard& shard, uint32_t slot,
+                                           uint32_t time) {
+  shard.records[slot].lastActivity = time;
+  if (shard.head == slot) return;
+  unlink(shard, slot);
+  link(shard, slot);
+}
+
+template <typename Key, typename Value, typename Hash>
+void SessionStore<Key, Value, Hash>::remove(Shard& shard, uint32_t slot) {
+  unlink(shard, slot);
+
+  // Backward shift deletion: the records following the hole move back into
+  // it when it is on their probe sequence, so that no tombstone is needed.
+  size_t slotCount = shard.records.size();
+  uint32_t hole = slot;
+  for (uint32_t next = slot;;) {
+    if (++next == slotCount) next = 0;
+    if (shard.records[next].previous == EMPTY_SLOT) break;
+
+    uint32_t home = homeSlot(mix(shard.records[next].key), slotCount);
+    if (distance(home, next, slotCount) >= distance(hole, next, slotCount)) {
+      move(shard, next, hole);
+      hole = next;
+    }
+  }
+
+  Record& freed = shard.records[hole];
+  freed.key = Key();
+  freed.value = Value();
+  freed.previous = EMPTY_SLOT;
+  --shard.count;
+}
+
+template <typename Key, typename Value, typename Hash>
+void SessionStore<Key, Value, Hash>::grow(Shard& shard) {
+  size_t slotCount = std::max(MIN_SLOTS, shard.records.size() * 2);
+  std::vector<Record> records(std::min(slotCount, m_maxSlots));
+  for (Record& record : records) record.previous = EMPTY_SLOT;
+  records.swap(shard.records);
+
+  // The records are placed back from the least to the most recently used to
+  // keep their order.
+  uint32_t oldTail = shard.tail;
+  shard.head = NO_SLOT;
+  shard.tail = NO_SLOT;
+  for (uint32_t old = oldTail; old != NO_SLOT; old = records[old].previous) {
+    uint32_t slot = place(shard, mix(records[old].key));
+    Record& record = shard.records[slot];
+    record.key = std::move(records[old].key);
+    record.value = std::move(records[old].value);
+    record.lastActivity = records[old].lastActivity;
+    link(shard, slot);
+  }
+}
+
+template <typename Key, typename Value, typename Hash>
+void SessionStore<Key, Value, Hash>::evict(Shard& shard, uint32_t slot,
+                                           EvictionReason reason,
+                                           Evictions& evictions) {
+  Eviction eviction;
+  eviction.key = shard.records[slot].key;
+  eviction.value = shard.records[slot].value;
+  eviction.reason = reason;
+  evictions.push_back(eviction);
+  remove(shard, slot);
+}
+
+template <typename Key, typename Value, typename Hash>
+void SessionStore<Key, Value, Hash>::removeIdle(Shard& shard, uint32_t time,
+                                                Evictions& evictions) {
+  uint32_t idleTimeout = static_cast<uint32_t>(m_options.idleTimeout.count());
+  if (idleTimeout == 0) return;
+
+  // The least recently used records are the ones idle for the longest time.
+  while (shard.tail != NO_SLOT &&
+         time - shard.records[shard.tail].lastActivity >= idleTimeout)
+    evict(shard, shard.tail, EvictionReason::IDLE_TIMEOUT, evictions);
+}
+
+template <typename Key, typename Value, typename Hash>
+void SessionStore<Key, Value, Hash>::notify(
+    const Evictions& evictions) const {
+  if (!m_options.evictionCallback) return;
+  for (const Eviction& eviction : evictions)
+    m_options.evictionCallback(eviction.key, eviction.value, eviction.reason);
+}
+
+template <typename Key, typename Value, typename Hash>
+bool SessionStore<Key, Value, Hash>::insert(const Key& key,
+                                            const Value& value) {
+  uint64_t mixed = mix(key);
+  Shard& shard = shardOf(mixed);
+  Evictions evictions;
+  bool inserted = false;
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    uint32_t time = now();
+    removeIdle(shard, time, evictions);
+
+    if (locate(shard, key, mixed) == NO_SLOT) {
+      if (shard.count >= m_maxRecords)
+        evict(shard, shard.tail, EvictionReason::MEMORY_CAP, evictions);
+      if (shard.records.size() < m_maxSlots &&
+          (shard.count + 1) * 5 > shard.records.size() * 4)
+        grow(shard);
+
+      uint32_t slot = place(shard, mixed);
+      Record& record = shard.records[slot];
+      record.key = key;
+      record.value = value;
+      record.lastActivity = time;
+      link(shard, slot);
+      ++shard.count;
+      inserted = true;
+    }
+  }
+  notify(evictions);
+  return inserted;
+}
+
+template <typename Key, typename Value, typename Hash>
+bool SessionStore<Key, Value, Hash>::erase(const Key& key) {
+  uint64_t mixed = mix(key);
+  Shard& shard = shardOf(mixed);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  uint32_t slot = locate(shard, key, mixed);
+  if (slot == NO_SLOT) return false;
+  remove(shard, slot);
+  return true;
+}
+
+template <typename Key, typename Value, typename Hash>
+bool SessionStore<Key, Value, Hash>::find(const Key& key, Value& value) {
+  uint64_t mixed = mix(key);
+  Shard& shard = shardOf(mixed);
+  Evictions evictions;
+  bool found = false;
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    uint32_t time = now();
+    removeIdle(shard, time, evictions);
+
+    uint32_t slot = locate(shard, key, mixed);
+    if (slot != NO_SLOT) {
+      value = shard.records[slot].value;
+      touch(shard, slot, time);
+      found = true;
+    }
+  }
+  notify(evictions);
+  return found;
+}
+
+template <typename Key, typename Value, typename Hash>
+bool SessionStore<Key, Value, Hash>::update(const Key& key,
+                                            const Value& value) {
+  uint64_t mixed = mix(key);
+  Shard& shard = shardOf(mixed);
+  Evictions evictions;
+  bool found = false;
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    uint32_t time = now();
+    removeIdle(shard, time, evictions);
+
+    uint32_t slot = locate(shard, key, mixed);
+    if (slot != NO_SLOT) {
+      shard.records[slot].value = value;
+      touch(shard, slot, time);
+      found = true;
+    }
+  }
+  notify(evictions);
+  return found;
+}
+
+template <typename Key, typename Value, typename Hash>
+size_t SessionStore<Key, Value, Hash>::expire() {
+  size_t count = 0;
+  for (Shard& shard : m_shards) {
+    Evictions evictions;
+    {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      removeIdle(shard, now(), evictions);
+    }
+    notify(evictions);
+    count += evictions.size();
+  }
+  return count;
+}
+
+template <typename Key, typename Value, typename Hash>
+size_t SessionStore<Key, Value, Hash>::size() const {
+  size_t count = 0;
+  for (const Shard& shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    count += shard.count;
+  }
+  return count;
+}
+
+template <typename Key, typename Value, typename Hash>
+size_t SessionStore<Key, Value, Hash>::recordBytes() const {
+  size_t bytes = 0;
+  for (const Shard& shard : m_shards) {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    bytes += shard.records.size() * sizeof(Record);
+  }
+  return bytes;
+}
+}
+
+#endif  // INTENT_SESSIONSTORE_INL_HPP
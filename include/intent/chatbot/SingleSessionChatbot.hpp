@@ -73,14 +73,21 @@ class SingleSessionChatbot : protected Chatbot {
 
   /**
    * \brief   Returns the single session context.
-   * \return  The session context, i.e., the state ID and the user defined
+   * \return  The session context, i.e., the state handle and the user defined
    * variables.
    */
   Context getContext() const { return m_context; }
 
+  /**
+   * \brief   Returns the ID of the current state of the single session.
+   */
+  const std::string& getCurrentStateId() const {
+    return getStateId(m_context.currentState);
+  }
+
  private:
   /**
-   * \brief The session context, i.e., the state ID and the user defined
+   * \brief The session context, i.e., the state handle and the user defined
    * variables.
    */
   Chatbot::Context m_context;
@@ -116,7 +123,8 @@ class SingleSessionChatbot : protected Chatbot {
     }
 
    private:
-    const std::string m_state;
+    // The ID of the state the message was received in, owned by the model.
+    const std::string& m_state;
     typename Chatbot::UserDefinedActionHandler::SharedPtr
         m_userDefinedActionHandler;
     SingleSessionChatbot& m_chatbot;
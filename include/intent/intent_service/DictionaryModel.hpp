@@ -49,6 +49,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "Term.hpp"
 #include "TermIndex.hpp"
+#include "intent/utils/RegexMatcher.hpp"
 
 namespace intent {
 /**
@@ -66,12 +67,30 @@ class DictionaryModel {
   typedef std::string Entity;
 
   typedef std::unordered_map<int, Entity> EntityByEntityIdIndex;
-  typedef std::unordered_map<std::string, int> RegexToEntityIdIndex;
   typedef std::shared_ptr<DictionaryModel> SharedPtr;
 
+  /**
+   * \brief A regular expression bound to an entity, compiled at load time and
+   * owned by the model.
+   */
+  struct Regex {
+    std::string pattern;
+    RegexMatcher::CompiledRegex compiledRegex;
+    int entityId;
+  };
+
+  typedef std::vector<Regex> Regexes;
+
   DictionaryModel();
   void initBuiltInEntities();
 
+  /**
+   * \brief Bind a regular expression to an entity. The expression is compiled
+   * here so that no compilation happens while evaluating messages.
+   * Throws std::regex_error if the expression is invalid.
+   */
+  void addRegex(const std::string& pattern, int entityId);
+
   /**
    * \brief The dictionary of terms and aliases.
    */
@@ -83,9 +102,10 @@ class DictionaryModel {
   EntityByEntityIdIndex entitiesByEntityId;
 
   /**
-   * \brief A map of regular expressions by entity id.
+   * \brief The compiled regular expressions in the order they were added.
+   * Filled by addRegex, the matchers only read this list.
    */
-  RegexToEntityIdIndex regexesByEntityId;
+  Regexes regexes;
 };
 }
 
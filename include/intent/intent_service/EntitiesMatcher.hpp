@@ -80,6 +80,21 @@ class EntitiesMatcher {
    */
   static Variables match(const Tokenizer::Tokens& tokens,
                          const DictionaryModel& dictionaryModel);
+
+  /**
+   * \brief Matches a list of entities from a list of token views.
+   *
+   * The cost is linear in the number of tokens: the multi-word aliases only
+   * look ahead of the current token, without copying the rest of the sentence.
+   *
+   * \param tokens            The views of the tokens to extract the entities
+   * from
+   * \param dictionaryModel   The dictionary model containing the whole set of
+   * entities.
+   * \return                  A list of variables representing the matches.
+   */
+  static Variables match(const Tokenizer::TokenViews& tokens,
+                         const DictionaryModel& dictionaryModel);
 };
 
 std::ostream& operator<<(std::ostream& os,
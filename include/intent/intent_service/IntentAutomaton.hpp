@@ -0,0 +1,171 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef INTENT_INTENTAUTOMATON_HPP
+#define INTENT_INTENTAUTOMATON_HPP
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "IntentModel.hpp"
+
+namespace intent {
+/**
+ * \brief Deterministic automaton over entity ids compiled from all the intents
+ * of an intent index.
+ *
+ * Each intent is a sequence of entity ids possibly containing the regex
+ * markers []()|*. Those markers are interpreted at the entity level: '*'
+ * repeats the previous entity or group, '|' separates alternatives and [...]
+ * matches exactly one of the listed entities. All the intents using markers
+ * are compiled once into a single DFA so that matching a sequence of entities
+ * is a single linear pass reporting every accepting intent.
+ *
+ * The plain intents, made of entities only, are kept out of the DFA in a hash
+ * map keyed by their sequence of entities so that they are found with a
+ * single probe.
+ *
+ * The automaton refers to the intents of the compiled index without copying
+ * them, the index must outlive it and stay unchanged.
+ */
+class IntentAutomaton {
+ public:
+  /**
+   * \brief Reference to an intent of the automaton. References follow the
+   * order of the intent ids in the compiled index.
+   */
+  typedef int IntentRef;
+  typedef std::vector<IntentRef> IntentRefs;
+
+  IntentAutomaton();
+
+  /**
+   * \param intentIndex    The intents to compile.
+   */
+  explicit IntentAutomaton(const IntentModel::IntentIndex& intentIndex);
+
+  /**
+   * \brief Compile the intents of the index into the automaton, replacing the
+   * previous content. Malformed intents are reported and never match.
+   */
+  void compile(const IntentModel::IntentIndex& intentIndex);
+
+  /**
+   * \brief Run the automaton on a sequence of entity ids.
+   *
+   * \param entityIds         The sequence of entities found in a sentence.
+   * \param acceptingIntents  Filled with the sorted references of all the
+   * intents matching the whole sequence.
+   */
+  void match(const std::vector<int>& entityIds,
+             IntentRefs& acceptingIntents) const;
+
+  /**
+   * \brief Same as above but only reports the intents listed in
+   * allowedIntents that must be sorted.
+   */
+  void match(const std::vector<int>& entityIds,
+             const IntentRefs& allowedIntents,
+             IntentRefs& acceptingIntents) const;
+
+  /**
+   * \brief Return the reference of an intent given its id or -1 if the intent
+   * is unknown.
+   */
+  IntentRef findIntent(const IntentModel::IndexType& intentId) const;
+
+  const IntentModel::IndexType& getIntentId(IntentRef intentRef) const {
+    return m_intents[intentRef]->first;
+  }
+
+  const IntentModel::Intent& getIntent(IntentRef intentRef) const {
+    return m_intents[intentRef]->second;
+  }
+
+  size_t intentCount() const { return m_intents.size(); }
+
+  size_t stateCount() const { return m_acceptOffsets.size() - 1; }
+
+ private:
+  struct EntitySequenceHash {
+    size_t operator()(const std::vector<int>& entityIds) const {
+      // FNV-1a over the entity ids.
+      size_t hash = 2166136261u;
+      for (int entityId : entityIds) {
+        hash ^= static_cast<size_t>(entityId);
+        hash *= 16777619u;
+      }
+      return hash;
+    }
+  };
+
+  // The sorted references of the plain intents by sequence of entities.
+  typedef std::unordered_map<std::vector<int>, IntentRefs, EntitySequenceHash>
+      PlainIntents;
+
+  int step(int state, int entityId) const;
+
+  void matchPatterns(const std::vector<int>& entityIds,
+                     IntentRefs& acceptingIntents) const;
+
+  // The intents of the compiled index by reference.
+  std::vector<IntentModel::IntentIndex::const_iterator> m_intents;
+
+  PlainIntents m_plainIntents;
+
+  // Column of each entity id in the transition table, -1 when the entity does
+  // not appear in any intent.
+  std::vector<int> m_columnByEntityId;
+  int m_columnCount;
+
+  // Dense transition table of stateCount() * m_columnCount next states, -1
+  // being the dead state. The state 0 is the initial state.
+  std::vector<int> m_transitions;
+
+  // Accepting intents of state s are in
+  // m_acceptingIntents[m_acceptOffsets[s], m_acceptOffsets[s + 1]).
+  std::vector<int> m_acceptOffsets;
+  IntentRefs m_acceptingIntents;
+};
+}
+
+#endif  // INTENT_INTENTAUTOMATON_HPP
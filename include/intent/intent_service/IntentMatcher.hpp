@@ -44,6 +44,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <string>
 
 #include "intent/intent_service/EntitiesMatcher.hpp"
+#include "IntentAutomaton.hpp"
 #include "IntentModel.hpp"
 
 namespace intent {
@@ -112,12 +113,21 @@ class IntentMatcher {
   };
 
   /**
-   * Matches the intent contained in the index and return the matching variables
-   * as a result.
+   * Matches the intents compiled in the automaton and return the matching
+   * variables as a result.
    */
   static IntentResult match(const DictionaryModel& dictionaryModel,
                             const Variables& variables,
-                            const IntentIndex& intentByIdIndex);
+                            const IntentAutomaton& intentAutomaton);
+
+  /**
+   * Same as above but only considers the intents listed in allowedIntents.
+   * This list must be sorted.
+   */
+  static IntentResult match(const DictionaryModel& dictionaryModel,
+                            const Variables& variables,
+                            const IntentAutomaton& intentAutomaton,
+                            const IntentAutomaton::IntentRefs& allowedIntents);
 
   /**
    * Build full match intent, with one matching entity, the full user message
@@ -41,6 +41,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #ifndef INTENT_INTENTMODEL_HPP
 #define INTENT_INTENTMODEL_HPP
 
+#include <list>
 #include <map>
 #include <memory>
 #include <queue>
@@ -56,7 +57,13 @@ namespace intent {
  */
 class IntentModel {
  public:
-  typedef std::map<std::string, std::queue<std::string>> EntityToNames;
+  /**
+   * \brief The names of the variables of an entity, in the order of the
+   * matches. A list is cheaper to copy than the default deque for the few
+   * names of an entity, and intents are copied into the graph and on matches.
+   */
+  typedef std::queue<std::string, std::list<std::string>> VariableNames;
+  typedef std::map<std::string, VariableNames> EntityToNames;
 
   /**
    * \brief Representation of an intent.
@@ -43,9 +43,15 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include <memory>
 #include <string>
+#include <vector>
+
+#include <boost/utility/string_ref.hpp>
 
 #include "intent/intent_service/EntitiesMatcher.hpp"
+#include "intent/intent_service/IntentAutomaton.hpp"
 #include "intent/intent_service/IntentMatcher.hpp"
+#include "intent/intent_service/SentenceTokenizer.hpp"
+#include "intent/utils/ThreadPool.hpp"
 #include "IntentServiceModel.hpp"
 
 namespace intent {
@@ -59,6 +65,8 @@ class IntentService {
   typedef IntentMatcher::IntentResult Result;
   typedef IntentMatcher::EntityMatch EntityMatch;
   typedef IntentMatcher::EntityMatches EntityMatches;
+  typedef std::vector<Result> Results;
+  typedef std::vector<boost::string_ref> Inputs;
 
   /**
    * \param intentServiceModel    The model used to find intents in sentences.
@@ -67,8 +75,23 @@ class IntentService {
 
   /**
    * \brief Try to find a user intent and returns the result.
+   *
+   * The input is tokenized in place, it is only copied for the texts of the
+   * matched entities.
+   */
+  Result evaluate(boost::string_ref input) const;
+
+  /**
+   * \brief Find the user intents of several inputs using a pool of threads.
+   *
+   * The workers share the read-only model, each of them reusing its own
+   * scratch buffers.
+   *
+   * \param inputs      The inputs, they must outlive the call.
+   * \param threadPool  The pool running the evaluations.
+   * \return The results in the order of the inputs.
    */
-  Result evaluate(const std::string& input) const;
+  Results evaluateBatch(const Inputs& inputs, ThreadPool& threadPool) const;
 
   const IntentServiceModel& getIntentServiceModel() const {
     return m_intentServiceModel;
@@ -76,10 +99,25 @@ class IntentService {
 
  protected:
   IntentMatcher::IntentResult resolveIntent(
-      const std::string& input, const DictionaryModel& dictionaryModel,
-      const IntentModel::IntentIndex& intentByIdIndex) const;
+      boost::string_ref input, const DictionaryModel& dictionaryModel,
+      const IntentAutomaton& intentAutomaton) const;
+
+  IntentMatcher::IntentResult resolveIntent(
+      boost::string_ref input, const DictionaryModel& dictionaryModel,
+      const IntentAutomaton& intentAutomaton,
+      const IntentAutomaton::IntentRefs& allowedIntents) const;
 
   IntentServiceModel m_intentServiceModel;
+
+  /**
+   * \brief The tokenizer of the dictionary, built once at construction.
+   */
+  std::shared_ptr<const SentenceTokenizer> m_sentenceTokenizer;
+
+  /**
+   * \brief The intents of the model compiled once at construction.
+   */
+  IntentAutomaton m_intentAutomaton;
 };
 
 std::ostream& operator<<(std::ostream& os, const IntentService::Result& result);
@@ -0,0 +1,155 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef INTENT_PHRASETRIE_HPP
+#define INTENT_PHRASETRIE_HPP
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/utility/string_ref.hpp>
+
+#include "intent/utils/PackedArray.hpp"
+
+namespace intent {
+class BinaryReader;
+class BinaryWriter;
+
+/**
+ * \brief Trie of lowercase phrases indexed word by word.
+ *
+ * Each phrase is split on spaces and every node of the trie stands for a
+ * sequence of words. Looking for the longest phrase starting at a given token
+ * of a sentence walks down the trie, one binary search per word, without
+ * copying or lowering the tokens.
+ *
+ * The new children are appended to their node and found through a hash index
+ * while inserting, pack() puts them in order once and packs the trie in flat
+ * arrays for the lookups. The arrays hold no pointer, a trie read from a
+ * mapped snapshot refers to the mapping instead of copying it.
+ */
+class PhraseTrie {
+ public:
+  typedef boost::string_ref Word;
+  typedef std::vector<Word>::const_iterator WordIterator;
+
+  PhraseTrie();
+
+  /**
+   * \brief Associate a value with a phrase, replacing the previous one.
+   * \param phrase    The phrase made of lowercase words separated by spaces.
+   * \param value     The value returned by the lookups, it must not be -1.
+   */
+  void insert(const std::string& phrase, int value);
+
+  /**
+   * \brief Order the children inserted since the last call and pack the
+   * trie. Must be called before any lookup following an insertion.
+   */
+  void pack();
+
+  /**
+   * \brief Find the longest phrase made of the first words of a range. The
+   * words are compared case insensitively.
+   * \param begin     The first word of the range.
+   * \param end       The end of the range.
+   * \param value     The value of the phrase if one is found.
+   * \return the number of words of the phrase, 0 if none is found.
+   */
+  size_t longestMatch(WordIterator begin, WordIterator end, int& value) const;
+
+  /**
+   * \brief The number of phrases in the trie.
+   */
+  size_t size() const { return m_size; }
+
+  /**
+   * \brief Write the packed trie.
+   */
+  void writeTo(BinaryWriter& writer) const;
+
+  /**
+   * \brief Restore a trie written by writeTo, replacing the content. It
+   * refers to the buffer of the reader when it gives its storage.
+   * Throws BinaryStreamException if it is not consistent.
+   */
+  void readFrom(BinaryReader& reader);
+
+ private:
+  typedef uint32_t NodeId;
+  typedef std::pair<std::string, NodeId> Child;
+
+  struct Node {
+    Node() : value(-1), sortedChildren(0) {}
+
+    int value;
+    // Sorted by word up to sortedChildren, the next ones are not sorted yet.
+    std::vector<Child> children;
+    size_t sortedChildren;
+  };
+
+  Word childWord(uint32_t child) const;
+  bool findChild(NodeId& nodeId, Word word) const;
+  void unpack();
+  static std::string pendingKey(NodeId nodeId, Word word);
+
+  // The nodes being built, empty once packed.
+  std::vector<Node> m_nodes;
+  size_t m_size;
+
+  // The unsorted children by parent and word, and the nodes having some.
+  std::unordered_map<std::string, NodeId> m_pendingChildren;
+  std::vector<NodeId> m_unsortedNodes;
+
+  // The packed trie. The children of node i are the sorted range
+  // [m_childBegin[i], m_childBegin[i + 1]) of m_childNodes and the word of
+  // child c is m_words[m_wordBegin[c], m_wordBegin[c + 1]).
+  PackedArray<int32_t> m_values;
+  PackedArray<uint32_t> m_childBegin;
+  PackedArray<NodeId> m_childNodes;
+  PackedArray<uint32_t> m_wordBegin;
+  PackedArray<char> m_words;
+};
+}
+
+#endif  // INTENT_PHRASETRIE_HPP
@@ -45,6 +45,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <vector>
 
 #include "intent/intent_service/DictionaryModel.hpp"
+#include "intent/utils/Tokenizer.hpp"
 
 namespace intent {
 
@@ -52,11 +53,14 @@ class SentenceTokenizer {
  public:
   SentenceTokenizer(const DictionaryModel& dictionaryModel);
 
-  void tokenize(const std::string sentence,
+  void tokenize(const std::string& sentence,
                 std::vector<std::string>& tokens) const;
 
+  void tokenize(boost::string_ref sentence,
+                Tokenizer::TokenViews& tokens) const;
+
  private:
-  std::vector<std::string> m_regexpList;
+  Tokenizer m_tokenizer;
 };
 }
 
@@ -41,19 +41,63 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #ifndef INTENT_TERMINDEX_HPP
 #define INTENT_TERMINDEX_HPP
 
+#include "PhraseTrie.hpp"
 #include "Term.hpp"
+#include "TrigramIndex.hpp"
+
+#include <atomic>
+#include <mutex>
 #include <unordered_map>
 #include <set>
+#include <vector>
 
-namespace intent {
-typedef std::unordered_map<std::string, std::set<int>> TrigramIndex;
+#include <boost/utility/string_ref.hpp>
+
+#include "intent/utils/PackedArray.hpp"
 
+namespace intent {
 /**
  * \brief Index of terms using trigrams to allow error correction during the
  * matching.
+ *
+ * The pushed terms and their trigrams are staged until the first lookup, or an
+ * explicit call to compact(), packs them into a table of terms sorted by id
+ * and an immutable TrigramIndex. Lookups can safely run concurrently, pushing
+ * terms cannot.
+ *
+ * The packed index holds no pointer, an index read from a mapped snapshot
+ * refers to the mapping instead of copying it, so that the processes mapping
+ * the same snapshot share a single copy of the dictionary.
+ *
+ * The exact terms and aliases, made of one or several words, are also kept in
+ * a PhraseTrie so that they are found without any fuzzy matching.
  */
 class TermIndex {
  public:
+  /**
+   * \brief A token of the sentence referencing the tokenized buffer.
+   */
+  typedef boost::string_ref TokenView;
+  typedef std::vector<TokenView> TokenViews;
+
+  /**
+   * \brief A term found as is in a sentence.
+   */
+  struct PhraseMatch {
+    // The index of the first word of the match in the sentence.
+    size_t position;
+    // The number of words of the match.
+    size_t length;
+    int termId;
+    int entityId;
+  };
+
+  typedef std::vector<PhraseMatch> PhraseMatches;
+
+  TermIndex();
+  TermIndex(const TermIndex& that);
+  TermIndex& operator=(const TermIndex& that);
+
   /**
    * \brief pushTerm      pushes a term into the index, so it can be later found
    * by fuzzy matching
@@ -61,6 +105,22 @@ class TermIndex {
    */
   void pushTerm(const Term& term);
 
+  /**
+   * \brief renumberTerms gives new ids to the pushed terms, for loaders that
+   * push the terms before their final ids are known
+   * \param termIdMap     the new id of each term by current id, the terms
+   * mapped to -1 are removed
+   * \param entityIdMap   the new id of each entity by current id
+   *
+   * The ids past the end of a map, like the ones of the built-in terms, are
+   * kept as they are.
+   *
+   * The exact terms are indexed again in the order of the new ids, as if they
+   * had been pushed in that order, and the index is compacted.
+   */
+  void renumberTerms(const std::vector<int>& termIdMap,
+                     const std::vector<int>& entityIdMap);
+
   /**
    * \brief findTerm      finds a term in the index if it is constituted by one
    * word
@@ -82,6 +142,54 @@ class TermIndex {
                 const std::vector<std::string>& buffer,
                 int& tokensPopped) const;
 
+  /**
+   * \brief findTerm      finds a term in the index it can be constituted of
+   * multiple consecutive words
+   * \param token         the word to match with an alias of the term
+   * \param bufferBegin   the words of the sentence starting with token
+   * \param bufferEnd     the end of the words of the sentence
+   * \param tokensPopped  the number of additional words of the sentence that
+   * are used to match the term
+   * \return foundTerm
+   *
+   * The longest exact term or alias is looked for first, the fuzzy matching is
+   * the fallback.
+   */
+  Term findTerm(TokenView token, TokenViews::const_iterator bufferBegin,
+                TokenViews::const_iterator bufferEnd, int& tokensPopped) const;
+
+  /**
+   * \brief findApproximateTerm finds a term by fuzzy matching, it can be
+   * constituted of multiple consecutive words
+   * \param token         the word to match with an alias of the term
+   * \param bufferBegin   the words of the sentence starting with token
+   * \param bufferEnd     the end of the words of the sentence
+   * \param tokensPopped  the number of additional words of the sentence that
+   * are used to match the term
+   * \return foundTerm
+   *
+   * Only as many words of the buffer as there are in the longest candidate
+   * alias are read, the cost does not depend on the length of the sentence.
+   * The aliases with more words than the buffer are skipped, tokensPopped
+   * never goes past bufferEnd.
+   */
+  Term findApproximateTerm(TokenView token,
+                           TokenViews::const_iterator bufferBegin,
+                           TokenViews::const_iterator bufferEnd,
+                           int& tokensPopped) const;
+
+  /**
+   * \brief findExactTerms finds the terms and aliases present as is in a
+   * sentence, case aside, in one left to right scan. The longest match wins
+   * and the matches do not overlap.
+   * \param begin         the first word of the sentence
+   * \param end           the end of the sentence
+   * \param matches       the matches are appended to this list, in order
+   */
+  void findExactTerms(TokenViews::const_iterator begin,
+                      TokenViews::const_iterator end,
+                      PhraseMatches& matches) const;
+
   /**
    * \brief findTerm      finds the term by the term id in the index
    * \param termId        the term id
@@ -101,9 +209,60 @@ class TermIndex {
 
   size_t index_size() const;
 
+  /**
+   * \brief compact       packs the staged terms into the immutable index.
+   * It is done lazily by the lookups but loaders should call it once all the
+   * terms are pushed.
+   */
+  void compact() const;
+
+  /**
+   * \brief Write the compacted index: the terms, the trigram index and the
+   * phrase trie.
+   */
+  void writeTo(BinaryWriter& writer) const;
+
+  /**
+   * \brief Restore an index written by writeTo, replacing the content. No
+   * term is pushed again, the arrays are read as they are or refer to the
+   * buffer of the reader when it gives its storage.
+   * Throws BinaryStreamException if the index is not consistent.
+   */
+  void readFrom(BinaryReader& reader);
+
  private:
-  TrigramIndex index;
-  std::unordered_map<int, Term> dictionary;
+  // A trigram and the id of its term, it becomes a posting in place when
+  // the index is compacted.
+  typedef TrigramIndex::Posting StagedTrigram;
+
+  void copyFrom(const TermIndex& that);
+  void pack() const;
+  void unpack();
+  bool findSlot(int termId, TrigramIndex::Slot& slot) const;
+  Term termAt(TrigramIndex::Slot slot) const;
+  std::string stringAt(uint32_t string) const;
+
+  // The terms and trigrams pushed since the last compaction.
+  mutable std::unordered_map<int, Term> dictionary;
+  mutable std::vector<StagedTrigram> stagedTrigrams;
+  mutable std::atomic<bool> compacted;
+  mutable std::mutex compactionMutex;
+
+  // The compacted terms sorted by term id, the position of a term is its slot
+  // in the trigram index. The strings of the term in slot s are the term, its
+  // lowercase form and its aliases, the range [termStringBegin[s],
+  // termStringBegin[s + 1]) of the strings. The string i is
+  // strings[stringBegin[i], stringBegin[i + 1]).
+  mutable PackedArray<int32_t> termIds;
+  mutable PackedArray<int32_t> entityIds;
+  mutable PackedArray<uint32_t> termStringBegin;
+  mutable PackedArray<uint32_t> stringBegin;
+  mutable PackedArray<char> strings;
+  mutable TrigramIndex index;
+
+  // The exact lowercase terms and aliases of the valid terms, by term id.
+  // Packed by compact() along with the trigram index.
+  mutable PhraseTrie phraseTrie;
 };
 }
 
@@ -0,0 +1,160 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef INTENT_TRIGRAMINDEX_HPP
+#define INTENT_TRIGRAMINDEX_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "intent/utils/PackedArray.hpp"
+
+namespace intent {
+class BinaryReader;
+class BinaryWriter;
+
+/**
+ * \brief Immutable inverted index from trigrams to term slots.
+ *
+ * Trigrams are encoded on 24 bits and kept sorted so that a lookup is a binary
+ * search. The posting list of each trigram is a sorted list of slots stored as
+ * varint encoded deltas. All the posting lists are stored contiguously in a
+ * single byte array (CSR layout) so that a lookup streams through memory.
+ *
+ * The arrays hold no pointer, an index read from a mapped snapshot refers to
+ * the mapping instead of copying it.
+ */
+class TrigramIndex {
+ public:
+  typedef uint32_t TrigramCode;
+  typedef uint32_t Slot;
+  typedef std::pair<TrigramCode, Slot> Posting;
+  typedef std::vector<Posting> Postings;
+
+  /**
+   * \brief Encode a trigram on 24 bits.
+   * \param trigram   The trigram to encode.
+   * \param code      The code of the trigram.
+   * \return false if the input is not made of three characters.
+   */
+  static bool encode(const std::string& trigram, TrigramCode& code);
+
+  /**
+   * \brief Build the index from a list of postings, replacing the previous
+   * content. The postings are sorted and deduplicated in place.
+   */
+  void build(Postings& postings);
+
+  /**
+   * \brief Append all the postings of the index to a list.
+   */
+  void decode(Postings& postings) const;
+
+  /**
+   * \brief Call visitor with each slot of the posting list of a trigram, in
+   * increasing order.
+   * \return false if the trigram is not in the index.
+   */
+  template <typename Visitor>
+  bool visitPostings(TrigramCode code, Visitor visitor) const {
+    PackedArray<TrigramCode>::const_iterator it =
+        std::lower_bound(m_codes.begin(), m_codes.end(), code);
+    if (it == m_codes.end() || *it != code) return false;
+
+    size_t i = it - m_codes.begin();
+    const uint8_t* posting = m_postings.data() + m_offsets[i];
+    const uint8_t* postingEnd = m_postings.data() + m_offsets[i + 1];
+
+    Slot slot = 0;
+    while (posting != postingEnd) {
+      slot += readVarint(posting);
+      visitor(slot);
+    }
+    return true;
+  }
+
+  /**
+   * \brief The number of distinct trigrams in the index.
+   */
+  size_t size() const { return m_codes.size(); }
+
+  /**
+   * \brief The number of bytes owned by the index, a mapped index owns none.
+   */
+  size_t memoryUsage() const;
+
+  /**
+   * \brief Write the arrays of the index as they are.
+   */
+  void writeTo(BinaryWriter& writer) const;
+
+  /**
+   * \brief Restore the arrays written by writeTo, replacing the content. They
+   * refer to the buffer of the reader when it gives its storage.
+   * Throws BinaryStreamException if they are not consistent.
+   */
+  void readFrom(BinaryReader& reader);
+
+ private:
+  static Slot readVarint(const uint8_t*& data) {
+    Slot value = 0;
+    int shift = 0;
+    uint8_t byte;
+    do {
+      byte = *data++;
+      value |= static_cast<Slot>(byte & 0x7F) << shift;
+      shift += 7;
+    } while (byte & 0x80);
+    return value;
+  }
+
+  static void writeVarint(Slot value, std::vector<uint8_t>& out);
+
+  PackedArray<TrigramCode> m_codes;
+  // The posting list of m_codes[i] is m_postings[m_offsets[i], m_offsets[i+1])
+  PackedArray<uint32_t> m_offsets;
+  PackedArray<uint8_t> m_postings;
+};
+}
+
+#endif  // INTENT_TRIGRAMINDEX_HPP
@@ -45,6 +45,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "intent/utils/Graph.hpp"
 
+#include <cstdint>
+#include <limits>
 #include <unordered_set>
 #include <memory>
 
@@ -79,6 +81,17 @@ class IntentStoryModel {
   typedef std::unordered_set<IndexType> StateIdSet;
   typedef std::shared_ptr<IntentStoryModel> SharedPtr;
 
+  /**
+   * \brief A dense handle on a state: the index of its vertex in the graph.
+   */
+  typedef uint32_t StateHandle;
+
+  /**
+   * \brief The handle of a state that is not in the graph.
+   */
+  static constexpr StateHandle NO_STATE =
+      std::numeric_limits<StateHandle>::max();
+
   /**
    * \brief The root state ID.
    */
@@ -43,6 +43,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "intent/intent_service/IntentService.hpp"
 
+#include <boost/optional.hpp>
+
 #include "intent/intent_service/DictionaryModel.hpp"
 #include "intent/intent_service/IntentService.hpp"
 #include "IntentStoryModel.hpp"
@@ -59,16 +61,23 @@ class IntentStoryService : protected IntentService {
   typedef IntentMatcher::EntityMatch EntityMatch;
   typedef IntentMatcher::EntityMatches EntityMatches;
 
+  typedef IntentStoryModel::StateHandle StateHandle;
+
   /**
    * \brief The result of one transition of the finite state automaton after
    * evaluating a single user intent.
    */
   struct Result {
-    Result() : found(true) {}
+    Result() : found(true), nextState(IntentStoryModel::NO_STATE) {}
 
     bool found;
     std::string actionId;
+
+    /**
+     * \brief Only filled when evaluating from a state ID.
+     */
     std::string nextStateId;
+    StateHandle nextState;
     Intent intent;
 
     bool operator==(const Result& that) const {
@@ -80,7 +89,9 @@ class IntentStoryService : protected IntentService {
 
   /**
    * \param intentStoryServiceModel   The intent story service data model
-   * containing the finite state automaton.
+   * containing the finite state automaton. Its story graph must be frozen,
+   * as the deserializer, the interpreter and the snapshots leave it, otherwise
+   * GraphException is thrown.
    */
   IntentStoryService(const IntentStoryServiceModel& intentStoryServiceModel);
 
@@ -92,7 +103,28 @@ class IntentStoryService : protected IntentService {
    * \param message   The user intent.
    * \return The result of the intent matching.
    */
-  Result evaluate(const std::string& stateId, const std::string& message) const;
+  Result evaluate(const std::string& stateId, boost::string_ref message) const;
+
+  /**
+   * \brief Evaluate a user intent from the state with the given handle. The
+   * next state is only returned as a handle.
+   */
+  Result evaluate(StateHandle state, boost::string_ref message) const;
+
+  /**
+   * \brief Returns the handle of a state, or NO_STATE if it does not exist.
+   */
+  StateHandle findState(const std::string& stateId) const;
+
+  /**
+   * \brief Returns the ID of a state, or an empty string for NO_STATE.
+   */
+  const std::string& getStateId(StateHandle state) const;
+
+  /**
+   * \brief Returns the handle of the root state.
+   */
+  inline StateHandle getRootState() const { return m_rootState; }
 
   inline IntentStoryServiceModel getIntentStoryServiceModel() const {
     IntentStoryServiceModel intentStoryServiceModel;
@@ -102,7 +134,37 @@ class IntentStoryService : protected IntentService {
   }
 
  private:
+  /**
+   * \brief The transitions going out of a state. They never change once the
+   * model is loaded so they are computed at construction.
+   */
+  struct StateTransitions {
+    /**
+     * \brief The sorted intents that can be matched from the state.
+     */
+    IntentAutomaton::IntentRefs allowedIntents;
+
+    /**
+     * \brief The edge to follow for each allowed intent, in the same order.
+     */
+    std::vector<IntentStoryModel::StoryGraph::Edge> edges;
+
+    /**
+     * \brief The edge to follow when no intent is matching.
+     */
+    boost::optional<IntentStoryModel::StoryGraph::Edge> fallbackEdge;
+  };
+
+  void buildStateTransitions();
+
   IntentStoryModel::SharedPtr m_intentStoryModel;
+
+  StateHandle m_rootState;
+
+  /**
+   * \brief The transitions of each state indexed by vertex.
+   */
+  std::vector<StateTransitions> m_transitionsByVertex;
 };
 
 std::ostream& operator<<(std::ostream& os,
@@ -44,6 +44,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "intent/interpreter/Interpreter.hpp"
 #include "intent/intent_story_service/IntentStoryModel.hpp"
 #include "intent/intent_service/DictionaryModel.hpp"
+#include "intent/interpreter/SentenceToIntentTranslator.hpp"
 
 namespace intent {
 
@@ -59,21 +60,39 @@ class EdgeParser {
   EdgeParser(const DictionaryModel& dictionaryModel, int vertexCounter,
              int anonymousActionCounter,
              InterpreterFeedback& interpreterFeedback)
-      : m_dictionaryModel(dictionaryModel),
+      : m_translator(
+            std::make_shared<SentenceToIntentTranslator>(dictionaryModel)),
+        m_vertexCounter(vertexCounter),
+        m_anonymousActionCounter(anonymousActionCounter),
+        m_interpreterFeedback(interpreterFeedback) {}
+
+  /**
+   * \brief Parse the edges with a translator shared with other parsers, so
+   * that the sentences of a whole script are translated once.
+   */
+  EdgeParser(SentenceToIntentTranslator::SharedPtr translator,
+             int vertexCounter, int anonymousActionCounter,
+             InterpreterFeedback& interpreterFeedback)
+      : m_translator(translator),
         m_vertexCounter(vertexCounter),
         m_anonymousActionCounter(anonymousActionCounter),
         m_interpreterFeedback(interpreterFeedback) {}
 
   EdgeDefinition parse(const Scenario& scenario,
-                       const InquiryToReply& inquiryToReply,
+                       const InquiryToReplies::value_type& inquiryToReply,
                        std::unique_ptr<std::string>& previousStateInScenario);
 
+  /**
+   * \brief Build the fallback edge of an inquiry from its parsed edge.
+   * \return The fallback edge or null if the inquiry has no fallback reply.
+   */
   std::unique_ptr<EdgeDefinition> parseFallback(
-      const Scenario& scenario, const InquiryToReply& inquiryToReply,
-      std::unique_ptr<std::string>& previousStateInScenario);
+      const Scenario& scenario,
+      const InquiryToReplies::value_type& inquiryToReply,
+      const EdgeDefinition& edge) const;
 
  private:
-  const DictionaryModel& m_dictionaryModel;
+  SentenceToIntentTranslator::SharedPtr m_translator;
   int m_vertexCounter;
   int m_anonymousActionCounter;
   InterpreterFeedback& m_interpreterFeedback;
@@ -42,7 +42,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #define INTENT_INTERPRETER_HPP
 
 #include "intent/chatbot/ChatbotModel.hpp"
+#include "intent/utils/ThreadPool.hpp"
 
+#include <istream>
 #include <string>
 #include <vector>
 
@@ -111,6 +113,8 @@ typedef std::map<LineRange, LineRange> InquiryToReplies;
 
 const std::string REGEX_MARKERS = "[]|*";
 
+class InterpreterCache;
+
 /**
  * \brief Interpreter the OpenIntent chatbot language.
  */
@@ -124,6 +128,57 @@ class Interpreter {
   static ChatbotModel build(const std::string& script,
                             DictionaryModel::SharedPtr dictionaryModel,
                             InterpreterFeedback& m_interpreterFeedback);
+
+  /**
+   * \brief build a ChatbotModel from a script, compiling the scenarios in
+   * parallel against the shared dictionary. They are merged in the order of
+   * the script: the model and the feedback are the same as the ones of the
+   * serial build.
+   * \param threadPool The pool compiling the scenarios.
+   * \return The ChatbotModel.
+   */
+  static ChatbotModel build(const std::string& script,
+                            DictionaryModel::SharedPtr dictionaryModel,
+                            InterpreterFeedback& interpreterFeedback,
+                            ThreadPool& threadPool);
+
+  /**
+   * \brief build a ChatbotModel from a script, reusing the scenarios compiled
+   * by the previous build with the same cache. Only the edited scenarios are
+   * compiled again: the model and the feedback are the same as the ones of a
+   * full build.
+   * \param cache The scenarios compiled by the previous build, updated with
+   * the ones of this build.
+   * \return The ChatbotModel.
+   */
+  static ChatbotModel build(const std::string& script,
+                            DictionaryModel::SharedPtr dictionaryModel,
+                            InterpreterFeedback& interpreterFeedback,
+                            InterpreterCache& cache);
+
+  /**
+   * \brief build a ChatbotModel from a script read line by line. Every
+   * scenario is compiled as soon as it is read so only the scenario being read
+   * is held in memory.
+   * \param script The stream of the script.
+   * \return The ChatbotModel.
+   */
+  static ChatbotModel build(std::istream& script,
+                            DictionaryModel::SharedPtr dictionaryModel,
+                            InterpreterFeedback& interpreterFeedback);
+
+  /**
+   * \brief build a ChatbotModel from a script read line by line, reusing the
+   * scenarios compiled by the previous build with the same cache.
+   * \param script The stream of the script.
+   * \param cache The scenarios compiled by the previous build, updated with
+   * the ones of this build.
+   * \return The ChatbotModel.
+   */
+  static ChatbotModel build(std::istream& script,
+                            DictionaryModel::SharedPtr dictionaryModel,
+                            InterpreterFeedback& interpreterFeedback,
+                            InterpreterCache& cache);
 };
 }
 
@@ -0,0 +1,138 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef INTENT_INTERPRETER_CACHE_HPP
+#define INTENT_INTERPRETER_CACHE_HPP
+
+#include "intent/interpreter/EdgeParser.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+
+namespace intent {
+/**
+ * \brief The contribution of a scenario to the model.
+ *
+ * It only depends on the scenario and the dictionary: the anonymous states and
+ * actions are numbered from the counters given to the scenario. The scenarios
+ * can therefore be compiled in any order, or concurrently, and merged in the
+ * order of the script.
+ */
+struct CompiledScenario {
+  typedef std::shared_ptr<const CompiledScenario> SharedPtr;
+  typedef std::vector<std::pair<IntentModel::IndexType, IntentModel::Intent>>
+      Intents;
+
+  Intents intents;
+  std::vector<EdgeDefinition> edges;
+  InterpreterFeedback feedback;
+};
+
+/**
+ * \brief The scenarios compiled by a build of a script, reused by the next
+ * build of the same script after some scenarios have been edited.
+ *
+ * A scenario is reused when its lines and the dictionary are the same. The
+ * dictionary is recognized by its content, or by its address when it is the
+ * one of the last build: it must not be modified between builds. The feedback
+ * of a scenario moved in the script is shifted to its new lines. The cache
+ * only keeps the scenarios of the last build. It is not thread-safe.
+ */
+class InterpreterCache {
+ public:
+  InterpreterCache();
+
+  /**
+   * \brief Forget the compiled scenarios.
+   */
+  void clear();
+
+  /**
+   * \return The number of compiled scenarios in the cache.
+   */
+  size_t size() const;
+
+  /**
+   * \brief Start a build with a dictionary. The scenarios compiled against
+   * another dictionary are forgotten.
+   */
+  void beginBuild(DictionaryModel::SharedPtr dictionaryModel);
+
+  /**
+   * \brief Find the compilation of a scenario and keep it for the next build.
+   * \param positionShift Set to the shift of the lines of the scenario since
+   * it was compiled.
+   * \return The compiled scenario or null if the scenario must be compiled.
+   */
+  CompiledScenario::SharedPtr find(const Scenario& scenario,
+                                   int& positionShift);
+
+  /**
+   * \brief Keep the compilation of a scenario for the next build.
+   */
+  void insert(const Scenario& scenario,
+              CompiledScenario::SharedPtr compiledScenario);
+
+  /**
+   * \brief Forget the scenarios that were not part of the build.
+   */
+  void endBuild();
+
+ private:
+  struct Entry {
+    Scenario scenario;
+    CompiledScenario::SharedPtr compiledScenario;
+  };
+  typedef std::unordered_multimap<uint64_t, Entry> Entries;
+
+  static Entries::const_iterator findEntry(const Entries& entries,
+                                           uint64_t hash,
+                                           const Scenario& scenario);
+
+  Entries m_entries;
+  Entries m_nextEntries;
+
+  std::weak_ptr<const DictionaryModel> m_dictionaryModel;
+  uint64_t m_dictionaryHash;
+};
+}
+
+#endif
@@ -43,8 +43,46 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "intent/interpreter/Interpreter.hpp"
 
+#include <boost/utility/string_ref.hpp>
+
+#include <istream>
+
 namespace intent {
 
+/**
+ * \brief Read the scenarios of a script line by line.
+ *
+ * A scenario is handed over as soon as its closing brace is read, so only the
+ * scenario being read is held in memory. The lines are trimmed and numbered
+ * as by extractScenarios.
+ */
+class ScenarioReader {
+ public:
+  /**
+   * \param script The stream of the script. It must outlive the reader.
+   */
+  explicit ScenarioReader(std::istream& script);
+
+  /**
+   * \param script The script. It must outlive the reader.
+   */
+  explicit ScenarioReader(boost::string_ref script);
+
+  /**
+   * \brief Read the next scenario.
+   * \return false at the end of the script.
+   */
+  bool next(Scenario& scenario);
+
+ private:
+  bool nextLine(std::string& line);
+
+  std::istream* m_stream;
+  boost::string_ref m_script;
+  unsigned int m_position;
+  int m_braceCounter;
+};
+
 void indexScenario(const Scenario& scenario,
                    InquiryToReplies& inquiryToReplies);
 
@@ -45,6 +45,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 namespace intent {
 
+void trimComments(Scenario& scenario);
+
 void trimComments(Scenarios& scenarios);
 }
 
@@ -43,15 +43,27 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "Interpreter.hpp"
 
+#include "intent/intent_service/SentenceTokenizer.hpp"
+
+#include <mutex>
+#include <unordered_map>
+
 namespace intent {
 /**
  * \brief Translator transforming sentences into intents by implicitly matching
  * entities.
+ *
+ * An instance memoizes the translations of a script: sentences made of the
+ * same tokens, like the ones repeated across scenarios, are translated once.
+ * It can be shared by the threads compiling the scenarios.
  */
 class SentenceToIntentTranslator {
  public:
   typedef IntentModel::IndexType IndexType;
   typedef IntentModel::Intent Intent;
+  typedef std::shared_ptr<SentenceToIntentTranslator> SharedPtr;
+
+  SentenceToIntentTranslator(const DictionaryModel& dictionaryModel);
 
   /**
    * \brief this method extracts entities from a sentence and returns a
@@ -65,6 +77,19 @@ class SentenceToIntentTranslator {
 
   static std::pair<IndexType, Intent> translate(
       const std::string& sentence, const DictionaryModel& dictionaryModel);
+
+  /**
+   * \brief Translate a sentence, reusing the translation of a previous
+   * sentence made of the same tokens.
+   */
+  std::pair<IndexType, Intent> translate(const std::string& sentence);
+
+ private:
+  const DictionaryModel& m_dictionaryModel;
+  SentenceTokenizer m_sentenceTokenizer;
+
+  std::mutex m_mutex;
+  std::unordered_map<std::string, Intent> m_intentsByTokens;
 };
 }
 
@@ -0,0 +1,147 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef INTENT_ASYNCLOGSINK_HPP
+#define INTENT_ASYNCLOGSINK_HPP
+
+#include "intent/utils/BoundedQueue.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace intent {
+namespace log {
+/**
+ * \brief Sink handing the log messages over to a background thread.
+ *
+ * The messages are pushed into a bounded lock-free queue and written by a
+ * flusher thread, so that a thread logging never waits for the output. What
+ * happens when the queue is full is chosen by the overflow policy.
+ */
+class AsyncLogSink {
+ public:
+  /**
+   * \brief What to do with a message pushed into a full queue.
+   */
+  struct OverflowPolicy {
+    enum type {
+      BLOCK,        // wait for the flusher to make room.
+      DROP_OLDEST,  // discard the oldest queued message.
+      DROP_NEWEST   // discard the message being pushed.
+    };
+  };
+
+  /**
+   * \brief Write a message to the actual output, called by the flusher only.
+   */
+  typedef std::function<void(int severityLevel, const std::string& message)>
+      Writer;
+
+  /**
+   * \param capacity        The maximum number of queued messages.
+   * \param overflowPolicy  What to do when the queue is full.
+   * \param writer          The function writing the messages.
+   */
+  AsyncLogSink(size_t capacity, OverflowPolicy::type overflowPolicy,
+               Writer writer);
+
+  /**
+   * \brief Write the queued messages and join the flusher thread. No message
+   * must be pushed concurrently.
+   */
+  ~AsyncLogSink();
+
+  AsyncLogSink(const AsyncLogSink&) = delete;
+  AsyncLogSink& operator=(const AsyncLogSink&) = delete;
+
+  /**
+   * \brief Queue a message to be written by the flusher thread.
+   */
+  void push(int severityLevel, std::string message);
+
+  /**
+   * \brief Wait until the messages pushed so far have been written or
+   * dropped.
+   */
+  void flush();
+
+  /**
+   * \brief The number of messages discarded because the queue was full.
+   */
+  size_t droppedMessages() const {
+    return m_droppedMessages.load(std::memory_order_relaxed);
+  }
+
+  size_t capacity() const { return m_queue.capacity(); }
+
+ private:
+  struct Entry {
+    int severityLevel;
+    std::string message;
+  };
+
+  void run();
+  void write(Entry& entry);
+  void wakeFlusher();
+
+  BoundedQueue<Entry> m_queue;
+  OverflowPolicy::type m_overflowPolicy;
+  Writer m_writer;
+
+  std::atomic<size_t> m_pushedMessages;
+  // The messages written or dropped once queued.
+  std::atomic<size_t> m_consumedMessages;
+  std::atomic<size_t> m_droppedMessages;
+
+  std::atomic<bool> m_flusherWaiting;
+  std::mutex m_wakeMutex;
+  std::condition_variable m_wake;
+  bool m_stopping;
+  std::thread m_flusher;
+};
+}
+}
+
+#endif  // INTENT_ASYNCLOGSINK_HPP
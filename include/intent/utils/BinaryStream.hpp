@@ -0,0 +1,200 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef INTENT_BINARYSTREAM_HPP
+#define INTENT_BINARYSTREAM_HPP
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "intent/utils/Exception.hpp"
+#include "intent/utils/PackedArray.hpp"
+
+namespace intent {
+/**
+ * \brief Exception thrown when reading past the end of a binary buffer.
+ */
+class BinaryStreamException : public Exception {
+ public:
+  BinaryStreamException(const std::string& error) : Exception(error) {}
+};
+
+/**
+ * \brief Write values in their native binary representation to a stream.
+ *
+ * The sizes of the strings and arrays are written on 64 bits before their
+ * content, the arrays of trivially copyable values are written in one block.
+ * The content of the packed arrays is aligned on PACKED_ALIGNMENT bytes from
+ * the start of the stream so that it can be read in place.
+ */
+class BinaryWriter {
+ public:
+  static const size_t PACKED_ALIGNMENT = 8;
+
+  explicit BinaryWriter(std::ostream& os) : m_os(os), m_position(0) {}
+
+  template <typename T>
+  void write(T value) {
+    static_assert(std::is_arithmetic<T>::value, "Arithmetic type expected");
+    writeBytes(&value, sizeof(value));
+  }
+
+  void writeString(const std::string& value) {
+    write<uint64_t>(value.size());
+    writeBytes(value.data(), value.size());
+  }
+
+  template <typename T>
+  void writeArray(const std::vector<T>& values) {
+    static_assert(std::is_arithmetic<T>::value, "Arithmetic type expected");
+    write<uint64_t>(values.size());
+    writeBytes(values.data(), values.size() * sizeof(T));
+  }
+
+  template <typename T>
+  void writeArray(const PackedArray<T>& values) {
+    static_assert(std::is_arithmetic<T>::value, "Arithmetic type expected");
+    write<uint64_t>(values.size());
+    static const char padding[PACKED_ALIGNMENT] = {0};
+    writeBytes(padding, (PACKED_ALIGNMENT - m_position % PACKED_ALIGNMENT) %
+                            PACKED_ALIGNMENT);
+    writeBytes(values.data(), values.size() * sizeof(T));
+  }
+
+  void writeBytes(const void* data, size_t size) {
+    m_os.write(static_cast<const char*>(data), size);
+    m_position += size;
+  }
+
+ private:
+  std::ostream& m_os;
+  size_t m_position;
+};
+
+/**
+ * \brief Read the values written by a BinaryWriter from a buffer, checking
+ * that no read goes past its end.
+ *
+ * When the storage owning the buffer is given, the packed arrays refer to the
+ * buffer instead of copying it and keep the storage alive.
+ */
+class BinaryReader {
+ public:
+  BinaryReader(const char* data, size_t size,
+               const std::shared_ptr<const void>& storage =
+                   std::shared_ptr<const void>())
+      : m_begin(data), m_data(data), m_end(data + size), m_storage(storage) {}
+
+  template <typename T>
+  T read() {
+    static_assert(std::is_arithmetic<T>::value, "Arithmetic type expected");
+    T value;
+    std::memcpy(&value, take(sizeof(value)), sizeof(value));
+    return value;
+  }
+
+  void readString(std::string& value) {
+    size_t size = readSize(1);
+    value.assign(take(size), size);
+  }
+
+  template <typename T>
+  void readArray(std::vector<T>& values) {
+    static_assert(std::is_arithmetic<T>::value, "Arithmetic type expected");
+    size_t size = readSize(sizeof(T));
+    values.resize(size);
+    if (size > 0)
+      std::memcpy(values.data(), take(size * sizeof(T)), size * sizeof(T));
+  }
+
+  template <typename T>
+  void readArray(PackedArray<T>& values) {
+    static_assert(std::is_arithmetic<T>::value, "Arithmetic type expected");
+    size_t size = readSize(0);
+    size_t alignment = BinaryWriter::PACKED_ALIGNMENT;
+    take((alignment - (m_data - m_begin) % alignment) % alignment);
+    if (size > remaining() / sizeof(T))
+      throw BinaryStreamException("Size larger than the buffer");
+
+    const char* data = take(size * sizeof(T));
+    if (m_storage && reinterpret_cast<uintptr_t>(data) % alignof(T) == 0) {
+      values.attach(reinterpret_cast<const T*>(data), size, m_storage);
+    } else {
+      std::vector<T> copy(size);
+      if (size > 0) std::memcpy(copy.data(), data, size * sizeof(T));
+      values.assign(std::move(copy));
+    }
+  }
+
+  /**
+   * \brief Read a number of elements, checking that the remaining bytes can
+   * hold that many elements of the given size.
+   */
+  size_t readSize(size_t elementSize) {
+    uint64_t size = read<uint64_t>();
+    if (elementSize > 0 && size > remaining() / elementSize)
+      throw BinaryStreamException("Size larger than the buffer");
+    return static_cast<size_t>(size);
+  }
+
+  size_t remaining() const { return m_end - m_data; }
+
+ private:
+  const char* take(size_t size) {
+    if (size > remaining())
+      throw BinaryStreamException("Unexpected end of buffer");
+    const char* data = m_data;
+    m_data += size;
+    return data;
+  }
+
+  const char* m_begin;
+  const char* m_data;
+  const char* m_end;
+  std::shared_ptr<const void> m_storage;
+};
+}
+
+#endif  // INTENT_BINARYSTREAM_HPP
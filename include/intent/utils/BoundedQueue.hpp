@@ -0,0 +1,145 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef INTENT_BOUNDEDQUEUE_HPP
+#define INTENT_BOUNDEDQUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace intent {
+/**
+ * \brief Bounded lock-free queue for several producers and consumers.
+ *
+ * The values are stored in a ring of cells whose sequence numbers tell the
+ * producers and the consumers whether a cell is free or filled, so that
+ * neither of them ever takes a lock (Vyukov's bounded MPMC queue).
+ */
+template <typename T>
+class BoundedQueue {
+ public:
+  /**
+   * \param capacity  The maximum number of values, rounded up to a power of
+   * two.
+   */
+  explicit BoundedQueue(size_t capacity) : m_enqueuePos(0), m_dequeuePos(0) {
+    size_t size = 2;
+    while (size < capacity) size *= 2;
+    m_mask = size - 1;
+    m_cells.reset(new Cell[size]);
+    for (size_t i = 0; i < size; ++i)
+      m_cells[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  BoundedQueue(const BoundedQueue&) = delete;
+  BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+  /**
+   * \return false if the queue is full, value is left untouched then.
+   */
+  bool tryPush(T& value) {
+    size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell& cell = m_cells[pos & m_mask];
+      size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      intptr_t difference =
+          static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+      if (difference == 0) {
+        if (m_enqueuePos.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          cell.value = std::move(value);
+          cell.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (difference < 0) {
+        return false;
+      } else {
+        pos = m_enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  /**
+   * \return false if the queue is empty.
+   */
+  bool tryPop(T& value) {
+    size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+    for (;;) {
+      Cell& cell = m_cells[pos & m_mask];
+      size_t sequence = cell.sequence.load(std::memory_order_acquire);
+      intptr_t difference =
+          static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+      if (difference == 0) {
+        if (m_dequeuePos.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          value = std::move(cell.value);
+          cell.sequence.store(pos + m_mask + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (difference < 0) {
+        return false;
+      } else {
+        pos = m_dequeuePos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  size_t capacity() const { return m_mask + 1; }
+
+ private:
+  struct Cell {
+    std::atomic<size_t> sequence;
+    T value;
+  };
+
+  std::unique_ptr<Cell[]> m_cells;
+  size_t m_mask;
+  // The positions are written by different threads, the padding keeps them
+  // on separate cache lines.
+  std::atomic<size_t> m_enqueuePos;
+  char m_padding[64];
+  std::atomic<size_t> m_dequeuePos;
+};
+}
+
+#endif  // INTENT_BOUNDEDQUEUE_HPP
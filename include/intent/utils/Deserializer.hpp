@@ -64,6 +64,11 @@ class Deserializer {
 
   /**
    * \brief Deserialize the datamodel given as template parameter from istream
+   *
+   * The stream is parsed on the fly by a JsonReader and the models are built
+   * from its events, no JSON document is built. The ids follow the sorted
+   * keys, whatever their order in the stream. The entities cannot be given
+   * again once intents have been read after them.
    */
   template <class T>
   T deserialize(std::istream& is) {
@@ -71,7 +76,8 @@ class Deserializer {
   }
 
   /**
-   * Deserialize the datamodel given as template parameter from a JSON object
+   * Deserialize the datamodel given as template parameter from a JSON object,
+   * the object is dumped and read like a stream.
    */
   template <class T>
   T deserialize(const nlohmann::json& input) {
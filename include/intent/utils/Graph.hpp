@@ -41,25 +41,35 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #ifndef INTENT_GRAPH_HPP
 #define INTENT_GRAPH_HPP
 
-#include "boost/graph/adjacency_list.hpp"
-#include <boost/graph/directed_graph.hpp>
+#include <cstddef>
+#include <iterator>
+#include <ostream>
+#include <vector>
 
 #include "intent/utils/Exception.hpp"
 
 namespace intent {
 /**
- * \brief Representation of a graph using adjacency list with additional
- * information on the vertices and edges.
+ * \brief Representation of a directed graph with additional information on
+ * the vertices and edges.
+ *
+ * The graph is built by adding vertices and edges, then frozen into a
+ * compressed sparse row layout: the edges going out of a vertex are stored
+ * contiguously, in the order they were added, and found through the offsets
+ * of the vertices. Walking the edges of a frozen graph allocates nothing.
  */
 template <class VertexInfo, class EdgeInfo>
 class Graph {
  public:
-  typedef
-      typename boost::adjacency_list<boost::vecS, boost::vecS, boost::directedS,
-                                     VertexInfo, EdgeInfo> _Graph;
+  typedef std::size_t VertexIndex;
+  typedef std::size_t EdgeIndex;
 
-  using _Vertex = typename _Graph::vertex_descriptor;
-  using _Edge = typename _Graph::edge_descriptor;
+ private:
+  struct EdgeRecord {
+    VertexIndex source;
+    VertexIndex target;
+    EdgeInfo info;
+  };
 
  public:
   /**
@@ -69,52 +79,139 @@ class Graph {
    public:
     Vertex() : m_graph(NULL), m_vertex() {}
 
-    Vertex(const _Graph& graph, const _Vertex& vertex)
+    Vertex(const Graph& graph, VertexIndex vertex)
         : m_graph(&graph), m_vertex(vertex) {}
 
-    Vertex(const Vertex& that)
-        : m_graph(that.m_graph), m_vertex(that.m_vertex) {}
+    inline VertexIndex getVertex() const { return m_vertex; }
 
-    inline _Vertex getVertex() const { return m_vertex; }
-
-    inline const VertexInfo& getInfo() const { return (*m_graph)[m_vertex]; }
+    inline const VertexInfo& getInfo() const {
+      return m_graph->m_vertices[m_vertex];
+    }
 
    private:
-    const _Graph* m_graph;
-    _Vertex m_vertex;
+    const Graph* m_graph;
+    VertexIndex m_vertex;
   };
 
   /**
    * \brief Representation of an edge from which information can be extracted.
+   * The edges returned before the graph is frozen are invalidated by freeze.
    */
   class Edge {
    public:
     Edge() : m_graph(NULL), m_edge() {}
 
-    Edge(const _Graph& graph, const _Edge& edge)
-        : m_graph(&graph), m_edge(edge) {}
+    Edge(const Graph& graph, EdgeIndex edge) : m_graph(&graph), m_edge(edge) {}
 
-    Edge(const Edge& that) : m_graph(that.m_graph), m_edge(that.m_edge) {}
+    inline EdgeIndex getEdge() const { return m_edge; }
 
-    inline _Edge getEdge() const { return m_edge; }
-
-    inline const EdgeInfo& getInfo() const { return (*m_graph)[m_edge]; }
+    inline const EdgeInfo& getInfo() const {
+      return m_graph->m_edges[m_edge].info;
+    }
 
     inline Vertex getSource() const {
-      return Vertex(*m_graph, boost::source(m_edge, *m_graph));
+      return Vertex(*m_graph, m_graph->m_edges[m_edge].source);
     }
 
     inline Vertex getTarget() const {
-      return Vertex(*m_graph, boost::target(m_edge, *m_graph));
+      return Vertex(*m_graph, m_graph->m_edges[m_edge].target);
     }
 
    private:
-    const _Graph* m_graph;
-    _Edge m_edge;
+    const Graph* m_graph;
+    EdgeIndex m_edge;
   };
 
-  using Vertices = std::vector<Vertex>;
-  using Edges = std::vector<Edge>;
+  /**
+   * \brief The contiguous range of the edges going out of a vertex.
+   */
+  class Edges {
+   public:
+    typedef Edge value_type;
+    typedef Edge reference;
+    typedef Edge const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    class const_iterator
+        : public std::iterator<std::random_access_iterator_tag, Edge,
+                               std::ptrdiff_t, const Edge*, Edge> {
+     public:
+      const_iterator() : m_graph(NULL), m_edge() {}
+      const_iterator(const Graph& graph, EdgeIndex edge)
+          : m_graph(&graph), m_edge(edge) {}
+
+      Edge operator*() const { return Edge(*m_graph, m_edge); }
+      Edge operator[](std::ptrdiff_t n) const {
+        return Edge(*m_graph, m_edge + n);
+      }
+
+      const_iterator& operator++() {
+        ++m_edge;
+        return *this;
+      }
+      const_iterator operator++(int) {
+        const_iterator it(*this);
+        ++m_edge;
+        return it;
+      }
+      const_iterator& operator--() {
+        --m_edge;
+        return *this;
+      }
+      const_iterator operator--(int) {
+        const_iterator it(*this);
+        --m_edge;
+        return it;
+      }
+      const_iterator& operator+=(std::ptrdiff_t n) {
+        m_edge += n;
+        return *this;
+      }
+      const_iterator& operator-=(std::ptrdiff_t n) {
+        m_edge -= n;
+        return *this;
+      }
+      const_iterator operator+(std::ptrdiff_t n) const {
+        return const_iterator(*m_graph, m_edge + n);
+      }
+      const_iterator operator-(std::ptrdiff_t n) const {
+        return const_iterator(*m_graph, m_edge - n);
+      }
+      std::ptrdiff_t operator-(const const_iterator& that) const {
+        return static_cast<std::ptrdiff_t>(m_edge) -
+               static_cast<std::ptrdiff_t>(that.m_edge);
+      }
+
+      bool operator==(const const_iterator& that) const {
+        return m_edge == that.m_edge;
+      }
+      bool operator!=(const const_iterator& that) const {
+        return m_edge != that.m_edge;
+      }
+      bool operator<(const const_iterator& that) const {
+        return m_edge < that.m_edge;
+      }
+
+     private:
+      const Graph* m_graph;
+      EdgeIndex m_edge;
+    };
+    typedef const_iterator iterator;
+
+    Edges(const Graph& graph, EdgeIndex begin, EdgeIndex end)
+        : m_begin(graph, begin), m_end(graph, end) {}
+
+    const_iterator begin() const { return m_begin; }
+    const_iterator end() const { return m_end; }
+    std::size_t size() const { return m_end - m_begin; }
+    bool empty() const { return m_begin == m_end; }
+    Edge operator[](std::size_t n) const { return m_begin[n]; }
+
+   private:
+    const_iterator m_begin;
+    const_iterator m_end;
+  };
 
   Graph();
 
@@ -126,7 +223,8 @@ class Graph {
   Vertex addVertex(const VertexInfo& vertexInfo);
 
   /**
-   * \brief Add an edge to the graph with some information attached to it.
+   * \brief Add an edge to the graph with some information attached to it. The
+   * graph must be frozen again before walking its edges.
    * \param source    The source vertex. (this is a directed graph).
    * \param target    The target vertex. (this is a directed graph).
    * \return  The edge.
@@ -135,26 +233,45 @@ class Graph {
                const EdgeInfo& edgeInfo);
 
   /**
-   * \brief Returns a list of neighboor edges.
+   * \brief Store the edges in the compressed sparse row layout. It is done
+   * once the graph is built.
+   */
+  void freeze();
+
+  /**
+   * \return true if no edge was added since the last freeze.
+   */
+  bool isFrozen() const { return m_frozen; }
+
+  /**
+   * \brief Returns the range of the neighboor edges, in the order they were
+   * added. Throws GraphException if the graph is not frozen.
    * \param v     The vertex from which to get the neighboors.
    * \return The neighboor edges.
    */
   Edges nextEdges(const Vertex& v) const;
 
+  /**
+   * \brief Returns a vertex by its index, the vertices being numbered from 0
+   * in the order they were added.
+   */
+  Vertex vertexAt(std::size_t index) const { return Vertex(*this, index); }
+
   /**
    * \brief Returns the number of vertices in the graph.
    * \return  The number of vertices.
    */
-  std::size_t vertexCount() const { return boost::num_vertices(m_graph); }
+  std::size_t vertexCount() const { return m_vertices.size(); }
 
   /**
    * \brief Returns the number of edges in the graph.
    * \return The number of edges.
    */
-  std::size_t edgeCount() const { return boost::num_edges(m_graph); }
+  std::size_t edgeCount() const { return m_edges.size(); }
 
   /**
-   * \brief Dumps the graph
+   * \brief Dumps the graph in the graphviz format. Throws GraphException if
+   * the graph is not frozen.
    * \param ostream   The stream to dump the graph to.
    * \param vertexWriterMaker The vertex writer factory that creates the vertex
    * serializer.
@@ -163,7 +280,20 @@ class Graph {
   void dump(std::ostream& ostream, VertexWriterMaker& vertexWriterMaker) const;
 
  private:
-  _Graph m_graph;
+  std::vector<VertexInfo> m_vertices;
+
+  /**
+   * \brief The edges, sorted by source once the graph is frozen.
+   */
+  std::vector<EdgeRecord> m_edges;
+
+  /**
+   * \brief The edges of vertex v are in [m_edgeOffsets[v],
+   * m_edgeOffsets[v + 1]) once the graph is frozen.
+   */
+  std::vector<EdgeIndex> m_edgeOffsets;
+
+  bool m_frozen;
 };
 
 /**
@@ -172,6 +302,7 @@ class Graph {
 class GraphException : public Exception {
  public:
   GraphException() {}
+  GraphException(const std::string& error) : Exception(error) {}
 };
 }
 
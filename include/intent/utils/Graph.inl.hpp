@@ -42,54 +42,93 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 // Created by clement on 07/05/16.
 //
 
-#include <iostream>
-#include "boost/graph/graphviz.hpp"
+#include <utility>
 
 namespace intent {
 template <typename VertexInfo, typename EdgeInfo>
-Graph<VertexInfo, EdgeInfo>::Graph() {}
+Graph<VertexInfo, EdgeInfo>::Graph() : m_edgeOffsets(1, 0), m_frozen(true) {}
 
 template <typename VertexInfo, typename EdgeInfo>
 typename Graph<VertexInfo, EdgeInfo>::Vertex
 Graph<VertexInfo, EdgeInfo>::addVertex(const VertexInfo& vertexInfo) {
-  _Vertex v = boost::add_vertex(m_graph);
-  m_graph[v] = vertexInfo;
+  m_vertices.push_back(vertexInfo);
+  // A vertex without edge keeps the layout valid.
+  if (m_frozen) m_edgeOffsets.push_back(m_edges.size());
 
-  return Vertex(m_graph, v);
+  return Vertex(*this, m_vertices.size() - 1);
 }
 
 template <typename VertexInfo, typename EdgeInfo>
 typename Graph<VertexInfo, EdgeInfo>::Edge Graph<VertexInfo, EdgeInfo>::addEdge(
     const Vertex& source, const Vertex& target, const EdgeInfo& edgeInfo) {
-  std::pair<_Edge, bool> p =
-      boost::add_edge(source.getVertex(), target.getVertex(), m_graph);
-  m_graph[p.first] = edgeInfo;
+  EdgeRecord edge;
+  edge.source = source.getVertex();
+  edge.target = target.getVertex();
+  edge.info = edgeInfo;
+  m_edges.push_back(edge);
+  m_frozen = false;
 
-  return Edge(m_graph, p.first);
+  return Edge(*this, m_edges.size() - 1);
+}
+
+template <typename VertexInfo, typename EdgeInfo>
+void Graph<VertexInfo, EdgeInfo>::freeze() {
+  if (m_frozen) return;
+
+  // Counting sort by source, stable so that the edges of a vertex stay in the
+  // order they were added.
+  m_edgeOffsets.assign(m_vertices.size() + 1, 0);
+  for (const EdgeRecord& edge : m_edges) ++m_edgeOffsets[edge.source + 1];
+  for (std::size_t v = 0; v < m_vertices.size(); ++v)
+    m_edgeOffsets[v + 1] += m_edgeOffsets[v];
+
+  std::vector<EdgeIndex> positions(m_edgeOffsets.begin(),
+                                   m_edgeOffsets.end() - 1);
+  std::vector<EdgeIndex> order(m_edges.size());
+  for (EdgeIndex e = 0; e < m_edges.size(); ++e)
+    order[positions[m_edges[e].source]++] = e;
+
+  std::vector<EdgeRecord> edges;
+  edges.reserve(m_edges.size());
+  for (EdgeIndex e : order) edges.push_back(std::move(m_edges[e]));
+
+  m_edges.swap(edges);
+  m_frozen = true;
 }
 
 template <typename VertexInfo, typename EdgeInfo>
 typename Graph<VertexInfo, EdgeInfo>::Edges
 Graph<VertexInfo, EdgeInfo>::nextEdges(
     const Graph<VertexInfo, EdgeInfo>::Vertex& v) const {
-  typedef typename Graph<VertexInfo, EdgeInfo>::Edges Edges;
-  typedef typename Graph<VertexInfo, EdgeInfo>::_Graph _Graph;
-
-  Edges outEdgesFromCurrentNode;
-  typename boost::graph_traits<_Graph>::out_edge_iterator e, e_end;
-  for (boost::tie(e, e_end) = boost::out_edges(v.getVertex(), m_graph);
-       e != e_end; ++e) {
-    Edge edge(m_graph, *e);
-    outEdgesFromCurrentNode.push_back(edge);
-  }
-  return outEdgesFromCurrentNode;
+  if (!m_frozen) throw GraphException();
+
+  VertexIndex vertex = v.getVertex();
+  return Edges(*this, m_edgeOffsets[vertex], m_edgeOffsets[vertex + 1]);
 }
 
 template <typename VertexInfo, typename EdgeInfo>
 template <typename WriterMaker>
 void Graph<VertexInfo, EdgeInfo>::dump(std::ostream& ostream,
                                        WriterMaker& wm) const {
-  boost::write_graphviz(ostream, m_graph, wm.makeVertexWriter(m_graph),
-                        wm.makeEdgeWriter(m_graph));
-};
+  if (!m_frozen) throw GraphException();
+
+  // The layout written by boost::write_graphviz.
+  typedef typename WriterMaker::VertexWriter VertexWriter;
+  typedef typename WriterMaker::EdgeWriter EdgeWriter;
+  VertexWriter vertexWriter = wm.makeVertexWriter(*this);
+  EdgeWriter edgeWriter = wm.makeEdgeWriter(*this);
+
+  ostream << "digraph G {" << std::endl;
+  for (VertexIndex v = 0; v < m_vertices.size(); ++v) {
+    ostream << v;
+    vertexWriter(ostream, vertexAt(v));
+    ostream << ";" << std::endl;
+  }
+  for (EdgeIndex e = 0; e < m_edges.size(); ++e) {
+    ostream << m_edges[e].source << "->" << m_edges[e].target << " ";
+    edgeWriter(ostream, Edge(*this, e));
+    ostream << ";" << std::endl;
+  }
+  ostream << "}" << std::endl;
+}
 }
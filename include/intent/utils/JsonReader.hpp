@@ -0,0 +1,146 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef INTENT_JSONREADER_HPP
+#define INTENT_JSONREADER_HPP
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "intent/utils/Exception.hpp"
+
+namespace intent {
+/**
+ * \brief Pull parser reading a JSON document from a stream one value at a
+ * time.
+ *
+ * The stream is read through a fixed size buffer and no document is built,
+ * the caller walks the values in the order they appear and skips the ones it
+ * does not need. Objects are read with beginObject and nextKey, arrays with
+ * beginArray and nextElement, the separators being handled by the reader.
+ */
+class JsonReader {
+ public:
+  struct ValueType {
+    enum type { OBJECT, ARRAY, STRING, NUMBER, BOOLEAN, NULL_VALUE };
+  };
+
+  explicit JsonReader(std::istream& is);
+
+  /**
+   * \brief The type of the next value, without reading it.
+   */
+  ValueType::type peekValueType();
+
+  /**
+   * \brief Read the opening brace of an object.
+   */
+  void beginObject();
+
+  /**
+   * \brief Read the next key of the current object, its value being the next
+   * value to read.
+   * \return false once the closing brace has been read.
+   */
+  bool nextKey(std::string& key);
+
+  /**
+   * \brief Read the opening bracket of an array.
+   */
+  void beginArray();
+
+  /**
+   * \brief Move to the next element of the current array.
+   * \return false once the closing bracket has been read.
+   */
+  bool nextElement();
+
+  /**
+   * \brief Read a string value.
+   */
+  void readString(std::string& value);
+
+  /**
+   * \brief Read and discard the next value, whatever its type.
+   */
+  void skipValue();
+
+  /**
+   * \brief Check that nothing but whitespaces follows the document.
+   */
+  void end();
+
+ private:
+  static const int END_OF_STREAM = -1;
+
+  int peek();
+  int get();
+  bool refill();
+  int peekNonWhitespace();
+  void expect(char expected);
+  void expectLiteral(const char* literal);
+  void readNumber();
+  void readDigits();
+  void appendCodePoint(unsigned int codePoint, std::string& value);
+  unsigned int readHexQuad();
+  void fail(const std::string& error) const;
+
+  std::istream& m_is;
+  std::vector<char> m_buffer;
+  size_t m_position;
+  size_t m_size;
+  size_t m_offset;
+
+  // Whether the next item of each open container is its first one.
+  std::vector<bool> m_firstItems;
+};
+
+/**
+ * \brief Exception thrown when the document is not valid JSON.
+ */
+class JsonReaderException : public Exception {
+ public:
+  JsonReaderException(const std::string& error) : Exception(error) {}
+};
+}
+
+#endif  // INTENT_JSONREADER_HPP
@@ -63,6 +63,23 @@ class Levenshtein {
    *
    */
   static unsigned int distance(const std::string& s1, const std::string& s2);
+
+  /**
+   * \brief Compute the Levenshtein distance between s1 and s2 if it does not
+   * exceed maxDistance.
+   *
+   * \param  s1           The first string.
+   * \param  s2           The second string.
+   * \param  maxDistance  The maximum distance of interest.
+   * \return The Levenshtein distance between s1 and s2 if it is lower or equal
+   * to maxDistance, maxDistance + 1 otherwise.
+   *
+   * Strings up to 64 characters use the bit-parallel algorithm of Myers as
+   * described by Hyyro, longer ones a DP restricted to a diagonal band. Both
+   * stop as soon as the bound cannot be met and allocate nothing.
+   */
+  static unsigned int distance(const std::string& s1, const std::string& s2,
+                               unsigned int maxDistance);
 };
 }
 
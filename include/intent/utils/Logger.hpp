@@ -41,13 +41,26 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #ifndef INTENT_LOGGER_HPP
 #define INTENT_LOGGER_HPP
 
+#include <atomic>
 #include <iostream>
+#include <memory>
+#include <mutex>
 
+#include "intent/utils/AsyncLogSink.hpp"
 #include "spdlog/spdlog.h"
 
 #include <string>
 #include <sstream>
 
+/**
+ * \brief The lowest severity level compiled in, as an index of
+ * Logger::SeverityLevel::type. The statements of lower levels are removed by
+ * the compiler along with the evaluation of their arguments.
+ */
+#ifndef INTENT_LOG_MIN_LEVEL
+#define INTENT_LOG_MIN_LEVEL 0
+#endif
+
 namespace intent {
 namespace log {
 
@@ -67,6 +80,25 @@ class Logger {
    */
   static void initialize(SeverityLevel::type severityLevel);
 
+  /**
+   * @brief Initialize the logging system in asynchronous mode: the messages
+   * are queued and written by a background thread. The queue is only created
+   * by the first call, the next ones only change the severity level.
+   * \param severityLevel     The maximum severity level to use.
+   * \param capacity          The maximum number of queued messages.
+   * \param overflowPolicy    What to do with a message when the queue is full.
+   */
+  static void initializeAsync(
+      SeverityLevel::type severityLevel, size_t capacity,
+      AsyncLogSink::OverflowPolicy::type overflowPolicy =
+          AsyncLogSink::OverflowPolicy::DROP_NEWEST);
+
+  /**
+   * @brief Wait until the messages logged so far have been written. Does
+   * nothing in synchronous mode.
+   */
+  static void flush();
+
   /**
    * @brief Return the severity type for string. Return FATAL if nothing is
    * matching.
@@ -77,144 +109,102 @@ class Logger {
       const std::string& severity);
 
   /**
-   * @brief Get the static instance of the logger
+   * @brief Get the static instance of the logger, created on first use with
+   * the level of the LOG_LEVEL environment variable, FATAL by default.
    * \return The logger instance
    */
-  static Logger& getInstance() {
-    static Logger* logger = NULL;
-    if (logger == NULL) {
-      logger = new Logger();
-      SeverityLevel::type initialLevel = SeverityLevel::FATAL;
-      if (const char* env_p = std::getenv("LOG_LEVEL")) {
-        initialLevel = Logger::severityLevelFromString(env_p);
-      }
-      initialize(initialLevel);
-    }
-    return *logger;
-  }
-
-  template <int v>
-  struct Int2Type {
-    enum { value = v };
-  };
+  static Logger& getInstance();
 
   /**
-   * \brief Logger by level of severity.
+   * @brief Whether the messages of a severity level are logged.
    */
-  template <SeverityLevel::type LogLevel>
-  class LoggerWithLevel {
-   public:
-    /**
-     * \brief Log a message from a string stream.
-     */
-    LoggerWithLevel& operator<<(const std::stringstream& message) {
-      //*this << message;
-      return *this;
-    }
-
-    /**
-     * \brief Log a message from an object that supports the stream operator.
-     */
-    template <typename T>
-    LoggerWithLevel& operator<<(const T& message) {
-      std::stringstream ss;
-      ss << message;
-      log(ss.str(), Int2Type<LogLevel>());
-      return *this;
-    }
-
-   private:
-    void log(const std::string& message, Int2Type<SeverityLevel::TRACE>) {
-      spdlog::get("console")->trace(message);
-    }
-
-    void log(const std::string& message, Int2Type<SeverityLevel::DEBUG>) {
-      spdlog::get("console")->debug(message);
-    }
-
-    void log(const std::string& message, Int2Type<SeverityLevel::INFO>) {
-      spdlog::get("console")->info(message);
-    }
-
-    void log(const std::string& message, Int2Type<SeverityLevel::WARNING>) {
-      spdlog::get("console")->warn(message);
-    }
-
-    void log(const std::string& message, Int2Type<SeverityLevel::ERROR>) {
-      spdlog::get("console")->error(message);
-    }
-
-    void log(const std::string& message, Int2Type<SeverityLevel::FATAL>) {
-      spdlog::get("console")->critical(message);
-    }
-  };
-
-  /**
-   * @brief Get the trace logger
-   * \return the trace logger
-   */
-  inline LoggerWithLevel<Logger::SeverityLevel::TRACE>& trace() {
-    return m_loggerTrace;
+  bool isEnabled(SeverityLevel::type severityLevel) const {
+    return severityLevel >= m_severityLevel.load(std::memory_order_relaxed);
   }
 
   /**
-   * @brief Get the debug logger
-   * \return the debug logger
+   * @brief Log a message with a severity level.
    */
-  inline LoggerWithLevel<Logger::SeverityLevel::DEBUG>& debug() {
-    return m_loggerDebug;
-  }
+  void log(SeverityLevel::type severityLevel, std::string message);
 
   /**
-   * @brief Get the info logger
-   * \return the info logger
+   * @brief The number of messages dropped because the queue of the
+   * asynchronous mode was full.
    */
-  inline LoggerWithLevel<Logger::SeverityLevel::INFO>& info() {
-    return m_loggerInfo;
-  }
+  size_t droppedMessages() const;
 
-  /**
-   * @brief Get the warning logger
-   * \return the warning logger
-   */
-  inline LoggerWithLevel<Logger::SeverityLevel::WARNING>& warning() {
-    return m_loggerWarning;
-  }
+  ~Logger();
+
+ private:
+  Logger();
+
+  void setSeverityLevel(SeverityLevel::type severityLevel);
+  void write(SeverityLevel::type severityLevel, const std::string& message);
+
+  std::atomic<int> m_severityLevel;
+  // Set once when the asynchronous mode is enabled, kept until destruction.
+  std::atomic<AsyncLogSink*> m_asyncSink;
+  std::mutex m_asyncSinkMutex;
+  // Looked up once, the spdlog registry being protected by a mutex.
+  std::shared_ptr<spdlog::logger> m_console;
+};
+
+/**
+ * \brief A log statement, formatted as it is streamed and logged as a single
+ * message when it is destroyed.
+ */
+class LogRecord {
+ public:
+  explicit LogRecord(Logger::SeverityLevel::type severityLevel)
+      : m_severityLevel(severityLevel) {}
+
+  ~LogRecord() { Logger::getInstance().log(m_severityLevel, m_stream.str()); }
 
   /**
-   * @brief Get the error logger
-   * \return the error logger
+   * \brief Append the content of a string stream.
    */
-  inline LoggerWithLevel<Logger::SeverityLevel::ERROR>& error() {
-    return m_loggerError;
+  LogRecord& operator<<(const std::stringstream& message) {
+    m_stream << message.str();
+    return *this;
   }
 
   /**
-   * @brief Get the fatal logger
-   * \return the fatal logger
+   * \brief Append an object that supports the stream operator.
    */
-  inline LoggerWithLevel<Logger::SeverityLevel::FATAL>& fatal() {
-    return m_loggerFatal;
+  template <typename T>
+  LogRecord& operator<<(const T& message) {
+    m_stream << message;
+    return *this;
   }
 
  private:
-  Logger() {}
-
-  LoggerWithLevel<Logger::SeverityLevel::TRACE> m_loggerTrace;
-  LoggerWithLevel<Logger::SeverityLevel::DEBUG> m_loggerDebug;
-  LoggerWithLevel<Logger::SeverityLevel::INFO> m_loggerInfo;
-  LoggerWithLevel<Logger::SeverityLevel::WARNING> m_loggerWarning;
-  LoggerWithLevel<Logger::SeverityLevel::ERROR> m_loggerError;
-  LoggerWithLevel<Logger::SeverityLevel::FATAL> m_loggerFatal;
+  Logger::SeverityLevel::type m_severityLevel;
+  std::ostringstream m_stream;
 };
 }
 }
 
-#define INTENT_LOG_TRACE() intent::log::Logger::getInstance().trace()
-#define INTENT_LOG_DEBUG() intent::log::Logger::getInstance().debug()
-#define INTENT_LOG_INFO() intent::log::Logger::getInstance().info()
-#define INTENT_LOG_WARNING() intent::log::Logger::getInstance().warning()
-#define INTENT_LOG_ERROR() intent::log::Logger::getInstance().error()
-#define INTENT_LOG_FATAL() intent::log::Logger::getInstance().fatal()
+/**
+ * \brief Log statement of a given level. The level is checked first so the
+ * streamed arguments are only evaluated if the message is logged.
+ */
+#define INTENT_LOG(severityLevel)                                   \
+  if ((severityLevel) < INTENT_LOG_MIN_LEVEL ||                     \
+      !intent::log::Logger::getInstance().isEnabled(severityLevel)) \
+    ;                                                               \
+  else                                                              \
+    intent::log::LogRecord(severityLevel)
+
+#define INTENT_LOG_TRACE() \
+  INTENT_LOG(intent::log::Logger::SeverityLevel::TRACE)
+#define INTENT_LOG_DEBUG() \
+  INTENT_LOG(intent::log::Logger::SeverityLevel::DEBUG)
+#define INTENT_LOG_INFO() INTENT_LOG(intent::log::Logger::SeverityLevel::INFO)
+#define INTENT_LOG_WARNING() \
+  INTENT_LOG(intent::log::Logger::SeverityLevel::WARNING)
+#define INTENT_LOG_ERROR() \
+  INTENT_LOG(intent::log::Logger::SeverityLevel::ERROR)
+#define INTENT_LOG_FATAL() \
+  INTENT_LOG(intent::log::Logger::SeverityLevel::FATAL)
 
 #endif
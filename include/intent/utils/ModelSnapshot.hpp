@@ -0,0 +1,161 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef INTENT_MODELSNAPSHOT_HPP
+#define INTENT_MODELSNAPSHOT_HPP
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include "intent/chatbot/ChatbotModel.hpp"
+#include "intent/utils/Exception.hpp"
+
+namespace intent {
+/**
+ * \brief Versioned binary snapshot of a complete chatbot model.
+ *
+ * A snapshot is written once from a model loaded from JSON or OIML and then
+ * loaded by every process instead of parsing and compiling the model again.
+ * The dictionary is stored with its compacted trigram index and phrase trie,
+ * which are read back as they are: no term is pushed and no index is built
+ * at load time.
+ *
+ * The dictionary is made of flat arrays addressed by offsets. A model
+ * attached to a snapshot mapped read-only, from a file or from a shared
+ * memory segment, reads them in place: the processes attached to the same
+ * snapshot share the pages of the dictionary instead of holding a copy each.
+ * The intents, the story graph and the replies are still copied.
+ *
+ * The snapshot starts with a header holding a magic number, the format
+ * version, a byte order mark, the size of the payload and its checksum. The
+ * checksum is only verified on demand: it reads every page of the snapshot,
+ * including the ones of the dictionary that a lookup may never touch.
+ */
+class ModelSnapshot {
+ public:
+  /**
+   * \brief The version of the format, increased on every change of the
+   * layout. Snapshots of other versions are rejected.
+   */
+  static const uint32_t VERSION;
+
+  /**
+   * \brief What is verified when a snapshot is loaded.
+   */
+  enum Verification {
+    // The header and the bounds of the arrays, which the lookups rely on.
+    STRUCTURE,
+    // The checksum of the whole payload as well.
+    CHECKSUM
+  };
+
+  /**
+   * \brief Write a snapshot of a model.
+   * Throws ModelSnapshotException if the model is incomplete or its story
+   * graph is not frozen.
+   */
+  static void write(const ChatbotModel& chatbotModel, std::ostream& os);
+
+  /**
+   * \brief Load a model from a snapshot in memory, copying all of it.
+   * Throws ModelSnapshotException if the snapshot is invalid.
+   */
+  static ChatbotModel read(const char* data, size_t size,
+                           Verification verification = STRUCTURE);
+
+  /**
+   * \brief Load a model from a snapshot file, copying all of it.
+   * Throws ModelSnapshotException if the file cannot be mapped or the
+   * snapshot is invalid.
+   */
+  static ChatbotModel load(const std::string& filename,
+                           Verification verification = STRUCTURE);
+
+  /**
+   * \brief Load a model reading its dictionary in place from a snapshot file
+   * mapped read-only. The file stays mapped as long as the model, or a copy
+   * of its dictionary, lives and must not be modified meanwhile: it is
+   * replaced by renaming a new file over it.
+   * Throws ModelSnapshotException if the file cannot be mapped or the
+   * snapshot is invalid.
+   */
+  static ChatbotModel attachFile(const std::string& filename,
+                                 Verification verification = STRUCTURE);
+
+  /**
+   * \brief Write a snapshot of a model into a new shared memory segment,
+   * replacing the segment of the same name if any. The segment outlives the
+   * process until removeSharedMemory is called. Its magic number is written
+   * last, once the rest of the snapshot is in the segment.
+   * Throws ModelSnapshotException if the segment cannot be created.
+   */
+  static void createSharedMemory(const ChatbotModel& chatbotModel,
+                                 const std::string& segmentName);
+
+  /**
+   * \brief Load a model reading its dictionary in place from a shared memory
+   * segment written by createSharedMemory, mapped read-only. The segment
+   * stays mapped as long as the model, or a copy of its dictionary, lives.
+   * A segment being replaced is waited for until its snapshot is published.
+   * Throws ModelSnapshotException if the segment cannot be mapped or the
+   * snapshot is invalid.
+   */
+  static ChatbotModel attachSharedMemory(
+      const std::string& segmentName, Verification verification = STRUCTURE);
+
+  /**
+   * \brief Remove a shared memory segment. The processes attached to it keep
+   * their mapping.
+   * \return false if there is no such segment.
+   */
+  static bool removeSharedMemory(const std::string& segmentName);
+};
+
+/**
+ * \brief Exception thrown when a snapshot cannot be loaded.
+ */
+class ModelSnapshotException : public Exception {
+ public:
+  ModelSnapshotException(const std::string& error) : Exception(error) {}
+};
+}
+
+#endif  // INTENT_MODELSNAPSHOT_HPP
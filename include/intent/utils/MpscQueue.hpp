@@ -0,0 +1,118 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef INTENT_MPSCQUEUE_HPP
+#define INTENT_MPSCQUEUE_HPP
+
+#include <atomic>
+#include <utility>
+
+namespace intent {
+/**
+ * \brief Unbounded lock-free queue for several producers and one consumer.
+ *
+ * The values are kept in a linked list whose head is swapped in by the
+ * producers and whose tail is only read by the consumer (Vyukov's
+ * intrusive MPSC queue). A producer never waits for another one, but a value
+ * becomes visible to the consumer only once the producers that swapped the
+ * head before it have linked their node, so tryPop may briefly fail on a non
+ * empty queue.
+ */
+template <typename T>
+class MpscQueue {
+ public:
+  MpscQueue() : m_head(new Node), m_tail(m_head.load()) {}
+
+  /**
+   * \brief Delete the values left, no producer must push concurrently.
+   */
+  ~MpscQueue() {
+    while (m_tail) {
+      Node* next = m_tail->next.load(std::memory_order_relaxed);
+      delete m_tail;
+      m_tail = next;
+    }
+  }
+
+  MpscQueue(const MpscQueue&) = delete;
+  MpscQueue& operator=(const MpscQueue&) = delete;
+
+  /**
+   * \brief Queue a value, callable from any thread.
+   */
+  void push(T value) {
+    Node* node = new Node;
+    node->value = std::move(value);
+    Node* previous = m_head.exchange(node, std::memory_order_acq_rel);
+    previous->next.store(node, std::memory_order_release);
+  }
+
+  /**
+   * \brief Take the oldest value, callable from the consumer thread only.
+   * \return false if no value is visible yet.
+   */
+  bool tryPop(T& value) {
+    Node* next = m_tail->next.load(std::memory_order_acquire);
+    if (!next) return false;
+
+    // The node of the popped value becomes the new sentinel.
+    value = std::move(next->value);
+    delete m_tail;
+    m_tail = next;
+    return true;
+  }
+
+ private:
+  struct Node {
+    Node() : next(nullptr) {}
+
+    std::atomic<Node*> next;
+    T value;
+  };
+
+  std::atomic<Node*> m_head;
+  // The producers and the consumer write different ends, the padding keeps
+  // them on separate cache lines.
+  char m_padding[64];
+  Node* m_tail;
+};
+}
+
+#endif  // INTENT_MPSCQUEUE_HPP
@@ -0,0 +1,158 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef INTENT_PACKEDARRAY_HPP
+#define INTENT_PACKEDARRAY_HPP
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace intent {
+/**
+ * \brief Read-only array of trivially copyable values, either owned or
+ * referring to a buffer it does not own, like a read-only memory mapping.
+ *
+ * The referred buffer is kept alive by a shared pointer, so the copies of an
+ * array attached to a mapping share the mapping instead of copying it.
+ */
+template <typename T>
+class PackedArray {
+ public:
+  typedef const T* const_iterator;
+
+  PackedArray() : m_data(NULL), m_size(0) {}
+
+  PackedArray(const PackedArray& that) { copyFrom(that); }
+
+  PackedArray(PackedArray&& that) : m_data(NULL), m_size(0) { swap(that); }
+
+  PackedArray& operator=(const PackedArray& that) {
+    if (this != &that) copyFrom(that);
+    return *this;
+  }
+
+  PackedArray& operator=(PackedArray&& that) {
+    PackedArray(std::move(that)).swap(*this);
+    return *this;
+  }
+
+  /**
+   * \brief Take the ownership of the values, releasing the previous buffer.
+   */
+  void assign(std::vector<T>&& values) {
+    m_values.swap(values);
+    std::vector<T>().swap(values);
+    m_values.shrink_to_fit();
+    m_storage.reset();
+    m_data = m_values.data();
+    m_size = m_values.size();
+  }
+
+  /**
+   * \brief Refer to values owned by storage, releasing the previous buffer.
+   */
+  void attach(const T* data, size_t size,
+              const std::shared_ptr<const void>& storage) {
+    std::vector<T>().swap(m_values);
+    m_storage = storage;
+    m_data = data;
+    m_size = size;
+  }
+
+  void clear() { assign(std::vector<T>()); }
+
+  void swap(PackedArray& that) {
+    m_values.swap(that.m_values);
+    m_storage.swap(that.m_storage);
+    std::swap(m_data, that.m_data);
+    std::swap(m_size, that.m_size);
+  }
+
+  const T* data() const { return m_data; }
+  size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  const_iterator begin() const { return m_data; }
+  const_iterator end() const { return m_data + m_size; }
+
+  const T& operator[](size_t i) const { return m_data[i]; }
+  const T& back() const { return m_data[m_size - 1]; }
+
+  /**
+   * \brief Whether the values are in a buffer the array does not own.
+   */
+  bool isAttached() const { return static_cast<bool>(m_storage); }
+
+  /**
+   * \brief The number of bytes owned by the array, the attached buffers are
+   * not counted.
+   */
+  size_t memoryUsage() const { return m_values.capacity() * sizeof(T); }
+
+ private:
+  void copyFrom(const PackedArray& that) {
+    m_values = that.m_values;
+    m_storage = that.m_storage;
+    m_data = m_storage ? that.m_data : m_values.data();
+    m_size = that.m_size;
+  }
+
+  std::vector<T> m_values;
+  std::shared_ptr<const void> m_storage;
+  const T* m_data;
+  size_t m_size;
+};
+
+/**
+ * \brief Whether an array holds the bounds of consecutive ranges covering
+ * [0, end): it starts with 0, ends with end and never decreases.
+ */
+template <typename T>
+bool isRangeBounds(const PackedArray<T>& bounds, size_t end) {
+  if (bounds.empty() || bounds[0] != 0 || bounds.back() != end) return false;
+  for (size_t i = 1; i < bounds.size(); ++i)
+    if (bounds[i - 1] > bounds[i]) return false;
+  return true;
+}
+}
+
+#endif  // INTENT_PACKEDARRAY_HPP
@@ -41,6 +41,12 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #ifndef INTENT_REGEXMATCHER_HPP
 #define INTENT_REGEXMATCHER_HPP
 
+#include <memory>
+#include <regex>
+#include <string>
+
+#include <boost/utility/string_ref.hpp>
+
 namespace intent {
 /**
  * \brief RegexMatcher is a utility class that asserts whether a string matches
@@ -50,16 +56,38 @@ class RegexMatcher {
  public:
   static const std::string REGEX_MARKERS;
 
+  /**
+   * \brief A compiled regular expression, shared by the copies of its owner.
+   */
+  typedef std::shared_ptr<const std::regex> CompiledRegex;
+
+  /**
+   * \param regex     The regular expression.
+   * \return          The compiled regular expression.
+   *
+   * \brief Compiles a regular expression once for its owner to keep, like
+   * the dictionary model at load time.
+   * Throws std::regex_error if the expression is invalid.
+   */
+  static CompiledRegex compile(const std::string& regex);
+
   /**
    * \param input     The input string that needs to be checked.
    * \param regex     The regular expression.
    * \return          Returns true if the input string matches the regex. It
    * returns false otherwise.
    *
-   * \brief Asserts whether a string matches a regular expression.
+   * \brief Asserts whether a string matches a regular expression. The
+   * expression is compiled on each call, prefer the overload taking a compiled
+   * expression.
    */
   static bool match(const std::string& input, const std::string& regex);
 
+  /**
+   * \brief Asserts whether a string matches a compiled regular expression.
+   */
+  static bool match(boost::string_ref input, const std::regex& regex);
+
   static std::string padAroundRegexMarkersInSentence(const std::string& input);
 
   static bool isRegexMarker(const std::string& input);
@@ -44,6 +44,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <string>
 #include <vector>
 
+#include <boost/utility/string_ref.hpp>
+
 namespace intent {
 
 class SingleCharacterDelimiterTokenizer {
@@ -58,6 +60,16 @@ class SingleCharacterDelimiterTokenizer {
    */
   typedef std::vector<Token> Tokens;
 
+  /**
+   * \brief A token referencing a range of the tokenized buffer.
+   */
+  typedef boost::string_ref TokenView;
+
+  /**
+   * \brief A list of TokenViews.
+   */
+  typedef std::vector<TokenView> TokenViews;
+
   /**
    * \brief Tokenize a sentence.
    *
@@ -69,6 +81,21 @@ class SingleCharacterDelimiterTokenizer {
   static void tokenize(const std::string& message,
                        const std::string& delimiters, Tokens& tokens);
 
+  /**
+   * \brief Tokenize a sentence into views of the input buffer.
+   *
+   * The input is scanned once and no token is copied: the views stay valid as
+   * long as the buffer referenced by message does. Regex markers are reported
+   * as standalone tokens, as in the copying version.
+   *
+   * \param message       The input buffer to be tokenized.
+   * \param delimiters    The list of single character delimiters used to split
+   * the input string.
+   * \param tokens        The views are appended to this list.
+   */
+  static void tokenize(boost::string_ref message, const std::string& delimiters,
+                       TokenViews& tokens);
+
   /**
    * \param message       The input string to be tokenized.
    * \param delimiters    The list of single character delimiters used to split
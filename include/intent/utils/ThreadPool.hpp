@@ -0,0 +1,121 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#ifndef INTENT_THREADPOOL_HPP
+#define INTENT_THREADPOOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace intent {
+/**
+ * \brief Pool of worker threads balancing the tasks by work stealing.
+ *
+ * Every worker owns a queue of tasks. It takes its own tasks from the back
+ * and, once its queue is empty, steals the tasks at the front of the other
+ * queues so that no worker stays idle while others still have work.
+ */
+class ThreadPool {
+ public:
+  typedef std::function<void()> Task;
+
+  /**
+   * \brief A body run on the range of indices [begin, end).
+   */
+  typedef std::function<void(size_t begin, size_t end)> RangeBody;
+
+  /**
+   * \param threadCount   The number of workers, the number of hardware threads
+   * if 0.
+   */
+  explicit ThreadPool(size_t threadCount = 0);
+
+  /**
+   * \brief Wait for the queued tasks to be done and join the workers.
+   */
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /**
+   * \brief The number of workers.
+   */
+  size_t size() const { return m_workers.size(); }
+
+  /**
+   * \brief Run a body on the indices [0, count) split into ranges of at most
+   * grainSize indices, and wait for all of them to be done.
+   *
+   * The calling thread steals ranges as well while it waits. The first
+   * exception thrown by the body is rethrown once all the ranges are done.
+   */
+  void parallelFor(size_t count, size_t grainSize, const RangeBody& body);
+
+ private:
+  struct Worker {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  void push(size_t workerIndex, Task task);
+  bool pop(size_t workerIndex, Task& task);
+  bool steal(size_t thiefIndex, Task& task);
+  void run(size_t workerIndex);
+
+  std::vector<std::unique_ptr<Worker>> m_workers;
+  std::vector<std::thread> m_threads;
+
+  // The number of tasks queued and not yet taken by a worker.
+  std::atomic<size_t> m_queuedTasks;
+  std::mutex m_wakeMutex;
+  std::condition_variable m_wake;
+  bool m_stopping;
+};
+}
+
+#endif  // INTENT_THREADPOOL_HPP
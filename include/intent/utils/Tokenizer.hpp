@@ -44,6 +44,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <string>
 #include <vector>
 
+#include "intent/utils/RegexMatcher.hpp"
+#include "intent/utils/SingleCharacterDelimiterTokenizer.hpp"
+
 namespace intent {
 
 class Tokenizer {
@@ -58,14 +61,44 @@ class Tokenizer {
    */
   typedef std::vector<Token> Tokens;
 
+  /**
+   * \brief A token referencing a range of the tokenized buffer.
+   */
+  typedef SingleCharacterDelimiterTokenizer::TokenView TokenView;
+
+  /**
+   * \brief A list of TokenViews.
+   */
+  typedef SingleCharacterDelimiterTokenizer::TokenViews TokenViews;
+
+  /**
+   * \brief A list of compiled regular expressions.
+   */
+  typedef std::vector<RegexMatcher::CompiledRegex> Regexes;
+
   Tokenizer(const std::string& m_delimiters,
             const std::vector<std::string>& regexpList);
 
-  void tokenize(const std::string& message, Tokens& tokens);
+  /**
+   * \param delimiters    The single character delimiters.
+   * \param regexes       The compiled regular expressions whose matches are
+   * kept as single tokens.
+   */
+  Tokenizer(const std::string& delimiters, const Regexes& regexes);
+
+  void tokenize(const std::string& message, Tokens& tokens) const;
+
+  /**
+   * \brief Tokenize a message without copying it.
+   *
+   * \param message       The buffer to tokenize. It must outlive the views.
+   * \param tokens        The views into message are appended to this list.
+   */
+  void tokenize(boost::string_ref message, TokenViews& tokens) const;
 
  private:
   const std::string m_delimiters;
-  const std::vector<std::string> m_regexpList;
+  Regexes m_regexes;
 };
 }
 
@@ -95,15 +95,17 @@ std::string replaceTemplateVariables(
     const std::string& templateMessage,
     const Chatbot::VariablesMap& intentVariables,
     Chatbot::VariablesMap& userDefinedVariables) {
-  std::string message;
-
-  std::regex expression;
-
-  expression = "\\$\\{([a-zA-Z0-9_@]+)\\}";
-  message = replaceVariables(templateMessage, expression, userDefinedVariables);
+  // Compiled once and shared by the threads treating messages, matching does
+  // not modify them.
+  static const std::regex userDefinedVariableExpression(
+      "\\$\\{([a-zA-Z0-9_@]+)\\}");
+  static const std::regex intentVariableExpression("\\$\\[([a-zA-Z0-9_@]+)\\]");
 
-  expression = "\\$\\[([a-zA-Z0-9_@]+)\\]";
-  message = replaceVariables(message, expression, intentVariables);
+  std::string message;
+  message = replaceVariables(templateMessage, userDefinedVariableExpression,
+                             userDefinedVariables);
+  message = replaceVariables(message, intentVariableExpression,
+                             intentVariables);
 
   return message;
 }
@@ -157,17 +159,19 @@ void executeActions(const ChatbotActionModel& chatbotActionModel,
   userDefinedActionHandler(actionId, intentVariables, templateRepliesVariables);
 }
 
-bool Chatbot::treatMessage(const std::string& msg, Context& context,
+bool Chatbot::treatMessage(boost::string_ref msg, Context& context,
                            UserDefinedActionHandler& userDefinedActionHandler,
                            Chatbot::VariablesMap& intentVariables,
                            Chatbot::VariablesMap& userDefinedVariables) {
   IntentStoryService::Result result =
-      m_intentStoryService.evaluate(context.currentStateId, msg);
+      m_intentStoryService.evaluate(context.currentState, msg);
   if (result.found) {
     buildParams(intentVariables, result.intent);
 
-    INTENT_LOG_DEBUG() << "Next state is \"" + result.nextStateId + "\".";
-    context.currentStateId = result.nextStateId;
+    INTENT_LOG_DEBUG() << "Next state is \""
+                       << m_intentStoryService.getStateId(result.nextState)
+                       << "\".";
+    context.currentState = result.nextState;
 
     executeActions(*m_chatbotActionModel, result.actionId,
                    userDefinedActionHandler, intentVariables,
@@ -181,4 +185,10 @@ std::string Chatbot::getInitialState() const {
   return m_intentStoryService.getIntentStoryServiceModel()
       .intentStoryModel->rootStateId;
 }
+
+Chatbot::Context Chatbot::getInitialContext() const {
+  Context context;
+  context.currentState = m_intentStoryService.getRootState();
+  return context;
+}
 }
@@ -46,6 +46,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "intent/interpreter/Interpreter.hpp"
 #include "intent/utils/Deserializer.hpp"
+#include "intent/utils/ModelSnapshot.hpp"
 
 #include "intent/utils/Logger.hpp"
 
@@ -74,6 +75,38 @@ Chatbot::SharedPtr ChatbotFactory::createChatbotFromOIML(
   return chatbot;
 }
 
+Chatbot::SharedPtr ChatbotFactory::createChatbotFromOIML(
+    std::istream& dictionaryModel, std::istream& interpreterModel,
+    InterpreterFeedback& feedback, InterpreterCache& cache) {
+  ChatbotModel chatbotModel;
+  intent::Chatbot::SharedPtr chatbot;
+  if (ChatbotFactory::loadFromOIML(dictionaryModel, interpreterModel,
+                                   chatbotModel, feedback, &cache)) {
+    chatbot.reset(new intent::Chatbot(chatbotModel));
+  }
+  return chatbot;
+}
+
+Chatbot::SharedPtr ChatbotFactory::createChatbotFromSnapshot(
+    const std::string& snapshotFilename) {
+  ChatbotModel chatbotModel;
+  intent::Chatbot::SharedPtr chatbot;
+  if (ChatbotFactory::loadFromSnapshot(snapshotFilename, chatbotModel)) {
+    chatbot.reset(new intent::Chatbot(chatbotModel));
+  }
+  return chatbot;
+}
+
+Chatbot::SharedPtr ChatbotFactory::createChatbotFromSharedMemory(
+    const std::string& segmentName) {
+  ChatbotModel chatbotModel;
+  intent::Chatbot::SharedPtr chatbot;
+  if (ChatbotFactory::loadFromSharedMemory(segmentName, chatbotModel)) {
+    chatbot.reset(new intent::Chatbot(chatbotModel));
+  }
+  return chatbot;
+}
+
 SingleSessionChatbot::SharedPtr
 ChatbotFactory::createSingleSessionChatbotFromJsonModel(
     std::istream& model,
@@ -102,6 +135,32 @@ ChatbotFactory::createSingleSessionChatbotFromOIML(
   return chatbot;
 }
 
+SingleSessionChatbot::SharedPtr
+ChatbotFactory::createSingleSessionChatbotFromSnapshot(
+    const std::string& snapshotFilename,
+    Chatbot::UserDefinedActionHandler::SharedPtr userDefinedActionHandler) {
+  ChatbotModel chatbotModel;
+  intent::SingleSessionChatbot::SharedPtr chatbot;
+  if (ChatbotFactory::loadFromSnapshot(snapshotFilename, chatbotModel)) {
+    chatbot.reset(new intent::SingleSessionChatbot(chatbotModel,
+                                                   userDefinedActionHandler));
+  }
+  return chatbot;
+}
+
+SingleSessionChatbot::SharedPtr
+ChatbotFactory::createSingleSessionChatbotFromSharedMemory(
+    const std::string& segmentName,
+    Chatbot::UserDefinedActionHandler::SharedPtr userDefinedActionHandler) {
+  ChatbotModel chatbotModel;
+  intent::SingleSessionChatbot::SharedPtr chatbot;
+  if (ChatbotFactory::loadFromSharedMemory(segmentName, chatbotModel)) {
+    chatbot.reset(new intent::SingleSessionChatbot(chatbotModel,
+                                                   userDefinedActionHandler));
+  }
+  return chatbot;
+}
+
 bool ChatbotFactory::loadFromJsonModel(std::istream& model,
                                        ChatbotModel& chatbotModel) {
   bool loaded = false;
@@ -124,21 +183,21 @@ bool ChatbotFactory::loadFromJsonModel(std::istream& model,
 bool ChatbotFactory::loadFromOIML(std::istream& dictionaryModel,
                                   std::istream& interpreterModel,
                                   ChatbotModel& chatbotModel,
-                                  InterpreterFeedback& feedback) {
+                                  InterpreterFeedback& feedback,
+                                  InterpreterCache* cache) {
   bool loaded = false;
   if (dictionaryModel.good() && interpreterModel.good()) {
     intent::Deserializer deserializer;
     try {
       chatbotModel.intentStoryServiceModel.intentServiceModel.dictionaryModel =
           deserializer.deserialize<DictionaryModel::SharedPtr>(dictionaryModel);
-      std::istreambuf_iterator<char> eos;
-      std::string content(std::istreambuf_iterator<char>(interpreterModel),
-                          eos);
-
+      DictionaryModel::SharedPtr dictionary =
+          chatbotModel.intentStoryServiceModel.intentServiceModel
+              .dictionaryModel;
       chatbotModel =
-          Interpreter::build(content, chatbotModel.intentStoryServiceModel
-                                          .intentServiceModel.dictionaryModel,
-                             feedback);
+          cache ? Interpreter::build(interpreterModel, dictionary, feedback,
+                                     *cache)
+                : Interpreter::build(interpreterModel, dictionary, feedback);
 
       loaded = true;
     } catch (...) {
@@ -149,4 +208,27 @@ bool ChatbotFactory::loadFromOIML(std::istream& dictionaryModel,
   }
   return loaded;
 }
+
+bool ChatbotFactory::loadFromSnapshot(const std::string& snapshotFilename,
+                                      ChatbotModel& chatbotModel) {
+  try {
+    chatbotModel = ModelSnapshot::attachFile(snapshotFilename);
+  } catch (const ModelSnapshotException& e) {
+    INTENT_LOG_ERROR() << "[ChatbotFactory::loadFromSnapshot] " << e.message();
+    return false;
+  }
+  return true;
+}
+
+bool ChatbotFactory::loadFromSharedMemory(const std::string& segmentName,
+                                          ChatbotModel& chatbotModel) {
+  try {
+    chatbotModel = ModelSnapshot::attachSharedMemory(segmentName);
+  } catch (const ModelSnapshotException& e) {
+    INTENT_LOG_ERROR() << "[ChatbotFactory::loadFromSharedMemory] "
+                       << e.message();
+    return false;
+  }
+  return true;
+}
 }
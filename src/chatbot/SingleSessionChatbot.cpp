@@ -48,10 +48,8 @@ SingleSessionChatbot::SingleSessionChatbot(
     const ChatbotModel& chatbotModel,
     Chatbot::UserDefinedActionHandler::SharedPtr userDefinedActionHandler)
     : Chatbot(chatbotModel),
-      m_userDefinedActionHandler(userDefinedActionHandler) {
-  m_context.currentStateId = m_intentStoryService.getIntentStoryServiceModel()
-                                 .intentStoryModel->rootStateId;
-}
+      m_context(getInitialContext()),
+      m_userDefinedActionHandler(userDefinedActionHandler) {}
 
 std::vector<std::string> SingleSessionChatbot::treatMessage(
     const std::string& message) {
@@ -60,7 +58,8 @@ std::vector<std::string> SingleSessionChatbot::treatMessage(
   Chatbot::VariablesMap userDefinedVariables;
 
   SingleSessionChatbot::UserDefinedActionHandlerAdapter userDefinedAction(
-      m_context.currentStateId, *this, replies, m_userDefinedActionHandler);
+      getStateId(m_context.currentState), *this, replies,
+      m_userDefinedActionHandler);
   Chatbot::treatMessage(message, m_context, userDefinedAction, intentVariables,
                         userDefinedVariables);
 
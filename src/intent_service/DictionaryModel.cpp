@@ -55,4 +55,13 @@ void DictionaryModel::initBuiltInEntities() {
 }
 
 DictionaryModel::DictionaryModel() { initBuiltInEntities(); }
+
+void DictionaryModel::addRegex(const std::string& pattern, int entityId) {
+  Regex regex;
+  regex.pattern = pattern;
+  regex.compiledRegex = RegexMatcher::compile(pattern);
+  regex.entityId = entityId;
+
+  regexes.push_back(regex);
+}
 }
@@ -48,38 +48,67 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 namespace intent {
 
-int checkRegexes(const std::string& term,
-                 DictionaryModel::RegexToEntityIdIndex regexes) {
-  DictionaryModel::RegexToEntityIdIndex::iterator foundRegex =
+int checkRegexes(boost::string_ref term,
+                 const DictionaryModel::Regexes& regexes) {
+  DictionaryModel::Regexes::const_iterator foundRegex =
       std::find_if(regexes.begin(), regexes.end(),
-                   [&term](const std::pair<std::string, int>& regexToEntityId) {
-                     return RegexMatcher::match(term, regexToEntityId.first);
+                   [&term](const DictionaryModel::Regex& regex) {
+                     return RegexMatcher::match(term, *regex.compiledRegex);
                    });
 
-  return (foundRegex != regexes.end()) ? foundRegex->second : -1;
+  return (foundRegex != regexes.end()) ? foundRegex->entityId : -1;
 }
 
 EntitiesMatcher::Variables EntitiesMatcher::match(
     const Tokenizer::Tokens& tokens, const DictionaryModel& dictionaryModel) {
+  return match(Tokenizer::TokenViews(tokens.begin(), tokens.end()),
+               dictionaryModel);
+}
+
+EntitiesMatcher::Variables EntitiesMatcher::match(
+    const Tokenizer::TokenViews& tokens,
+    const DictionaryModel& dictionaryModel) {
+  const TermIndex& dictionary = dictionaryModel.dictionary;
+
+  // The exact terms are found first, the fuzzy matching only runs on the
+  // tokens they do not cover.
+  TermIndex::PhraseMatches exactMatches;
+  dictionary.findExactTerms(tokens.begin(), tokens.end(), exactMatches);
+  TermIndex::PhraseMatches::const_iterator exactMatch = exactMatches.begin();
+
   Variables variables;
-  std::vector<std::string>::const_iterator it = tokens.begin();
-  std::vector<std::string>::const_iterator itEnd = tokens.end();
+  Tokenizer::TokenViews::const_iterator it = tokens.begin();
+  Tokenizer::TokenViews::const_iterator itEnd = tokens.end();
 
   while (it != itEnd) {
+    Tokenizer::TokenViews::const_iterator uncoveredEnd = itEnd;
+    if (exactMatch != exactMatches.end()) {
+      uncoveredEnd = tokens.begin() + exactMatch->position;
+      if (it == uncoveredEnd) {
+        Variable v;
+        v.text = it->to_string();
+        v.term = exactMatch->termId;
+        v.entity = exactMatch->entityId;
+        variables.push_back(v);
+        it += exactMatch->length;
+        ++exactMatch;
+        continue;
+      }
+    }
+
     int tokensPopped = 1;
-    const std::vector<std::string> tokenBuffer(it, itEnd);
     Term term =
-        dictionaryModel.dictionary.findTerm(*it, tokenBuffer, tokensPopped);
+        dictionary.findApproximateTerm(*it, it, uncoveredEnd, tokensPopped);
     Variable v;
     if (term.termId != -1) {
-      v.text = *it;
+      v.text = it->to_string();
       v.term = term.termId;
       v.entity = term.entityId;
       variables.push_back(v);
     } else {
-      int entityId = checkRegexes(*it, dictionaryModel.regexesByEntityId);
+      int entityId = checkRegexes(*it, dictionaryModel.regexes);
       if (entityId != -1) {
-        v.text = *it;
+        v.text = it->to_string();
         v.term = -1;
         v.entity = entityId;
         variables.push_back(v);
@@ -0,0 +1,415 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "intent/intent_service/IntentAutomaton.hpp"
+#include "intent/utils/Logger.hpp"
+#include "intent/utils/RegexMatcher.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+
+namespace intent {
+namespace {
+
+const int DEAD_STATE = -1;
+const int NO_INTENT = -1;
+
+/**
+ * \brief Non deterministic automaton built with Thompson's construction.
+ */
+struct Nfa {
+  struct Node {
+    Node() : acceptedIntent(NO_INTENT) {}
+
+    std::vector<int> epsilons;
+    // Pairs of (column, target node).
+    std::vector<std::pair<int, int>> moves;
+    IntentAutomaton::IntentRef acceptedIntent;
+  };
+
+  struct Fragment {
+    int start;
+    int end;
+  };
+
+  int addNode() {
+    nodes.push_back(Node());
+    return nodes.size() - 1;
+  }
+
+  void addEpsilon(int from, int to) { nodes[from].epsilons.push_back(to); }
+
+  void addMove(int from, int column, int to) {
+    nodes[from].moves.push_back(std::make_pair(column, to));
+  }
+
+  std::vector<Node> nodes;
+};
+
+bool isMarker(int entity, char marker) {
+  return RegexMatcher::isEntityRegexMarker(entity) &&
+         RegexMatcher::REGEX_MARKERS[0xFFFF - entity] == marker;
+}
+
+bool isLiteral(int entity) {
+  return entity >= 0 && !RegexMatcher::isEntityRegexMarker(entity);
+}
+
+/**
+ * \brief A plain intent is a sequence of entities without any regex marker.
+ */
+bool isPlain(const IntentModel::Intent& intent) {
+  return std::all_of(intent.entities.begin(), intent.entities.end(),
+                     isLiteral);
+}
+
+/**
+ * \brief Recursive descent parser turning the entities of an intent into a
+ * fragment of the NFA.
+ *
+ * alternation := concatenation ('|' concatenation)*
+ * concatenation := repetition*
+ * repetition := atom '*'*
+ * atom := entity | '(' alternation ')' | '[' entity+ ']'
+ */
+class PatternParser {
+ public:
+  PatternParser(const std::vector<int>& entities,
+                const std::vector<int>& columnByEntityId, Nfa& nfa)
+      : m_entities(entities),
+        m_columnByEntityId(columnByEntityId),
+        m_nfa(nfa),
+        m_pos(0) {}
+
+  bool parse(Nfa::Fragment& fragment) {
+    return parseAlternation(fragment) && m_pos == m_entities.size();
+  }
+
+ private:
+  bool peek(char marker) const {
+    return m_pos < m_entities.size() && isMarker(m_entities[m_pos], marker);
+  }
+
+  bool consume(char marker) {
+    if (!peek(marker)) return false;
+    ++m_pos;
+    return true;
+  }
+
+  bool parseAlternation(Nfa::Fragment& fragment) {
+    if (!parseConcatenation(fragment)) return false;
+
+    while (consume('|')) {
+      Nfa::Fragment alternative;
+      if (!parseConcatenation(alternative)) return false;
+
+      Nfa::Fragment merged = {m_nfa.addNode(), m_nfa.addNode()};
+      m_nfa.addEpsilon(merged.start, fragment.start);
+      m_nfa.addEpsilon(merged.start, alternative.start);
+      m_nfa.addEpsilon(fragment.end, merged.end);
+      m_nfa.addEpsilon(alternative.end, merged.end);
+      fragment = merged;
+    }
+    return true;
+  }
+
+  bool parseConcatenation(Nfa::Fragment& fragment) {
+    fragment.start = fragment.end = m_nfa.addNode();
+    while (m_pos < m_entities.size() && !peek('|') && !peek(')')) {
+      Nfa::Fragment next;
+      if (!parseRepetition(next)) return false;
+      m_nfa.addEpsilon(fragment.end, next.start);
+      fragment.end = next.end;
+    }
+    return true;
+  }
+
+  bool parseRepetition(Nfa::Fragment& fragment) {
+    if (!parseAtom(fragment)) return false;
+
+    while (consume('*')) {
+      Nfa::Fragment repeated = {m_nfa.addNode(), m_nfa.addNode()};
+      m_nfa.addEpsilon(repeated.start, fragment.start);
+      m_nfa.addEpsilon(repeated.start, repeated.end);
+      m_nfa.addEpsilon(fragment.end, fragment.start);
+      m_nfa.addEpsilon(fragment.end, repeated.end);
+      fragment = repeated;
+    }
+    return true;
+  }
+
+  bool parseAtom(Nfa::Fragment& fragment) {
+    if (consume('(')) {
+      return parseAlternation(fragment) && consume(')');
+    }
+
+    fragment.start = m_nfa.addNode();
+    fragment.end = m_nfa.addNode();
+
+    if (consume('[')) {
+      int column = -1;
+      bool empty = true;
+      while (!consume(']')) {
+        if (!literalColumn(column)) return false;
+        m_nfa.addMove(fragment.start, column, fragment.end);
+        empty = false;
+      }
+      return !empty;
+    }
+
+    int column = -1;
+    if (!literalColumn(column)) return false;
+    m_nfa.addMove(fragment.start, column, fragment.end);
+    return true;
+  }
+
+  bool literalColumn(int& column) {
+    if (m_pos >= m_entities.size()) return false;
+
+    int entity = m_entities[m_pos];
+    if (RegexMatcher::isEntityRegexMarker(entity) || entity < 0) return false;
+
+    column = m_columnByEntityId[entity];
+    ++m_pos;
+    return true;
+  }
+
+  const std::vector<int>& m_entities;
+  const std::vector<int>& m_columnByEntityId;
+  Nfa& m_nfa;
+  size_t m_pos;
+};
+
+void epsilonClosure(const Nfa& nfa, std::vector<int>& nodes) {
+  std::vector<bool> visited(nfa.nodes.size(), false);
+  std::vector<int> stack(nodes);
+  nodes.clear();
+
+  while (!stack.empty()) {
+    int node = stack.back();
+    stack.pop_back();
+    if (visited[node]) continue;
+
+    visited[node] = true;
+    nodes.push_back(node);
+    std::copy(nfa.nodes[node].epsilons.begin(), nfa.nodes[node].epsilons.end(),
+              std::back_inserter(stack));
+  }
+  std::sort(nodes.begin(), nodes.end());
+}
+
+void buildColumns(const IntentModel::IntentIndex& intentIndex,
+                  std::vector<int>& columnByEntityId, int& columnCount) {
+  std::vector<int> entities;
+  for (const IntentModel::IntentIndex::value_type& p : intentIndex) {
+    if (isPlain(p.second)) continue;
+    std::copy_if(p.second.entities.begin(), p.second.entities.end(),
+                 std::back_inserter(entities), isLiteral);
+  }
+  std::sort(entities.begin(), entities.end());
+  entities.erase(std::unique(entities.begin(), entities.end()),
+                 entities.end());
+
+  columnByEntityId.assign(entities.empty() ? 0 : entities.back() + 1, -1);
+  columnCount = 0;
+  for (int entity : entities) columnByEntityId[entity] = columnCount++;
+}
+}  // anonymous
+
+IntentAutomaton::IntentAutomaton() : m_columnCount(0), m_acceptOffsets(2, 0) {}
+
+IntentAutomaton::IntentAutomaton(const IntentModel::IntentIndex& intentIndex)
+    : m_columnCount(0) {
+  compile(intentIndex);
+}
+
+void IntentAutomaton::compile(const IntentModel::IntentIndex& intentIndex) {
+  m_intents.clear();
+  m_plainIntents.clear();
+  m_transitions.clear();
+  m_acceptOffsets.clear();
+  m_acceptingIntents.clear();
+
+  buildColumns(intentIndex, m_columnByEntityId, m_columnCount);
+
+  Nfa nfa;
+  int nfaStart = nfa.addNode();
+  for (IntentModel::IntentIndex::const_iterator it = intentIndex.begin();
+       it != intentIndex.end(); ++it) {
+    const IntentModel::IntentIndex::value_type& p = *it;
+    IntentRef intentRef = m_intents.size();
+    m_intents.push_back(it);
+
+    // The references are pushed in increasing order, the lists stay sorted.
+    if (isPlain(p.second)) {
+      m_plainIntents[p.second.entities].push_back(intentRef);
+      continue;
+    }
+
+    Nfa::Fragment fragment;
+    PatternParser parser(p.second.entities, m_columnByEntityId, nfa);
+    if (!parser.parse(fragment)) {
+      INTENT_LOG_WARNING() << "The intent \"" + p.first +
+                                  "\" is malformed and will never match.";
+      continue;
+    }
+    nfa.addEpsilon(nfaStart, fragment.start);
+    nfa.nodes[fragment.end].acceptedIntent = intentRef;
+  }
+
+  // Subset construction. DFA states are numbered in discovery order so that
+  // the initial state is 0.
+  std::map<std::vector<int>, int> stateByNodes;
+  std::vector<std::vector<int>> nodesByState(1, std::vector<int>(1, nfaStart));
+  epsilonClosure(nfa, nodesByState[0]);
+  stateByNodes[nodesByState[0]] = 0;
+  m_transitions.assign(m_columnCount, DEAD_STATE);
+  m_acceptOffsets.push_back(0);
+
+  for (size_t state = 0; state < nodesByState.size(); ++state) {
+    std::map<int, std::vector<int>> targetsByColumn;
+    IntentRefs accepted;
+    for (int node : nodesByState[state]) {
+      const Nfa::Node& nfaNode = nfa.nodes[node];
+      for (const std::pair<int, int>& move : nfaNode.moves)
+        targetsByColumn[move.first].push_back(move.second);
+      if (nfaNode.acceptedIntent != NO_INTENT)
+        accepted.push_back(nfaNode.acceptedIntent);
+    }
+
+    std::sort(accepted.begin(), accepted.end());
+    m_acceptingIntents.insert(m_acceptingIntents.end(), accepted.begin(),
+                              accepted.end());
+    m_acceptOffsets.push_back(m_acceptingIntents.size());
+
+    for (std::pair<const int, std::vector<int>>& p : targetsByColumn) {
+      epsilonClosure(nfa, p.second);
+      std::map<std::vector<int>, int>::const_iterator it =
+          stateByNodes.find(p.second);
+      int target;
+      if (it == stateByNodes.end()) {
+        target = nodesByState.size();
+        stateByNodes[p.second] = target;
+        nodesByState.push_back(p.second);
+        m_transitions.resize(m_transitions.size() + m_columnCount, DEAD_STATE);
+      } else {
+        target = it->second;
+      }
+      m_transitions[state * m_columnCount + p.first] = target;
+    }
+  }
+
+  INTENT_LOG_DEBUG() << "Intent automaton compiled with " +
+                            std::to_string(stateCount()) + " states for " +
+                            std::to_string(m_intents.size()) + " intents, " +
+                            std::to_string(m_plainIntents.size()) +
+                            " plain sequences being hashed.";
+}
+
+int IntentAutomaton::step(int state, int entityId) const {
+  if (entityId < 0 ||
+      static_cast<size_t>(entityId) >= m_columnByEntityId.size())
+    return DEAD_STATE;
+
+  int column = m_columnByEntityId[entityId];
+  if (column < 0) return DEAD_STATE;
+  return m_transitions[state * m_columnCount + column];
+}
+
+void IntentAutomaton::matchPatterns(const std::vector<int>& entityIds,
+                                    IntentRefs& acceptingIntents) const {
+  int state = 0;
+  for (int entityId : entityIds) {
+    state = step(state, entityId);
+    if (state == DEAD_STATE) return;
+  }
+
+  acceptingIntents.assign(m_acceptingIntents.begin() + m_acceptOffsets[state],
+                          m_acceptingIntents.begin() +
+                              m_acceptOffsets[state + 1]);
+}
+
+void IntentAutomaton::match(const std::vector<int>& entityIds,
+                            IntentRefs& acceptingIntents) const {
+  acceptingIntents.clear();
+  matchPatterns(entityIds, acceptingIntents);
+
+  PlainIntents::const_iterator plainIntents = m_plainIntents.find(entityIds);
+  if (plainIntents == m_plainIntents.end()) return;
+
+  if (acceptingIntents.empty()) {
+    acceptingIntents = plainIntents->second;
+    return;
+  }
+
+  // Both lists are sorted and disjoint.
+  IntentRefs patternIntents;
+  patternIntents.swap(acceptingIntents);
+  std::merge(patternIntents.begin(), patternIntents.end(),
+             plainIntents->second.begin(), plainIntents->second.end(),
+             std::back_inserter(acceptingIntents));
+}
+
+void IntentAutomaton::match(const std::vector<int>& entityIds,
+                            const IntentRefs& allowedIntents,
+                            IntentRefs& acceptingIntents) const {
+  IntentRefs matchingIntents;
+  match(entityIds, matchingIntents);
+
+  acceptingIntents.clear();
+  std::set_intersection(matchingIntents.begin(), matchingIntents.end(),
+                        allowedIntents.begin(), allowedIntents.end(),
+                        std::back_inserter(acceptingIntents));
+}
+
+IntentAutomaton::IntentRef IntentAutomaton::findIntent(
+    const IntentModel::IndexType& intentId) const {
+  // The references follow the order of the ids in the index.
+  std::vector<IntentModel::IntentIndex::const_iterator>::const_iterator it =
+      std::lower_bound(m_intents.begin(), m_intents.end(), intentId,
+                       [](IntentModel::IntentIndex::const_iterator intent,
+                          const IntentModel::IndexType& id) {
+                         return intent->first < id;
+                       });
+  if (it == m_intents.end() || (*it)->first != intentId) return NO_INTENT;
+  return it - m_intents.begin();
+}
+}
@@ -39,38 +39,36 @@ WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
 CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 #include "intent/intent_service/IntentEncoder.hpp"
-#include "intent/intent_service/TermIndex.hpp"
 #include "intent/utils/RegexMatcher.hpp"
-#include "intent/utils/TrigramHelper.hpp"
-
-#include <sstream>
-#include <iostream>
-#include <algorithm>
 
 namespace intent {
 
 std::string IntentEncoder::encode(const std::vector<int>& entities) {
-  std::stringstream streamresult;
-  std::for_each(entities.begin(), entities.end(),
-                [&streamresult](const int& entity) {
-                  std::string toAppend;
+  static const char HEX_DIGITS[] = "0123456789abcdef";
+
+  std::string result;
+  result.reserve(4 * entities.size());
+  for (const int entity : entities) {
+    // leave the regex markers untouched
+    if (RegexMatcher::isEntityRegexMarker(entity)) {
+      result += RegexMatcher::REGEX_MARKERS[0xFFFF - entity];
+      continue;
+    }
 
-                  std::stringstream stream;
-                  // leave the regex markers untouched
-                  if (RegexMatcher::isEntityRegexMarker(entity)) {
-                    stream << RegexMatcher::REGEX_MARKERS[0xFFFF - entity];
-                    toAppend = stream.str();
-                  }
-                  // encode others int to hex strings (padded up to 4 chars)
-                  else {
-                    stream << std::hex << entity;
-                    toAppend = stream.str();
-                    TrigramHelper::padLeft(toAppend, 4, '0');
-                  }
+    // encode others int to hex strings (padded up to 4 chars)
+    char digits[2 * sizeof(unsigned int)];
+    char* end = digits + sizeof(digits);
+    char* begin = end;
+    unsigned int value = static_cast<unsigned int>(entity);
+    do {
+      *--begin = HEX_DIGITS[value & 0xF];
+      value >>= 4;
+    } while (value != 0);
 
-                  streamresult << toAppend;
-                });
-  return streamresult.str();
+    if (end - begin < 4) result.append(4 - (end - begin), '0');
+    result.append(begin, end);
+  }
+  return result;
 }
 
 std::string IntentEncoder::encode(const IntentModel::Intent& intent) {
@@ -43,8 +43,6 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 //
 
 #include "intent/intent_service/IntentMatcher.hpp"
-#include "intent/utils/RegexMatcher.hpp"
-#include "intent/intent_service/IntentEncoder.hpp"
 
 #include <algorithm>
 #include <iterator>
@@ -61,21 +59,6 @@ void extractEntityIds(const EntitiesMatcher::Variables& variables,
                 });
 }
 
-void matchIntents(
-    const IntentModel::IntentIndex& intentByIdIndex,
-    const std::vector<int>& entityIds,
-    std::vector<std::pair<IntentModel::IndexType, IntentModel::Intent>>&
-        foundIntents) {
-  std::copy_if(
-      intentByIdIndex.begin(), intentByIdIndex.end(),
-      std::back_inserter(foundIntents),
-      [&entityIds](
-          const std::pair<IntentModel::IndexType, IntentModel::Intent>& p) {
-        return RegexMatcher::match(IntentEncoder::encode(entityIds),
-                                   "^" + IntentEncoder::encode(p.second) + "$");
-      });
-}
-
 void completeMatch(IntentMatcher::EntityMatch& entityMatch,
                    const EntitiesMatcher::Variable& variable,
                    const DictionaryModel& dico) {
@@ -97,7 +80,7 @@ struct MatchNamer {
       : m_entityToNames(entityToNames) {}
 
   void operator()(IntentMatcher::EntityMatch& match) {
-    std::queue<std::string>& variableNames = m_entityToNames[match.entity];
+    IntentModel::VariableNames& variableNames = m_entityToNames[match.entity];
     if (!variableNames.empty()) {
       match.name = variableNames.front();
       variableNames.pop();
@@ -130,25 +113,19 @@ void fillIntentResult(const DictionaryModel& dictionaryModel,
       });
 }
 
-IntentMatcher::IntentResult IntentMatcher::match(
+IntentMatcher::IntentResult buildIntentResult(
     const DictionaryModel& dictionaryModel,
     const EntitiesMatcher::Variables& variables,
-    const IntentModel::IntentIndex& intentByIdIndex) {
+    const IntentAutomaton& intentAutomaton,
+    const IntentAutomaton::IntentRefs& foundIntents) {
   IntentMatcher::IntentResult intentResult;
 
-  std::vector<int> entityIds;
-  extractEntityIds(variables, entityIds);
-
-  std::vector<std::pair<IntentModel::IndexType, IntentModel::Intent>>
-      foundIntents;
-  matchIntents(intentByIdIndex, entityIds, foundIntents);
-
   if (foundIntents.size() == 1) {
     intentResult.found = true;
-    intentResult.intent.intentId = foundIntents[0].first;
+    intentResult.intent.intentId = intentAutomaton.getIntentId(foundIntents[0]);
 
     IntentModel::EntityToNames entityToVariableNames =
-        foundIntents[0].second.entityToVariableNames;
+        intentAutomaton.getIntent(foundIntents[0]).entityToVariableNames;
     fillIntentResult(dictionaryModel, intentResult, variables,
                      entityToVariableNames);
   }
@@ -156,6 +133,35 @@ IntentMatcher::IntentResult IntentMatcher::match(
   return intentResult;
 }
 
+IntentMatcher::IntentResult IntentMatcher::match(
+    const DictionaryModel& dictionaryModel,
+    const EntitiesMatcher::Variables& variables,
+    const IntentAutomaton& intentAutomaton) {
+  std::vector<int> entityIds;
+  extractEntityIds(variables, entityIds);
+
+  IntentAutomaton::IntentRefs foundIntents;
+  intentAutomaton.match(entityIds, foundIntents);
+
+  return buildIntentResult(dictionaryModel, variables, intentAutomaton,
+                           foundIntents);
+}
+
+IntentMatcher::IntentResult IntentMatcher::match(
+    const DictionaryModel& dictionaryModel,
+    const EntitiesMatcher::Variables& variables,
+    const IntentAutomaton& intentAutomaton,
+    const IntentAutomaton::IntentRefs& allowedIntents) {
+  std::vector<int> entityIds;
+  extractEntityIds(variables, entityIds);
+
+  IntentAutomaton::IntentRefs foundIntents;
+  intentAutomaton.match(entityIds, allowedIntents, foundIntents);
+
+  return buildIntentResult(dictionaryModel, variables, intentAutomaton,
+                           foundIntents);
+}
+
 IntentMatcher::Intent IntentMatcher::buildFullMatchIntent(
     const std::string& message) {
   Intent intent;
@@ -44,11 +44,19 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "intent/utils/Deserializer.hpp"
 #include "intent/utils/Logger.hpp"
 
+#include <algorithm>
 #include <fstream>
 
 namespace intent {
 IntentService::IntentService(const IntentServiceModel& intentServiceModel)
-    : m_intentServiceModel(intentServiceModel) {}
+    : m_intentServiceModel(intentServiceModel) {
+  if (m_intentServiceModel.dictionaryModel)
+    m_sentenceTokenizer = std::make_shared<const SentenceTokenizer>(
+        *m_intentServiceModel.dictionaryModel);
+  if (m_intentServiceModel.intentModel)
+    m_intentAutomaton.compile(
+        m_intentServiceModel.intentModel->intentsByIntentId);
+}
 
 std::stringstream logResult(IntentService::Result& result) {
   std::stringstream ss;
@@ -60,32 +68,70 @@ std::stringstream logResult(IntentService::Result& result) {
   return ss;
 }
 
-IntentMatcher::IntentResult IntentService::resolveIntent(
-    const std::string& input, const DictionaryModel& dictionaryModel,
-    const IntentModel::IntentIndex& intentByIdIndex) const {
-  INTENT_LOG_INFO() << "Look for intent in \"" + input + "\"";
+EntitiesMatcher::Variables matchEntities(
+    boost::string_ref input, const DictionaryModel& dictionaryModel,
+    const SentenceTokenizer& sentenceTokenizer) {
+  INTENT_LOG_INFO() << "Look for intent in \"" << input << "\"";
 
-  intent::Tokenizer::Tokens tokens;
-  SentenceTokenizer sentenceTokenizer(dictionaryModel);
+  // Each thread reuses its own buffer of tokens.
+  static thread_local intent::Tokenizer::TokenViews tokens;
+  tokens.clear();
   sentenceTokenizer.tokenize(input, tokens);
 
   // Try to match entities
   intent::EntitiesMatcher entitiesMatcher;
+  return entitiesMatcher.match(tokens, dictionaryModel);
+}
+
+void logIntentResult(IntentService::Result& result) {
+  INTENT_LOG_TRACE() << "Result = " << result;
+  INTENT_LOG_INFO() << logResult(result);
+}
+
+IntentMatcher::IntentResult IntentService::resolveIntent(
+    boost::string_ref input, const DictionaryModel& dictionaryModel,
+    const IntentAutomaton& intentAutomaton) const {
   EntitiesMatcher::Variables variables =
-      entitiesMatcher.match(tokens, dictionaryModel);
+      matchEntities(input, dictionaryModel, *m_sentenceTokenizer);
 
   IntentService::Result result =
-      IntentMatcher::match(dictionaryModel, variables, intentByIdIndex);
+      IntentMatcher::match(dictionaryModel, variables, intentAutomaton);
 
-  INTENT_LOG_TRACE() << "Result = " << result;
-  INTENT_LOG_INFO() << logResult(result);
+  logIntentResult(result);
+  return result;
+}
 
+IntentMatcher::IntentResult IntentService::resolveIntent(
+    boost::string_ref input, const DictionaryModel& dictionaryModel,
+    const IntentAutomaton& intentAutomaton,
+    const IntentAutomaton::IntentRefs& allowedIntents) const {
+  EntitiesMatcher::Variables variables =
+      matchEntities(input, dictionaryModel, *m_sentenceTokenizer);
+
+  IntentService::Result result = IntentMatcher::match(
+      dictionaryModel, variables, intentAutomaton, allowedIntents);
+
+  logIntentResult(result);
   return result;
 }
 
-IntentService::Result IntentService::evaluate(const std::string& input) const {
+IntentService::Result IntentService::evaluate(boost::string_ref input) const {
   return resolveIntent(input, *m_intentServiceModel.dictionaryModel,
-                       m_intentServiceModel.intentModel->intentsByIntentId);
+                       m_intentAutomaton);
+}
+
+IntentService::Results IntentService::evaluateBatch(
+    const Inputs& inputs, ThreadPool& threadPool) const {
+  Results results(inputs.size());
+  // Several ranges per worker let the fast workers steal from the slow ones.
+  size_t grainSize =
+      std::max<size_t>(1, inputs.size() / (8 * threadPool.size()));
+  threadPool.parallelFor(inputs.size(), grainSize,
+                         [this, &inputs, &results](size_t begin, size_t end) {
+                           for (size_t i = begin; i < end; ++i)
+                             results[i] = evaluate(inputs[i]);
+                         });
+  return results;
 }
 
 std::ostream& operator<<(std::ostream& os,
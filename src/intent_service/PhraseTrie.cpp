@@ -0,0 +1,257 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "intent/intent_service/PhraseTrie.hpp"
+#include "intent/utils/BinaryStream.hpp"
+#include "intent/utils/SingleCharacterDelimiterTokenizer.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+namespace intent {
+namespace {
+/**
+ * \brief Order a lowercase word of the trie before a word of a sentence,
+ * lowering the latter on the fly.
+ */
+int compareLowered(PhraseTrie::Word lowered, PhraseTrie::Word word) {
+  size_t size = std::min(lowered.size(), word.size());
+  for (size_t i = 0; i < size; ++i) {
+    unsigned char a = static_cast<unsigned char>(lowered[i]);
+    unsigned char b = static_cast<unsigned char>(::tolower(word[i]));
+    if (a != b) return a < b ? -1 : 1;
+  }
+  if (lowered.size() == word.size()) return 0;
+  return lowered.size() < word.size() ? -1 : 1;
+}
+
+bool isLoweredBefore(const std::pair<std::string, uint32_t>& child,
+                     PhraseTrie::Word word) {
+  return compareLowered(child.first, word) < 0;
+}
+
+bool isChildBefore(const std::pair<std::string, uint32_t>& a,
+                   const std::pair<std::string, uint32_t>& b) {
+  return compareLowered(a.first, b.first) < 0;
+}
+}  // anonymous
+
+PhraseTrie::PhraseTrie() : m_nodes(1), m_size(0) { pack(); }
+
+std::string PhraseTrie::pendingKey(NodeId nodeId, Word word) {
+  std::string key(reinterpret_cast<const char*>(&nodeId), sizeof(nodeId));
+  key.append(word.begin(), word.end());
+  return key;
+}
+
+void PhraseTrie::insert(const std::string& phrase, int value) {
+  SingleCharacterDelimiterTokenizer::TokenViews words;
+  SingleCharacterDelimiterTokenizer::tokenize(phrase, " ", words);
+  if (words.empty()) return;
+  if (m_nodes.empty()) unpack();
+
+  NodeId nodeId = 0;
+  for (const Word& word : words) {
+    Node& node = m_nodes[nodeId];
+    std::vector<Child>::iterator sortedEnd =
+        node.children.begin() + node.sortedChildren;
+    std::vector<Child>::iterator it = std::lower_bound(
+        node.children.begin(), sortedEnd, word, isLoweredBefore);
+
+    if (it != sortedEnd && compareLowered(it->first, word) == 0) {
+      nodeId = it->second;
+      continue;
+    }
+
+    // Sorting the children on every insertion would be quadratic in the
+    // number of words of a node, they are sorted once by pack().
+    std::string key = pendingKey(nodeId, word);
+    std::unordered_map<std::string, NodeId>::const_iterator pendingIt =
+        m_pendingChildren.find(key);
+    if (pendingIt != m_pendingChildren.end()) {
+      nodeId = pendingIt->second;
+      continue;
+    }
+
+    if (node.children.size() == node.sortedChildren)
+      m_unsortedNodes.push_back(nodeId);
+    NodeId childId = static_cast<NodeId>(m_nodes.size());
+    node.children.push_back(Child(word.to_string(), childId));
+    m_pendingChildren[key] = childId;
+    // The reference to node is invalidated by the reallocation.
+    m_nodes.push_back(Node());
+    nodeId = childId;
+  }
+
+  if (m_nodes[nodeId].value == -1) ++m_size;
+  m_nodes[nodeId].value = value;
+}
+
+void PhraseTrie::pack() {
+  if (m_nodes.empty()) return;
+
+  for (NodeId nodeId : m_unsortedNodes) {
+    Node& node = m_nodes[nodeId];
+    std::vector<Child>::iterator sortedEnd =
+        node.children.begin() + node.sortedChildren;
+    std::sort(sortedEnd, node.children.end(), isChildBefore);
+    std::inplace_merge(node.children.begin(), sortedEnd, node.children.end(),
+                       isChildBefore);
+  }
+  m_unsortedNodes.clear();
+  std::unordered_map<std::string, NodeId>().swap(m_pendingChildren);
+
+  std::vector<int32_t> values;
+  std::vector<uint32_t> childBegin(1, 0);
+  std::vector<NodeId> childNodes;
+  std::vector<uint32_t> wordBegin(1, 0);
+  std::vector<char> words;
+  values.reserve(m_nodes.size());
+  childBegin.reserve(m_nodes.size() + 1);
+  for (const Node& node : m_nodes) {
+    values.push_back(node.value);
+    for (const Child& child : node.children) {
+      childNodes.push_back(child.second);
+      words.insert(words.end(), child.first.begin(), child.first.end());
+      wordBegin.push_back(words.size());
+    }
+    childBegin.push_back(childNodes.size());
+  }
+  std::vector<Node>().swap(m_nodes);
+
+  m_values.assign(std::move(values));
+  m_childBegin.assign(std::move(childBegin));
+  m_childNodes.assign(std::move(childNodes));
+  m_wordBegin.assign(std::move(wordBegin));
+  m_words.assign(std::move(words));
+}
+
+void PhraseTrie::unpack() {
+  m_nodes.assign(m_values.size(), Node());
+  for (NodeId nodeId = 0; nodeId < m_nodes.size(); ++nodeId) {
+    Node& node = m_nodes[nodeId];
+    node.value = m_values[nodeId];
+    for (uint32_t child = m_childBegin[nodeId];
+         child < m_childBegin[nodeId + 1]; ++child) {
+      node.children.push_back(
+          Child(childWord(child).to_string(), m_childNodes[child]));
+    }
+    node.sortedChildren = node.children.size();
+  }
+
+  m_values.clear();
+  m_childBegin.clear();
+  m_childNodes.clear();
+  m_wordBegin.clear();
+  m_words.clear();
+}
+
+PhraseTrie::Word PhraseTrie::childWord(uint32_t child) const {
+  return Word(m_words.data() + m_wordBegin[child],
+              m_wordBegin[child + 1] - m_wordBegin[child]);
+}
+
+bool PhraseTrie::findChild(NodeId& nodeId, Word word) const {
+  uint32_t first = m_childBegin[nodeId];
+  uint32_t count = m_childBegin[nodeId + 1] - first;
+  while (count > 0) {
+    uint32_t step = count / 2;
+    if (compareLowered(childWord(first + step), word) < 0) {
+      first += step + 1;
+      count -= step + 1;
+    } else {
+      count = step;
+    }
+  }
+  if (first == m_childBegin[nodeId + 1] ||
+      compareLowered(childWord(first), word) != 0)
+    return false;
+  nodeId = m_childNodes[first];
+  return true;
+}
+
+size_t PhraseTrie::longestMatch(WordIterator begin, WordIterator end,
+                                int& value) const {
+  size_t longest = 0;
+  if (m_values.empty()) return longest;
+
+  NodeId nodeId = 0;
+  for (WordIterator it = begin; it != end; ++it) {
+    if (!findChild(nodeId, *it)) break;
+    if (m_values[nodeId] != -1) {
+      longest = it - begin + 1;
+      value = m_values[nodeId];
+    }
+  }
+  return longest;
+}
+
+void PhraseTrie::writeTo(BinaryWriter& writer) const {
+  writer.write<uint64_t>(m_size);
+  writer.writeArray(m_values);
+  writer.writeArray(m_childBegin);
+  writer.writeArray(m_childNodes);
+  writer.writeArray(m_wordBegin);
+  writer.writeArray(m_words);
+}
+
+void PhraseTrie::readFrom(BinaryReader& reader) {
+  m_size = reader.read<uint64_t>();
+  reader.readArray(m_values);
+  reader.readArray(m_childBegin);
+  reader.readArray(m_childNodes);
+  reader.readArray(m_wordBegin);
+  reader.readArray(m_words);
+
+  // The lookups trust the offsets and the node ids, check them once here.
+  bool consistent = !m_values.empty() &&
+                    m_childBegin.size() == m_values.size() + 1 &&
+                    isRangeBounds(m_childBegin, m_childNodes.size()) &&
+                    m_wordBegin.size() == m_childNodes.size() + 1 &&
+                    isRangeBounds(m_wordBegin, m_words.size());
+  for (size_t i = 0; consistent && i < m_childNodes.size(); ++i)
+    consistent = m_childNodes[i] < m_values.size();
+  if (!consistent) throw BinaryStreamException("Inconsistent phrase trie");
+
+  std::vector<Node>().swap(m_nodes);
+  m_pendingChildren.clear();
+  m_unsortedNodes.clear();
+}
+}
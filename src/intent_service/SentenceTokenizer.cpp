@@ -40,20 +40,26 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 #include "intent/intent_service/SentenceTokenizer.hpp"
 
-#include "boost/range/algorithm/copy.hpp"
-#include "boost/range/adaptor/map.hpp"
-
-#include "intent/utils/Tokenizer.hpp"
-
 namespace intent {
-SentenceTokenizer::SentenceTokenizer(const DictionaryModel& dictionaryModel) {
-  boost::copy(dictionaryModel.regexesByEntityId | boost::adaptors::map_keys,
-              std::back_inserter(m_regexpList));
+namespace {
+Tokenizer::Regexes extractRegexes(const DictionaryModel& dictionaryModel) {
+  Tokenizer::Regexes regexes;
+  for (const DictionaryModel::Regex& regex : dictionaryModel.regexes)
+    regexes.push_back(regex.compiledRegex);
+  return regexes;
 }
+}  // anonymous
+
+SentenceTokenizer::SentenceTokenizer(const DictionaryModel& dictionaryModel)
+    : m_tokenizer(".,:;!? '", extractRegexes(dictionaryModel)) {}
 
-void SentenceTokenizer::tokenize(const std::string sentence,
+void SentenceTokenizer::tokenize(const std::string& sentence,
                                  std::vector<std::string>& tokens) const {
-  Tokenizer tokenizer(".,:;!? '", m_regexpList);
-  tokenizer.tokenize(sentence, tokens);
+  m_tokenizer.tokenize(sentence, tokens);
+}
+
+void SentenceTokenizer::tokenize(boost::string_ref sentence,
+                                 Tokenizer::TokenViews& tokens) const {
+  m_tokenizer.tokenize(sentence, tokens);
 }
 }
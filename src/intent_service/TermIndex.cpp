@@ -44,94 +44,142 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <algorithm>
 #include "intent/intent_service/DictionaryModel.hpp"
 #include "intent/intent_service/TermIndex.hpp"
+#include "intent/utils/BinaryStream.hpp"
 #include "intent/utils/Levenshtein.hpp"
+#include "intent/utils/ScoreKernels.hpp"
 #include "intent/utils/SingleCharacterDelimiterTokenizer.hpp"
 #include "intent/utils/Tokenizer.hpp"
 #include "intent/utils/TrigramHelper.hpp"
 #include <unordered_map>
 #include <cassert>
+#include <iterator>
+#include <numeric>
 
 namespace intent {
 
 namespace {
 
+typedef TrigramIndex::Posting StagedTrigram;
+
 struct pushTermIdForTrigram {
-  pushTermIdForTrigram(TrigramIndex& trigramIndex, int termId)
-      : trigramIndex(trigramIndex), termId(termId) {}
+  pushTermIdForTrigram(std::vector<StagedTrigram>& stagedTrigrams, int termId)
+      : stagedTrigrams(stagedTrigrams), termId(termId) {}
 
   void operator()(const std::string& trigram) {
-    trigramIndex[trigram].insert(termId);
+    TrigramIndex::TrigramCode code;
+    if (TrigramIndex::encode(trigram, code))
+      stagedTrigrams.push_back(StagedTrigram(code, termId));
   }
 
-  TrigramIndex& trigramIndex;
+  std::vector<StagedTrigram>& stagedTrigrams;
   int termId;
 };
 
-struct evaluateTrigram {
-  evaluateTrigram(const TrigramIndex& trigramIndex,
-                  std::unordered_map<int, int>& scores)
-      : trigramIndex(trigramIndex), scores(scores) {}
+/**
+ * \brief Trigram hit counts of the candidate slots of a token.
+ *
+ * The board is reused from one lookup to the other. Instead of being cleared,
+ * it is invalidated by bumping the epoch: the entry of a slot is only valid if
+ * it is tagged with the current epoch. The scores of the touched slots are
+ * kept contiguous so that finding the best candidates is linear in the number
+ * of postings visited.
+ */
+class ScoreBoard {
+ public:
+  ScoreBoard() : m_epoch(0) {}
+
+  void reset(size_t slotCount) {
+    if (m_entries.size() < slotCount) m_entries.resize(slotCount);
+    if (++m_epoch == 0) {
+      std::fill(m_entries.begin(), m_entries.end(), Entry());
+      m_epoch = 1;
+    }
+    m_touchedSlots.clear();
+    m_scores.clear();
+    m_bestSlots.clear();
+  }
 
-  void operator()(const std::string& trigram) {
-    TrigramIndex::const_iterator it = trigramIndex.find(trigram);
-    if (it != trigramIndex.end()) {
-      std::set<int> termIds = it->second;
-      for (std::set<int>::const_iterator termId = termIds.begin();
-           termId != termIds.end(); ++termId) {
-        ++scores[*termId];
-      }
+  void increment(TrigramIndex::Slot slot) {
+    Entry& entry = m_entries[slot];
+    if (entry.epoch != m_epoch) {
+      entry.epoch = m_epoch;
+      entry.position = m_scores.size();
+      m_touchedSlots.push_back(slot);
+      m_scores.push_back(0);
     }
+    ++m_scores[entry.position];
   }
 
-  const TrigramIndex& trigramIndex;
-  std::unordered_map<int, int>& scores;
-};
+  int32_t maxScore() const {
+    return ScoreKernels::max(m_scores.data(), m_scores.size());
+  }
 
-struct findMaxScore {
-  std::pair<int, std::set<int>> operator()(
-      std::pair<int, std::set<int>>& maxScoreTerms,
-      const std::pair<int, int>& score) {
-    if (score.second > maxScoreTerms.first) {
-      maxScoreTerms.second.clear();
-      maxScoreTerms.second.insert(score.first);
-      maxScoreTerms.first = score.second;
-    } else if (score.second == maxScoreTerms.first) {
-      maxScoreTerms.second.insert(score.first);
-    }
-    return maxScoreTerms;
+  /**
+   * \brief Returns the slots having the given score sorted in increasing order.
+   */
+  const std::vector<TrigramIndex::Slot>& slotsWithScore(int32_t score) {
+    ScoreKernels::findEqual(m_scores.data(), m_scores.size(), score,
+                            m_bestSlots);
+    for (TrigramIndex::Slot& bestSlot : m_bestSlots)
+      bestSlot = m_touchedSlots[bestSlot];
+    std::sort(m_bestSlots.begin(), m_bestSlots.end());
+    return m_bestSlots;
   }
+
+ private:
+  struct Entry {
+    Entry() : epoch(0), position(0) {}
+
+    uint32_t epoch;
+    uint32_t position;
+  };
+
+  uint32_t m_epoch;
+  std::vector<Entry> m_entries;
+  std::vector<TrigramIndex::Slot> m_touchedSlots;
+  std::vector<int32_t> m_scores;
+  std::vector<TrigramIndex::Slot> m_bestSlots;
 };
 
+ScoreBoard& threadScoreBoard() {
+  static thread_local ScoreBoard scoreBoard;
+  return scoreBoard;
+}
+
+/**
+ * \brief Calls visitor with the code of each trigram of a lowered token, like
+ * TrigramHelper::generateTrigrams would generate them.
+ */
+template <typename Visitor>
+void visitTrigramCodes(const std::string& loweredToken, Visitor visitor) {
+  const std::string::size_type size = loweredToken.size();
+  for (std::string::size_type i = 0; i < size; ++i) {
+    char trigram[3] = {i == 0 ? ' ' : loweredToken[i - 1], loweredToken[i],
+                       i + 1 == size ? ' ' : loweredToken[i + 1]};
+    visitor(static_cast<TrigramIndex::TrigramCode>(
+                static_cast<uint8_t>(trigram[0])) << 16 |
+            static_cast<TrigramIndex::TrigramCode>(
+                static_cast<uint8_t>(trigram[1])) << 8 |
+            static_cast<TrigramIndex::TrigramCode>(
+                static_cast<uint8_t>(trigram[2])));
+  }
+}
+
 struct pushAlias {
-  pushAlias(TrigramIndex& trigramIndex, const int termId)
-      : trigramIndex(trigramIndex), termId(termId) {}
+  pushAlias(std::vector<StagedTrigram>& stagedTrigrams, const int termId)
+      : stagedTrigrams(stagedTrigrams), termId(termId) {}
 
   void operator()(const std::string& alias) {
     std::vector<std::string> trigrams;
     TrigramHelper::generateTrigrams(alias, trigrams);
     std::for_each(trigrams.begin(), trigrams.end(),
-                  pushTermIdForTrigram(trigramIndex, termId));
+                  pushTermIdForTrigram(stagedTrigrams, termId));
   }
 
-  TrigramIndex& trigramIndex;
+  std::vector<StagedTrigram>& stagedTrigrams;
   const int termId;
 };
 
-struct TermFinderForId {
-  TermFinderForId(const std::unordered_map<int, Term>& index)
-      : m_index(index) {}
-
-  Term operator()(const int id) {
-    std::unordered_map<int, Term>::const_iterator potentialTerm =
-        m_index.find(id);
-    Term foundTerm;
-    if (potentialTerm != m_index.end()) foundTerm = potentialTerm->second;
-    return foundTerm;
-  }
-
-  const std::unordered_map<int, Term>& m_index;
-};
-
 bool isInvalidTerm(const Term& term) {
   return term.termId == -1 || term.entityId == -1;
 }
@@ -139,36 +187,40 @@ bool isInvalidTerm(const Term& term) {
 typedef std::unordered_map<std::string, std::string> AliasesToBuffered;
 
 struct ZipWithBuffer {
-  ZipWithBuffer(const std::vector<std::string>& buffer) : m_buffer(buffer) {}
+  ZipWithBuffer(TermIndex::TokenViews::const_iterator bufferBegin,
+                TermIndex::TokenViews::const_iterator bufferEnd)
+      : m_bufferBegin(bufferBegin),
+        m_bufferSize(std::distance(bufferBegin, bufferEnd)) {}
 
   AliasesToBuffered& operator()(AliasesToBuffered& aliases, const Term& term) {
-    Term::AliasIndex termAliases = term.alias;
-    aliases = operator()(aliases, term.lowerCaseTerm);
-    aliases = std::accumulate(termAliases.begin(), termAliases.end(), aliases,
-                              ZipWithBuffer(m_buffer));
+    operator()(aliases, term.lowerCaseTerm);
+    for (const std::string& alias : term.alias) operator()(aliases, alias);
     return aliases;
   }
 
   AliasesToBuffered& operator()(AliasesToBuffered& aliases,
                                 const std::string& alias) {
-    std::vector<std::string>::const_iterator bufferIt = m_buffer.begin();
-    std::vector<std::string>::const_iterator bufferEnd = m_buffer.end();
-
-    std::vector<std::string> tokens;
-    SingleCharacterDelimiterTokenizer::tokenize(alias, " ", tokens);
-
-    std::vector<std::string>::const_iterator tokenIt = tokens.begin();
-    for (; tokenIt != tokens.end() && bufferIt != m_buffer.end();
-         ++tokenIt, ++bufferIt) {
-      std::string lowered = *bufferIt;
-      std::transform(lowered.begin(), lowered.end(), lowered.begin(),
-                     ::tolower);
-      aliases[alias] += lowered + " ";
+    m_aliasTokens.clear();
+    SingleCharacterDelimiterTokenizer::tokenize(alias, " ", m_aliasTokens);
+    // An alias longer than the buffer would consume the words after it, like
+    // the next exact match of the sentence.
+    if (m_aliasTokens.empty() || m_aliasTokens.size() > m_bufferSize)
+      return aliases;
+
+    // Only as many words as the alias has are read from the buffer.
+    std::string& counterpart = aliases[alias];
+    TermIndex::TokenViews::const_iterator bufferIt = m_bufferBegin;
+    for (size_t i = 0; i < m_aliasTokens.size(); ++i, ++bufferIt) {
+      std::transform(bufferIt->begin(), bufferIt->end(),
+                     std::back_inserter(counterpart), ::tolower);
+      counterpart += " ";
     }
     return aliases;
   }
 
-  const std::vector<std::string>& m_buffer;
+  TermIndex::TokenViews::const_iterator m_bufferBegin;
+  size_t m_bufferSize;
+  SingleCharacterDelimiterTokenizer::TokenViews m_aliasTokens;
 };
 
 typedef std::unordered_map<std::string, Term> AliasToTerm;
@@ -186,12 +238,21 @@ struct IndexAliases {
 
 typedef std::pair<std::string, int> BestLevenshteinMatch;
 
+// The maximum distance between an alias and the text for them to match.
+const int MAX_LEVENSHTEIN_DISTANCE = 2;
+
 struct LevenshteinMinimizer {
   BestLevenshteinMatch operator()(
       const BestLevenshteinMatch& bestAliasMatch,
-      std::pair<std::string, std::string> aliasToCounterpart) const {
-    int distance = Levenshtein::distance(aliasToCounterpart.first,
-                                         aliasToCounterpart.second);
+      const AliasesToBuffered::value_type& aliasToCounterpart) const {
+    if (bestAliasMatch.second == 0) return bestAliasMatch;
+
+    // Only the distances that could improve on the best match and still be
+    // accepted need to be computed exactly.
+    unsigned int maxDistance =
+        std::min(bestAliasMatch.second - 1, MAX_LEVENSHTEIN_DISTANCE);
+    int distance = Levenshtein::distance(
+        aliasToCounterpart.first, aliasToCounterpart.second, maxDistance);
     if (distance < bestAliasMatch.second) {
       return BestLevenshteinMatch(aliasToCounterpart.first, distance);
     }
@@ -201,6 +262,180 @@ struct LevenshteinMinimizer {
 
 }  // anonymous
 
+TermIndex::TermIndex() : compacted(true) {}
+
+TermIndex::TermIndex(const TermIndex& that) : compacted(true) {
+  copyFrom(that);
+}
+
+TermIndex& TermIndex::operator=(const TermIndex& that) {
+  if (this != &that) copyFrom(that);
+  return *this;
+}
+
+void TermIndex::copyFrom(const TermIndex& that) {
+  std::lock_guard<std::mutex> lock(that.compactionMutex);
+  dictionary = that.dictionary;
+  stagedTrigrams = that.stagedTrigrams;
+  compacted = that.compacted.load();
+  termIds = that.termIds;
+  entityIds = that.entityIds;
+  termStringBegin = that.termStringBegin;
+  stringBegin = that.stringBegin;
+  strings = that.strings;
+  index = that.index;
+  phraseTrie = that.phraseTrie;
+}
+
+void TermIndex::compact() const {
+  if (compacted.load(std::memory_order_acquire)) return;
+
+  std::lock_guard<std::mutex> lock(compactionMutex);
+  if (compacted.load(std::memory_order_relaxed)) return;
+  pack();
+}
+
+void TermIndex::pack() const {
+  // The parts are packed one after the other, each staged part being released
+  // before the next one is packed to bound the peak memory.
+  phraseTrie.pack();
+
+  std::vector<const Term*> terms;
+  terms.reserve(dictionary.size());
+  for (const std::unordered_map<int, Term>::value_type& entry : dictionary)
+    terms.push_back(&entry.second);
+  std::sort(terms.begin(), terms.end(), [](const Term* a, const Term* b) {
+    return a->termId < b->termId;
+  });
+
+  std::vector<int32_t> packedTermIds;
+  std::vector<int32_t> packedEntityIds;
+  std::vector<uint32_t> packedTermStringBegin(1, 0);
+  std::vector<uint32_t> packedStringBegin(1, 0);
+  std::vector<char> packedStrings;
+  packedTermIds.reserve(terms.size());
+  packedEntityIds.reserve(terms.size());
+  packedTermStringBegin.reserve(terms.size() + 1);
+  auto pushString = [&packedStringBegin,
+                     &packedStrings](const std::string& string) {
+    packedStrings.insert(packedStrings.end(), string.begin(), string.end());
+    packedStringBegin.push_back(packedStrings.size());
+  };
+  for (const Term* term : terms) {
+    packedTermIds.push_back(term->termId);
+    packedEntityIds.push_back(term->entityId);
+    pushString(term->term);
+    pushString(term->lowerCaseTerm);
+    for (const std::string& alias : term->alias) pushString(alias);
+    packedTermStringBegin.push_back(packedStringBegin.size() - 1);
+  }
+  std::vector<const Term*>().swap(terms);
+  std::unordered_map<int, Term>().swap(dictionary);
+
+  entityIds.assign(std::move(packedEntityIds));
+  termStringBegin.assign(std::move(packedTermStringBegin));
+  stringBegin.assign(std::move(packedStringBegin));
+  strings.assign(std::move(packedStrings));
+
+  // Slots follow the order of the term ids.
+  TrigramIndex::Postings postings;
+  postings.swap(stagedTrigrams);
+  for (TrigramIndex::Posting& posting : postings) {
+    posting.second = std::lower_bound(packedTermIds.begin(),
+                                      packedTermIds.end(),
+                                      static_cast<int32_t>(posting.second)) -
+                     packedTermIds.begin();
+  }
+  termIds.assign(std::move(packedTermIds));
+  index.build(postings);
+  compacted.store(true, std::memory_order_release);
+}
+
+void TermIndex::unpack() {
+  // Stage the packed terms and trigrams along with the new ones.
+  TrigramIndex::Postings postings;
+  index.decode(postings);
+  for (const TrigramIndex::Posting& posting : postings)
+    stagedTrigrams.push_back(
+        StagedTrigram(posting.first, termIds[posting.second]));
+  for (TrigramIndex::Slot slot = 0; slot < termIds.size(); ++slot)
+    dictionary[termIds[slot]] = termAt(slot);
+
+  termIds.clear();
+  entityIds.clear();
+  termStringBegin.clear();
+  stringBegin.clear();
+  strings.clear();
+  compacted.store(false, std::memory_order_relaxed);
+}
+
+bool TermIndex::findSlot(int termId, TrigramIndex::Slot& slot) const {
+  PackedArray<int32_t>::const_iterator it =
+      std::lower_bound(termIds.begin(), termIds.end(), termId);
+  if (it == termIds.end() || *it != termId) return false;
+  slot = it - termIds.begin();
+  return true;
+}
+
+std::string TermIndex::stringAt(uint32_t string) const {
+  return std::string(strings.data() + stringBegin[string],
+                     stringBegin[string + 1] - stringBegin[string]);
+}
+
+Term TermIndex::termAt(TrigramIndex::Slot slot) const {
+  Term term;
+  term.termId = termIds[slot];
+  term.entityId = entityIds[slot];
+  uint32_t string = termStringBegin[slot];
+  term.term = stringAt(string++);
+  term.lowerCaseTerm = stringAt(string++);
+  for (; string < termStringBegin[slot + 1]; ++string)
+    term.alias.push_back(stringAt(string));
+  return term;
+}
+
+void TermIndex::writeTo(BinaryWriter& writer) const {
+  compact();
+
+  std::lock_guard<std::mutex> lock(compactionMutex);
+  writer.writeArray(termIds);
+  writer.writeArray(entityIds);
+  writer.writeArray(termStringBegin);
+  writer.writeArray(stringBegin);
+  writer.writeArray(strings);
+  index.writeTo(writer);
+  phraseTrie.writeTo(writer);
+}
+
+void TermIndex::readFrom(BinaryReader& reader) {
+  std::lock_guard<std::mutex> lock(compactionMutex);
+  reader.readArray(termIds);
+  reader.readArray(entityIds);
+  reader.readArray(termStringBegin);
+  reader.readArray(stringBegin);
+  reader.readArray(strings);
+
+  // The lookups trust the offsets, check them once here. Every term has at
+  // least two strings and the term ids are sorted for the binary searches.
+  bool consistent = entityIds.size() == termIds.size() &&
+                    termStringBegin.size() == termIds.size() + 1 &&
+                    !stringBegin.empty() &&
+                    isRangeBounds(termStringBegin, stringBegin.size() - 1) &&
+                    isRangeBounds(stringBegin, strings.size());
+  for (size_t slot = 0; consistent && slot < termIds.size(); ++slot) {
+    consistent = termStringBegin[slot] + 2 <= termStringBegin[slot + 1] &&
+                 (slot == 0 || termIds[slot - 1] < termIds[slot]);
+  }
+  if (!consistent) throw BinaryStreamException("Inconsistent term index");
+
+  index.readFrom(reader);
+  phraseTrie.readFrom(reader);
+
+  std::unordered_map<int, Term>().swap(dictionary);
+  std::vector<StagedTrigram>().swap(stagedTrigrams);
+  compacted.store(true, std::memory_order_release);
+}
+
 void TermIndex::pushTerm(const Term& term) {
   Term updatedTerm = term;
   // Lower the term
@@ -214,41 +449,149 @@ void TermIndex::pushTerm(const Term& term) {
                                  ::tolower);
                 });
 
-  pushAlias pusher(index, updatedTerm.termId);
+  std::lock_guard<std::mutex> lock(compactionMutex);
+  if (compacted.load(std::memory_order_relaxed)) unpack();
+
+  pushAlias pusher(stagedTrigrams, updatedTerm.termId);
 
   pusher(updatedTerm.term);
   std::for_each(updatedTerm.alias.begin(), updatedTerm.alias.end(), pusher);
 
+  if (!isInvalidTerm(updatedTerm)) {
+    phraseTrie.insert(updatedTerm.lowerCaseTerm, updatedTerm.termId);
+    for (const std::string& alias : updatedTerm.alias)
+      phraseTrie.insert(alias, updatedTerm.termId);
+  }
+
   dictionary[updatedTerm.termId] = updatedTerm;
 }
 
+void TermIndex::renumberTerms(const std::vector<int>& termIdMap,
+                              const std::vector<int>& entityIdMap) {
+  auto newId = [](const std::vector<int>& idMap, int id) {
+    return id >= 0 && static_cast<size_t>(id) < idMap.size() ? idMap[id] : id;
+  };
+
+  std::lock_guard<std::mutex> lock(compactionMutex);
+  if (compacted.load(std::memory_order_relaxed)) unpack();
+
+  size_t kept = 0;
+  for (const StagedTrigram& t : stagedTrigrams) {
+    int termId = newId(termIdMap, static_cast<int>(t.second));
+    if (termId != -1) stagedTrigrams[kept++] = StagedTrigram(t.first, termId);
+  }
+  stagedTrigrams.resize(kept);
+
+  // The terms are renumbered in place, the keys of the dictionary are stale
+  // until it is packed below.
+  std::vector<const Term*> terms;
+  terms.reserve(dictionary.size());
+  std::unordered_map<int, Term>::iterator it = dictionary.begin();
+  while (it != dictionary.end()) {
+    Term& term = it->second;
+    term.termId = newId(termIdMap, term.termId);
+    if (term.termId == -1) {
+      it = dictionary.erase(it);
+      continue;
+    }
+    term.entityId = newId(entityIdMap, term.entityId);
+    terms.push_back(&term);
+    ++it;
+  }
+  std::sort(terms.begin(), terms.end(), [](const Term* a, const Term* b) {
+    return a->termId < b->termId;
+  });
+
+  phraseTrie = PhraseTrie();
+  for (const Term* term : terms) {
+    if (isInvalidTerm(*term)) continue;
+    phraseTrie.insert(term->lowerCaseTerm, term->termId);
+    for (const std::string& alias : term->alias)
+      phraseTrie.insert(alias, term->termId);
+  }
+  std::vector<const Term*>().swap(terms);
+
+  pack();
+}
+
 Term TermIndex::findTerm(const std::string& token,
                          const std::vector<std::string>& buffer,
                          int& tokensPopped) const {
+  const TokenViews bufferViews(buffer.begin(), buffer.end());
+  return findTerm(token, bufferViews.begin(), bufferViews.end(), tokensPopped);
+}
+
+Term TermIndex::findTerm(TokenView token,
+                         TokenViews::const_iterator bufferBegin,
+                         TokenViews::const_iterator bufferEnd,
+                         int& tokensPopped) const {
+  compact();
+
+  int termId;
+  size_t length = phraseTrie.longestMatch(bufferBegin, bufferEnd, termId);
+  if (length > 0) {
+    tokensPopped = static_cast<int>(length);
+    return findTerm(termId);
+  }
+  return findApproximateTerm(token, bufferBegin, bufferEnd, tokensPopped);
+}
+
+void TermIndex::findExactTerms(TokenViews::const_iterator begin,
+                               TokenViews::const_iterator end,
+                               PhraseMatches& matches) const {
+  compact();
+
+  TokenViews::const_iterator it = begin;
+  while (it != end) {
+    PhraseMatch match;
+    match.length = phraseTrie.longestMatch(it, end, match.termId);
+    if (match.length == 0) {
+      ++it;
+      continue;
+    }
+
+    TrigramIndex::Slot slot = 0;
+    findSlot(match.termId, slot);
+    match.position = it - begin;
+    match.entityId = entityIds[slot];
+    matches.push_back(match);
+    it += match.length;
+  }
+}
+
+Term TermIndex::findApproximateTerm(TokenView token,
+                                    TokenViews::const_iterator bufferBegin,
+                                    TokenViews::const_iterator bufferEnd,
+                                    int& tokensPopped) const {
   std::string lowered_token;
   std::transform(token.begin(), token.end(), std::back_inserter(lowered_token),
                  ::tolower);
 
-  std::vector<std::string> trigrams;
-  std::unordered_map<int, int> termIdToScore;
-  TrigramHelper::generateTrigrams(lowered_token, trigrams);
-
-  std::for_each(trigrams.begin(), trigrams.end(),
-                evaluateTrigram(index, termIdToScore));
+  compact();
 
-  std::pair<int, std::set<int>> maxScoreTerms;
-  maxScoreTerms = std::accumulate(termIdToScore.begin(), termIdToScore.end(),
-                                  maxScoreTerms, findMaxScore());
+  ScoreBoard& scoreBoard = threadScoreBoard();
+  scoreBoard.reset(termIds.size());
+  visitTrigramCodes(lowered_token,
+                    [this, &scoreBoard](TrigramIndex::TrigramCode code) {
+                      index.visitPostings(code,
+                                          [&scoreBoard](TrigramIndex::Slot s) {
+                                            scoreBoard.increment(s);
+                                          });
+                    });
 
-  std::set<int> foundTermIds = maxScoreTerms.second;
+  int maxScore = scoreBoard.maxScore();
   std::vector<Term> foundTerms;
 
-  // if the score is too low, we shouldn't accept the match
-  int threshold = std::min((int)trigrams.size() / 2, 2);
-  if (maxScoreTerms.first > threshold && !foundTermIds.empty()) {
+  // if the score is too low, we shouldn't accept the match. There is one
+  // trigram per character of the token.
+  int threshold = std::min((int)lowered_token.size() / 2, 2);
+  if (maxScore > threshold) {
     // we find the terms by termId
-    std::transform(foundTermIds.begin(), foundTermIds.end(),
-                   std::back_inserter(foundTerms), TermFinderForId(dictionary));
+    const std::vector<TrigramIndex::Slot>& bestSlots =
+        scoreBoard.slotsWithScore(maxScore);
+    std::transform(bestSlots.begin(), bestSlots.end(),
+                   std::back_inserter(foundTerms),
+                   [this](TrigramIndex::Slot slot) { return termAt(slot); });
 
     // we remove invalid tokens
     std::vector<Term>::const_iterator invalidTermsStart =
@@ -260,8 +603,8 @@ Term TermIndex::findTerm(const std::string& token,
   if (!foundTerms.empty()) {
     // we align each alias with the same number of tokens of the sentence
     AliasesToBuffered aliases;
-    aliases = std::accumulate(foundTerms.begin(), foundTerms.end(), aliases,
-                              ZipWithBuffer(buffer));
+    ZipWithBuffer zipWithBuffer(bufferBegin, bufferEnd);
+    for (const Term& foundTerm : foundTerms) zipWithBuffer(aliases, foundTerm);
 
     // we index again the aliases to retrieve the term once done
     std::unordered_map<std::string, Term> aliasesToTerm;
@@ -275,13 +618,13 @@ Term TermIndex::findTerm(const std::string& token,
         aliases.begin(), aliases.end(), initPair, LevenshteinMinimizer());
 
     // the distance must be small enough in the end
-    if (bestAlias.second <= 2) {
+    if (bestAlias.second <= MAX_LEVENSHTEIN_DISTANCE) {
       term = aliasesToTerm[bestAlias.first];
 
-      std::vector<std::string> tokens;
+      SingleCharacterDelimiterTokenizer::TokenViews tokens;
       SingleCharacterDelimiterTokenizer::tokenize(bestAlias.first, " ", tokens);
       tokensPopped = (int)tokens.size();
-      assert(tokensPopped > 0);
+      assert(tokensPopped > 0 && tokensPopped <= bufferEnd - bufferBegin);
     }
   }
 
@@ -289,25 +632,42 @@ Term TermIndex::findTerm(const std::string& token,
 }
 
 Term TermIndex::findTerm(const std::string& token) const {
-  const std::vector<std::string> buffer({token});
+  const TokenViews buffer(1, token);
   int tokensPopped = 1;
-  return findTerm(token, buffer, tokensPopped);
+  return findTerm(token, buffer.begin(), buffer.end(), tokensPopped);
 }
 
 Term TermIndex::findTerm(const int termId) const {
+  compact();
+
   Term term;
-  std::unordered_map<int, Term>::const_iterator it = dictionary.find(termId);
-  if (it != dictionary.end()) term = it->second;
+  TrigramIndex::Slot slot;
+  if (findSlot(termId, slot)) term = termAt(slot);
   return term;
 }
 
-size_t TermIndex::size() const { return dictionary.size(); }
+size_t TermIndex::size() const {
+  std::lock_guard<std::mutex> lock(compactionMutex);
+  return compacted.load(std::memory_order_relaxed) ? termIds.size()
+                                                   : dictionary.size();
+}
 
-size_t TermIndex::index_size() const { return index.size(); }
+size_t TermIndex::index_size() const {
+  compact();
+  return index.size();
+}
 
 void TermIndex::getTermSet(const std::string& trigram,
                            std::set<int>& termIds) const {
-  TrigramIndex::const_iterator it = index.find(trigram);
-  if (it != index.end()) termIds = it->second;
+  compact();
+
+  TrigramIndex::TrigramCode code;
+  if (!TrigramIndex::encode(trigram, code)) return;
+
+  std::set<int> foundTermIds;
+  if (index.visitPostings(code, [this, &foundTermIds](TrigramIndex::Slot slot) {
+        foundTermIds.insert(this->termIds[slot]);
+      }))
+    termIds.swap(foundTermIds);
 }
 }
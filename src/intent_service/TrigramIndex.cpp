@@ -0,0 +1,125 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "intent/intent_service/TrigramIndex.hpp"
+#include "intent/utils/BinaryStream.hpp"
+
+namespace intent {
+
+bool TrigramIndex::encode(const std::string& trigram, TrigramCode& code) {
+  if (trigram.size() != 3) return false;
+  code = static_cast<TrigramCode>(static_cast<uint8_t>(trigram[0])) << 16 |
+         static_cast<TrigramCode>(static_cast<uint8_t>(trigram[1])) << 8 |
+         static_cast<TrigramCode>(static_cast<uint8_t>(trigram[2]));
+  return true;
+}
+
+void TrigramIndex::writeVarint(Slot value, std::vector<uint8_t>& out) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<uint8_t>(value));
+}
+
+void TrigramIndex::build(Postings& postings) {
+  std::sort(postings.begin(), postings.end());
+  postings.erase(std::unique(postings.begin(), postings.end()),
+                 postings.end());
+
+  std::vector<TrigramCode> codes;
+  std::vector<uint32_t> offsets;
+  std::vector<uint8_t> postingLists;
+
+  Slot previousSlot = 0;
+  for (const Posting& posting : postings) {
+    if (codes.empty() || codes.back() != posting.first) {
+      codes.push_back(posting.first);
+      offsets.push_back(postingLists.size());
+      previousSlot = 0;
+    }
+    writeVarint(posting.second - previousSlot, postingLists);
+    previousSlot = posting.second;
+  }
+  offsets.push_back(postingLists.size());
+
+  m_codes.assign(std::move(codes));
+  m_offsets.assign(std::move(offsets));
+  m_postings.assign(std::move(postingLists));
+}
+
+void TrigramIndex::decode(Postings& postings) const {
+  for (const TrigramCode& code : m_codes) {
+    visitPostings(code, [&postings, code](Slot slot) {
+      postings.push_back(Posting(code, slot));
+    });
+  }
+}
+
+size_t TrigramIndex::memoryUsage() const {
+  return m_codes.memoryUsage() + m_offsets.memoryUsage() +
+         m_postings.memoryUsage();
+}
+
+void TrigramIndex::writeTo(BinaryWriter& writer) const {
+  writer.writeArray(m_codes);
+  writer.writeArray(m_offsets);
+  writer.writeArray(m_postings);
+}
+
+void TrigramIndex::readFrom(BinaryReader& reader) {
+  reader.readArray(m_codes);
+  reader.readArray(m_offsets);
+  reader.readArray(m_postings);
+
+  // The lookups trust the offsets, check them once here.
+  bool consistent = m_offsets.empty()
+                        ? m_codes.empty() && m_postings.empty()
+                        : m_offsets.size() == m_codes.size() + 1 &&
+                              m_offsets.back() == m_postings.size();
+  for (size_t i = 1; consistent && i < m_offsets.size(); ++i) {
+    // A posting list must not end in the middle of a varint.
+    consistent = m_offsets[i - 1] < m_offsets[i] &&
+                 m_postings[m_offsets[i] - 1] < 0x80 &&
+                 (i == 1 || m_codes[i - 2] < m_codes[i - 1]);
+  }
+  if (!consistent) throw BinaryStreamException("Inconsistent trigram index");
+}
+}
@@ -43,32 +43,19 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <boost/algorithm/string/join.hpp>
 
 namespace intent {
-typedef boost::property_map<IntentStoryModel::StoryGraph::_Graph,
-                            std::string IntentStoryModel::VertexInfo::
-                                *>::const_type VertexStringPropertyMap;
-typedef boost::property_map<IntentStoryModel::StoryGraph::_Graph,
-                            std::string IntentStoryModel::EdgeInfo::
-                                *>::const_type EdgeStringPropertyMap;
-typedef boost::property_map<
-    IntentStoryModel::StoryGraph::_Graph,
-    IntentStoryModel::Intent IntentStoryModel::EdgeInfo::*>::const_type
-    EdgeIntentPropertyMap;
+typedef IntentStoryModel::StoryGraph StoryGraph;
 
 struct VertexWriter {
-  VertexWriter(VertexStringPropertyMap stateId,
-               const IntentStoryServiceModel &intentStoryServiceModel)
-      : m_stateId(stateId),
-        m_intentStoryServiceModel(intentStoryServiceModel) {}
+  VertexWriter(const IntentStoryServiceModel &intentStoryServiceModel)
+      : m_intentStoryServiceModel(intentStoryServiceModel) {}
 
-  template <class Vertex>
-  void operator()(std::ostream &out, const Vertex &v) const {
-    const std::string &actionId = m_stateId[v];
+  void operator()(std::ostream &out, const StoryGraph::Vertex &v) const {
+    const std::string &actionId = v.getInfo().stateId;
 
     out << "[label=<" << actionId << ">"
         << "]";
   }
 
-  VertexStringPropertyMap m_stateId;
   const IntentStoryServiceModel &m_intentStoryServiceModel;
 };
 
@@ -87,7 +74,7 @@ std::string entitiesOfIntent(
     std::transform(
         intent.entityToVariableNames.begin(),
         intent.entityToVariableNames.end(), std::back_inserter(entityNames),
-        [](const std::pair<std::string, std::queue<std::string> > &pair) {
+        [](const IntentModel::EntityToNames::value_type &pair) {
           return pair.first;
         });
     entities << "[" << boost::algorithm::join(entityNames, ", ") << "]";
@@ -96,19 +83,13 @@ std::string entitiesOfIntent(
 }
 
 struct EdgeWriter {
-  EdgeWriter(EdgeIntentPropertyMap intent, EdgeStringPropertyMap actionId,
-             EdgeStringPropertyMap reply,
-             const IntentStoryServiceModel &intentStoryServiceModel)
-      : m_intent(intent),
-        m_actionId(actionId),
-        m_reply(reply),
-        m_intentStoryServiceModel(intentStoryServiceModel) {}
-
-  template <class Edge>
-  void operator()(std::ostream &out, const Edge &e) const {
-    const IntentStoryModel::Intent intent = m_intent[e];
-    const std::string &actionId = m_actionId[e];
-    const std::string &reply = m_reply[e];
+  EdgeWriter(const IntentStoryServiceModel &intentStoryServiceModel)
+      : m_intentStoryServiceModel(intentStoryServiceModel) {}
+
+  void operator()(std::ostream &out, const StoryGraph::Edge &e) const {
+    const IntentStoryModel::Intent &intent = e.getInfo().intent;
+    const std::string &actionId = e.getInfo().actionId;
+    const std::string &reply = e.getInfo().reply;
 
     out << "[label=< <table BORDER=\"0\" CELLBORDER=\"1\" CELLSPACING=\"0\">"
         << "<tr>"
@@ -126,9 +107,6 @@ struct EdgeWriter {
         << "</table> >]";
   }
 
-  EdgeIntentPropertyMap m_intent;
-  EdgeStringPropertyMap m_actionId;
-  EdgeStringPropertyMap m_reply;
   const IntentStoryServiceModel &m_intentStoryServiceModel;
 };
 
@@ -136,19 +114,15 @@ struct WriterMaker {
   WriterMaker(const IntentStoryServiceModel &intentStoryServiceModel)
       : m_intentStoryServiceModel(intentStoryServiceModel) {}
 
-  VertexWriter makeVertexWriter(
-      const IntentStoryModel::StoryGraph::_Graph &graph) const {
-    return VertexWriter(
-        boost::get(&IntentStoryModel::VertexInfo::stateId, graph),
-        m_intentStoryServiceModel);
+  typedef intent::VertexWriter VertexWriter;
+  typedef intent::EdgeWriter EdgeWriter;
+
+  VertexWriter makeVertexWriter(const StoryGraph &) const {
+    return VertexWriter(m_intentStoryServiceModel);
   }
 
-  EdgeWriter makeEdgeWriter(
-      const IntentStoryModel::StoryGraph::_Graph &graph) const {
-    return EdgeWriter(boost::get(&IntentStoryModel::EdgeInfo::intent, graph),
-                      boost::get(&IntentStoryModel::EdgeInfo::actionId, graph),
-                      boost::get(&IntentStoryModel::EdgeInfo::reply, graph),
-                      m_intentStoryServiceModel);
+  EdgeWriter makeEdgeWriter(const StoryGraph &) const {
+    return EdgeWriter(m_intentStoryServiceModel);
   }
 
   const IntentStoryServiceModel &m_intentStoryServiceModel;
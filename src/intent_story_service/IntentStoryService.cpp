@@ -47,85 +47,148 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "intent/utils/Deserializer.hpp"
 #include "intent/utils/Logger.hpp"
+#include <algorithm>
 #include <fstream>
 
 #define ANY_INTENT_TOKEN "_"
 
 namespace intent {
+constexpr IntentStoryModel::StateHandle IntentStoryModel::NO_STATE;
+
 IntentStoryService::IntentStoryService(
     const IntentStoryServiceModel& intentStoryServiceModel)
     : IntentService(intentStoryServiceModel.intentServiceModel),
-      m_intentStoryModel(intentStoryServiceModel.intentStoryModel) {}
-
-typedef std::unordered_map<IntentModel::IndexType,
-                           IntentStoryModel::StoryGraph::Edge>
-    EdgeByIntentIdIndex;
-
-void buildIntentsIndex(
-    const IntentModel& intentModel,
-    const IntentStoryModel::StoryGraph::Edges edges,
-    IntentModel::IntentIndex& intentByIdIndex,
-    EdgeByIntentIdIndex& edgeByIntentIdIndex,
-    boost::optional<IntentStoryModel::StoryGraph::Edge>& anyIntentEdge) {
-  for (const IntentStoryModel::StoryGraph::Edge& e : edges) {
-    const IntentModel::IndexType& intentId = e.getInfo().intent.intentId;
-
-    IntentModel::IntentIndex::const_iterator it =
-        intentModel.intentsByIntentId.find(intentId);
-    if (intentId == ANY_INTENT_TOKEN) {
-      anyIntentEdge = e;
-    } else if (it != intentModel.intentsByIntentId.end()) {
-      intentByIdIndex.insert(std::make_pair(intentId, it->second));
-      edgeByIntentIdIndex.insert(std::make_pair(intentId, e));
+      m_intentStoryModel(intentStoryServiceModel.intentStoryModel),
+      m_rootState(IntentStoryModel::NO_STATE) {
+  if (m_intentStoryModel) {
+    buildStateTransitions();
+    m_rootState = findState(m_intentStoryModel->rootStateId);
+  }
+}
+
+void IntentStoryService::buildStateTransitions() {
+  typedef std::pair<IntentAutomaton::IntentRef,
+                    IntentStoryModel::StoryGraph::Edge> EdgeByIntent;
+
+  // The model may be shared by several services, it is never mutated here.
+  const IntentStoryModel::StoryGraph& graph = m_intentStoryModel->graph;
+  if (!graph.isFrozen())
+    throw GraphException("The story graph must be frozen");
+  m_transitionsByVertex.resize(graph.vertexCount());
+
+  for (const IntentStoryModel::VertexByStateIdIndex::value_type& p :
+       m_intentStoryModel->vertexByStateId) {
+    StateTransitions& transitions =
+        m_transitionsByVertex[p.second.getVertex()];
+
+    std::vector<EdgeByIntent> edgesByIntent;
+    for (const IntentStoryModel::StoryGraph::Edge& e :
+         graph.nextEdges(p.second)) {
+      const IntentModel::IndexType& intentId = e.getInfo().intent.intentId;
+
+      // If no intent is matching, the user can define a fallback edge to
+      // handle fallback replies
+      if (intentId == ANY_INTENT_TOKEN) {
+        transitions.fallbackEdge = e;
+        continue;
+      }
+
+      IntentAutomaton::IntentRef intentRef =
+          m_intentAutomaton.findIntent(intentId);
+      if (intentRef >= 0) edgesByIntent.push_back(EdgeByIntent(intentRef, e));
+    }
+
+    // The first edge declared for an intent wins.
+    std::stable_sort(edgesByIntent.begin(), edgesByIntent.end(),
+                     [](const EdgeByIntent& a, const EdgeByIntent& b) {
+                       return a.first < b.first;
+                     });
+    for (const EdgeByIntent& edgeByIntent : edgesByIntent) {
+      if (!transitions.allowedIntents.empty() &&
+          transitions.allowedIntents.back() == edgeByIntent.first)
+        continue;
+      transitions.allowedIntents.push_back(edgeByIntent.first);
+      transitions.edges.push_back(edgeByIntent.second);
     }
   }
 }
 
-IntentStoryService::Result IntentStoryService::evaluate(
-    const std::string& stateId, const std::string& message) const {
-  INTENT_LOG_INFO() << "Look for intent in \"" + message + "\" from state \"" +
-                           stateId + "\".";
+IntentStoryService::StateHandle IntentStoryService::findState(
+    const std::string& stateId) const {
+  if (!m_intentStoryModel) return IntentStoryModel::NO_STATE;
 
-  IntentStoryService::Result intentStoryResult;
   IntentStoryModel::VertexByStateIdIndex::const_iterator vIt =
       m_intentStoryModel->vertexByStateId.find(stateId);
+  if (vIt == m_intentStoryModel->vertexByStateId.end())
+    return IntentStoryModel::NO_STATE;
+  return static_cast<StateHandle>(vIt->second.getVertex());
+}
+
+const std::string& IntentStoryService::getStateId(StateHandle state) const {
+  static const std::string noStateId;
+  if (state >= m_transitionsByVertex.size()) return noStateId;
+  return m_intentStoryModel->graph.vertexAt(state).getInfo().stateId;
+}
+
+IntentStoryService::Result IntentStoryService::evaluate(
+    const std::string& stateId, boost::string_ref message) const {
+  StateHandle state = findState(stateId);
+  if (state == IntentStoryModel::NO_STATE) {
+    INTENT_LOG_ERROR() << "There are no neighboor edges from state \"" +
+                              stateId + "\".";
+    IntentStoryService::Result intentStoryResult;
+    intentStoryResult.found = false;
+    return intentStoryResult;
+  }
+
+  IntentStoryService::Result intentStoryResult = evaluate(state, message);
+  if (intentStoryResult.found)
+    intentStoryResult.nextStateId = getStateId(intentStoryResult.nextState);
+  return intentStoryResult;
+}
 
-  if (vIt != m_intentStoryModel->vertexByStateId.end()) {
-    IntentStoryModel::StoryGraph::Edges neighboorEdges =
-        m_intentStoryModel->graph.nextEdges(vIt->second);
+IntentStoryService::Result IntentStoryService::evaluate(
+    StateHandle state, boost::string_ref message) const {
+  INTENT_LOG_INFO() << "Look for intent in \"" << message << "\" from state \""
+                    << getStateId(state) << "\".";
 
-    IntentModel::IntentIndex intentByIdIndex;
-    EdgeByIntentIdIndex edgeByIntentIdIndex;
-    // If no intent is matching, the user can define a fallback edge to handle
-    // fallback replies
-    boost::optional<IntentStoryModel::StoryGraph::Edge> otherwiseIntent;
+  IntentStoryService::Result intentStoryResult;
 
-    buildIntentsIndex(*m_intentServiceModel.intentModel, neighboorEdges,
-                      intentByIdIndex, edgeByIntentIdIndex, otherwiseIntent);
-    IntentMatcher::IntentResult intentResult = resolveIntent(
-        message, *m_intentServiceModel.dictionaryModel, intentByIdIndex);
+  if (state < m_transitionsByVertex.size()) {
+    const StateTransitions& transitions = m_transitionsByVertex[state];
 
-    EdgeByIntentIdIndex::const_iterator foundEdgeIt =
-        edgeByIntentIdIndex.find(intentResult.intent.intentId);
+    // A state with only a fallback edge does not need to look for intents.
+    IntentMatcher::IntentResult intentResult;
+    if (!transitions.allowedIntents.empty()) {
+      intentResult =
+          resolveIntent(message, *m_intentServiceModel.dictionaryModel,
+                        m_intentAutomaton, transitions.allowedIntents);
+    }
 
-    IntentStoryModel::StoryGraph::Edge foundEdge;
-    if (foundEdgeIt != edgeByIntentIdIndex.end()) {
-      foundEdge = foundEdgeIt->second;
+    const IntentStoryModel::StoryGraph::Edge* foundEdge = NULL;
+    if (intentResult.found) {
+      IntentAutomaton::IntentRefs::const_iterator it = std::lower_bound(
+          transitions.allowedIntents.begin(), transitions.allowedIntents.end(),
+          m_intentAutomaton.findIntent(intentResult.intent.intentId));
+      foundEdge = &transitions.edges[it - transitions.allowedIntents.begin()];
       intentStoryResult.intent = intentResult.intent;
-    } else if (otherwiseIntent) {
+    } else if (transitions.fallbackEdge) {
       INTENT_LOG_DEBUG() << "Otherwise intent detected.";
-      foundEdge = *otherwiseIntent;
-      intentStoryResult.intent = IntentMatcher::buildFullMatchIntent(message);
+      foundEdge = &*transitions.fallbackEdge;
+      intentStoryResult.intent =
+          IntentMatcher::buildFullMatchIntent(message.to_string());
     } else
       intentStoryResult.found = false;
 
     if (intentStoryResult.found) {
-      intentStoryResult.actionId = foundEdge.getInfo().actionId;
-      intentStoryResult.nextStateId = foundEdge.getTarget().getInfo().stateId;
+      intentStoryResult.actionId = foundEdge->getInfo().actionId;
+      intentStoryResult.nextState =
+          static_cast<StateHandle>(foundEdge->getTarget().getVertex());
     }
   } else {
-    INTENT_LOG_ERROR() << "There are no neighboor edges from state \"" +
-                              stateId + "\".";
+    INTENT_LOG_ERROR() << "There are no neighboor edges from state handle "
+                       << state << ".";
+    intentStoryResult.found = false;
   }
 
   INTENT_LOG_TRACE() << "Result = " << intentStoryResult;
@@ -66,21 +66,21 @@ std::string extractSentence(const ScriptLine& scriptLine) {
 
 struct ParsingContext {
   ParsingContext(int& vertexCount, int& anonymousActionCount,
-                 const DictionaryModel& dictionaryModel,
+                 SentenceToIntentTranslator& translator,
                  std::unique_ptr<std::string>& previousState)
       : vertexCount(vertexCount),
         anonymousActionCount(anonymousActionCount),
-        dictionaryModel(dictionaryModel),
+        translator(translator),
         previousState(previousState) {}
 
   int& vertexCount;
   int& anonymousActionCount;
-  const DictionaryModel& dictionaryModel;
+  SentenceToIntentTranslator& translator;
   std::unique_ptr<std::string>& previousState;
 };
 
 void completeSourceState(const Scenario& scenario,
-                         const InquiryToReply& inquiryToReply,
+                         const InquiryToReplies::value_type& inquiryToReply,
                          ParsingContext& context, EdgeDefinition& edge,
                          InterpreterFeedback& interpreterFeedback) {
   LineRange inquiryBounds = inquiryToReply.first;
@@ -102,7 +102,7 @@ void completeSourceState(const Scenario& scenario,
 }
 
 void completeTargetState(const Scenario& scenario,
-                         const InquiryToReply& inquiryToReply,
+                         const InquiryToReplies::value_type& inquiryToReply,
                          ParsingContext& context, EdgeDefinition& edge,
                          InterpreterFeedback& interpreterFeedback) {
   LineRange replyBounds = inquiryToReply.second;
@@ -122,7 +122,7 @@ void completeTargetState(const Scenario& scenario,
 }
 
 void completeEdgeInfo(const Scenario& scenario,
-                      const InquiryToReply& inquiryToReply,
+                      const InquiryToReplies::value_type& inquiryToReply,
                       ParsingContext& context, EdgeDefinition& edge,
                       InterpreterFeedback& interpreterFeedback) {
   LineRange inquiryBounds = inquiryToReply.first;
@@ -147,8 +147,7 @@ void completeEdgeInfo(const Scenario& scenario,
   }
 
   // identify the intent to complete intentModel and edge
-  std::pair<IndexType, Intent> intent =
-      SentenceToIntentTranslator::translate(inquiry, context.dictionaryModel);
+  std::pair<IndexType, Intent> intent = context.translator.translate(inquiry);
   edge.edge.intent = intent.second;
 
   // TODO : extract this loop into a function of its own
@@ -167,11 +166,12 @@ void completeEdgeInfo(const Scenario& scenario,
 }  // anonymous
 
 EdgeDefinition EdgeParser::parse(
-    const Scenario& scenario, const InquiryToReply& inquiryToReply,
+    const Scenario& scenario,
+    const InquiryToReplies::value_type& inquiryToReply,
     std::unique_ptr<std::string>& previousStateInScenario) {
   EdgeDefinition edge;
   ParsingContext context(m_vertexCounter, m_anonymousActionCounter,
-                         m_dictionaryModel, previousStateInScenario);
+                         *m_translator, previousStateInScenario);
 
   completeSourceState(scenario, inquiryToReply, context, edge,
                       m_interpreterFeedback);
@@ -195,11 +195,10 @@ EdgeDefinition EdgeParser::parse(
 }
 
 std::unique_ptr<EdgeDefinition> EdgeParser::parseFallback(
-    const Scenario& scenario, const InquiryToReply& inquiryToReply,
-    std::unique_ptr<std::string>& previousStateInScenario) {
+    const Scenario& scenario,
+    const InquiryToReplies::value_type& inquiryToReply,
+    const EdgeDefinition& edge) const {
   LineRange inquiryBounds = inquiryToReply.first;
-  EdgeDefinition edge =
-      parse(scenario, inquiryToReply, previousStateInScenario);
   std::unique_ptr<EdgeDefinition> fallbackEdge;
 
   // A fallback should be exactly 2 lines from the inquiry
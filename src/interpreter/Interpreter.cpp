@@ -42,6 +42,7 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "intent/intent_service/EntitiesMatcher.hpp"
 #include "intent/interpreter/EdgeParser.hpp"
+#include "intent/interpreter/InterpreterCache.hpp"
 #include "intent/interpreter/LineTagger.hpp"
 #include "intent/interpreter/ScenarioIndexer.hpp"
 #include "intent/interpreter/ScenarioTrimmer.hpp"
@@ -65,87 +66,15 @@ typedef IntentModel::Intent Intent;
 
 const std::string DEFAULT_REPLY_ID = "#reply";
 
-std::string extractSentence(const ScriptLine& scriptLine) {
-  std::string content = scriptLine.content;
-  assert(content.size() > 1);
-  return content.substr(1, content.size() - 1);
-}
-
-struct IntentInserter {
-  IntentInserter(const DictionaryModel& dictionaryModel,
-                 const Scenario& scenario, IntentModel& intentModel)
-      : m_intentModel(intentModel),
-        m_scenario(scenario),
-        m_dictionaryModel(dictionaryModel) {}
-
-  void operator()(const InquiryToReply& inquiryToReply) {
-    LineRange inquiryBounds = inquiryToReply.first;
-
-    std::string inquiry = extractSentence(m_scenario[inquiryBounds.lower]);
-    for (int i = inquiryBounds.lower + 1; i <= inquiryBounds.upper; ++i)
-      inquiry += m_scenario[i].content;
-
-    std::pair<IndexType, Intent> intent =
-        SentenceToIntentTranslator::translate(inquiry, m_dictionaryModel);
-    m_intentModel.intentsByIntentId.insert(intent);
-  }
-
-  IntentModel& m_intentModel;
-  const Scenario& m_scenario;
-  const DictionaryModel& m_dictionaryModel;
-};
-
-struct EdgeParserWrapper {
-  EdgeParserWrapper(const Scenario& scenario,
-                    std::unique_ptr<std::string>& previousStateInScenario,
-                    EdgeParser& edgeParser)
-      : m_scenario(scenario),
-        m_edgeParser(edgeParser),
-        m_previousStateInScenario(previousStateInScenario) {}
-
-  EdgeDefinition operator()(const InquiryToReply inquiryToReply) {
-    return m_edgeParser.parse(m_scenario, inquiryToReply,
-                              m_previousStateInScenario);
-  }
-
-  const Scenario& m_scenario;
-  EdgeParser& m_edgeParser;
-  std::unique_ptr<std::string>& m_previousStateInScenario;
-};
-
-struct FallbackEdgesRetriever {
-  FallbackEdgesRetriever(const Scenario& scenario,
-                         std::unique_ptr<std::string>& previousStateInScenario,
-                         EdgeParser& edgeParser,
-                         std::vector<EdgeDefinition>& edgesToInsert)
-      : m_scenario(scenario),
-        m_edgeParser(edgeParser),
-        m_previousStateInScenario(previousStateInScenario),
-        m_edgesToInsert(edgesToInsert) {}
-
-  void operator()(const InquiryToReply inquiryToReply) {
-    std::unique_ptr<EdgeDefinition> edge;
-    edge = m_edgeParser.parseFallback(m_scenario, inquiryToReply,
-                                      m_previousStateInScenario);
-    if (edge.get()) m_edgesToInsert.push_back(*edge);
-  }
-
-  const Scenario& m_scenario;
-  EdgeParser& m_edgeParser;
-  std::unique_ptr<std::string>& m_previousStateInScenario;
-  std::vector<EdgeDefinition>& m_edgesToInsert;
-};
-
 struct ActionInserter {
   ActionInserter(ChatbotActionModel& chatbotActionModel, int& repliesCounter)
       : m_repliesCounter(repliesCounter),
         m_chatbotActionModel(chatbotActionModel) {}
 
-  void operator()(EdgeDefinition& edge) {
+  void operator()(const EdgeDefinition& edge) {
     const std::string replyId =
         DEFAULT_REPLY_ID + "_" + edge.source.stateId + "_" + edge.edge.actionId;
 
-    ReplyTemplateInterpreter::adapt(edge.replyTemplate);
     m_chatbotActionModel.replyContentByReplyIdIndex[replyId] =
         edge.replyTemplate;
 
@@ -165,8 +94,6 @@ struct ActionInserter {
   ChatbotActionModel& m_chatbotActionModel;
 };
 
-}  // anonymous
-
 void addEdgeDefinitionToModel(
     const EdgeDefinition& edge, IntentStoryModel& intentStoryModel,
     std::unordered_map<std::string, IntentStoryModel::StoryGraph::Vertex>&
@@ -187,44 +114,60 @@ void addEdgeDefinitionToModel(
   intentStoryModel.vertexByStateId[targetId] = vertexIndex[targetId];
 }
 
-void completeModelFromScenario(
-    const Scenario& scenario, const DictionaryModel& dictionaryModel,
+void compileScenario(const Scenario& scenario,
+                     SentenceToIntentTranslator::SharedPtr translator,
+                     int vertexCounter, int anonymousActionCounter,
+                     CompiledScenario& compiledScenario) {
+  // link inquiries to replies which naturally represents an edge
+  InquiryToReplies inquiryToReplies;
+  indexScenario(scenario, inquiryToReplies);
+
+  // Parse every inquiry to reply once into an edgeDefinition, its intent and
+  // its optional fallback edge
+  std::vector<EdgeDefinition>& edgesToInsert = compiledScenario.edges;
+  std::vector<EdgeDefinition> fallbackEdges;
+  std::unique_ptr<std::string> previousStateInScenario;
+  EdgeParser edgeParser(translator, vertexCounter, anonymousActionCounter,
+                        compiledScenario.feedback);
+  for (const InquiryToReplies::value_type& inquiryToReply :
+       inquiryToReplies) {
+    EdgeDefinition edge =
+        edgeParser.parse(scenario, inquiryToReply, previousStateInScenario);
+    std::unique_ptr<EdgeDefinition> fallbackEdge =
+        edgeParser.parseFallback(scenario, inquiryToReply, edge);
+    if (fallbackEdge.get()) fallbackEdges.push_back(*fallbackEdge);
+
+    compiledScenario.intents.push_back(
+        std::make_pair(edge.edge.intent.intentId, edge.edge.intent));
+    edgesToInsert.push_back(edge);
+  }
+  edgesToInsert.insert(edgesToInsert.end(), fallbackEdges.begin(),
+                       fallbackEdges.end());
+
+  // adapt the replies format to chatbot model format
+  std::for_each(edgesToInsert.begin(), edgesToInsert.end(),
+                [](EdgeDefinition& edge) {
+                  ReplyTemplateInterpreter::adapt(edge.replyTemplate);
+                });
+}
+
+void mergeScenario(
+    const CompiledScenario& compiledScenario, int positionShift,
     IntentStoryModel& intentStoryModel, IntentModel& intentModel,
     ChatbotActionModel& chatbotActionModel, int& repliesCounter,
-    int& vertexCounter, int& anonymousActionCounter,
     std::unordered_map<std::string, IntentStoryModel::StoryGraph::Vertex>&
         vertexIndex,
     InterpreterFeedback& interpreterFeedback) {
-  // link inquiries to replies which naturally represents an edge
-  InquiryToReplies inquiryToReplies;
-  indexScenario(scenario, inquiryToReplies);
+  for (const InterpreterMessage& message : compiledScenario.feedback) {
+    interpreterFeedback.push_back(message);
+    interpreterFeedback.back().line.position += positionShift;
+  }
 
   // Add all intents of the scenario to the IntentModel
-  IntentInserter intentInserter(dictionaryModel, scenario, intentModel);
-  std::for_each(inquiryToReplies.begin(), inquiryToReplies.end(),
-                intentInserter);
-
-  // Transform inquiry to reply into an edgeDefinition
-  std::vector<EdgeDefinition> edgesToInsert;
-  std::unique_ptr<std::string> previousStateInScenario;
-  EdgeParser edgeParser(dictionaryModel, vertexCounter, anonymousActionCounter,
-                        interpreterFeedback);
-  EdgeParserWrapper edgeParserWrapper(scenario, previousStateInScenario,
-                                      edgeParser);
-  std::transform(inquiryToReplies.begin(), inquiryToReplies.end(),
-                 std::back_inserter(edgesToInsert), edgeParserWrapper);
-
-  // Retrieve fallback replies on the edges
-  previousStateInScenario.reset(NULL);
-  InterpreterFeedback dummyFeedback;
-  EdgeParser fallbackEdgeParser(dictionaryModel, vertexCounter,
-                                anonymousActionCounter, dummyFeedback);
-  FallbackEdgesRetriever fallbackEdgesRetriever(
-      scenario, previousStateInScenario, fallbackEdgeParser, edgesToInsert);
-  std::for_each(inquiryToReplies.begin(), inquiryToReplies.end(),
-                fallbackEdgesRetriever);
+  intentModel.intentsByIntentId.insert(compiledScenario.intents.begin(),
+                                       compiledScenario.intents.end());
 
-  // adapt the replies format to chatbot model format
+  const std::vector<EdgeDefinition>& edgesToInsert = compiledScenario.edges;
   ActionInserter actionInserter(chatbotActionModel, repliesCounter);
   std::for_each(edgesToInsert.begin(), edgesToInsert.end(), actionInserter);
 
@@ -235,9 +178,10 @@ void completeModelFromScenario(
                 });
 }
 
-ChatbotModel Interpreter::build(const std::string& script,
-                                DictionaryModel::SharedPtr dictionaryModel,
-                                InterpreterFeedback& interpreterFeedback) {
+ChatbotModel buildModel(ScenarioReader& scenarioReader,
+                        DictionaryModel::SharedPtr dictionaryModel,
+                        InterpreterFeedback& interpreterFeedback,
+                        ThreadPool* threadPool, InterpreterCache* cache) {
   ChatbotModel chatbotModel;
 
   chatbotModel.intentStoryServiceModel.intentServiceModel.dictionaryModel =
@@ -260,39 +204,137 @@ ChatbotModel Interpreter::build(const std::string& script,
   std::unordered_map<std::string, IntentStoryModel::StoryGraph::Vertex>
       vertexIndex;
 
+  SentenceToIntentTranslator::SharedPtr translator =
+      std::make_shared<SentenceToIntentTranslator>(*dictionaryModel);
+  if (cache) cache->beginBuild(dictionaryModel);
+
+  // Without a pool, every scenario is compiled and merged as soon as it is
+  // read. With a pool, the scenarios to compile are kept until the end of the
+  // script and all of them are merged in order once compiled, so that the
+  // model does not depend on the scheduling.
   Scenarios scenarios;
-  extractScenarios(script, scenarios);
-
-  trimComments(scenarios);
-
-  assert(scenarios.size() > 0);
-  Scenario firstScenario = scenarios[0];
-
-  // Change or document this constraint: root state is first state of first
-  // scenario, and terminal state last state from first scenario
-  assert(firstScenario.size() > 0);
-  intentStoryModel.rootStateId = firstScenario[0].content;
-  if (!isLine<STATE>(firstScenario[0].content))
-    interpreterFeedback.push_back(
-        InterpreterMessage(ROOT_STATE_MSG, firstScenario[0], ERROR));
-
-  const DictionaryModel& dict = *dictionaryModel;
-
-  if (!isLine<STATE>(firstScenario[firstScenario.size() - 1].content))
-    interpreterFeedback.push_back(InterpreterMessage(
-        TERMINAL_STATE_MSG, firstScenario[firstScenario.size() - 1], ERROR));
-
-  std::for_each(
-      scenarios.begin(), scenarios.end(),
-      [&intentStoryModel, &intentModel, &chatbotActionModel, &repliesCounter,
-       &vertexCounter, &anonymousActionCounter, &dict, &vertexIndex,
-       &interpreterFeedback](const Scenario& scenario) {
-        completeModelFromScenario(scenario, dict, intentStoryModel, intentModel,
-                                  chatbotActionModel, repliesCounter,
-                                  vertexCounter, anonymousActionCounter,
-                                  vertexIndex, interpreterFeedback);
-      });
+  std::vector<CompiledScenario::SharedPtr> compiledScenarios;
+  std::vector<int> positionShifts;
+  std::vector<size_t> scenariosToCompile;
+
+  Scenario scenario;
+  bool isFirstScenario = true;
+  while (scenarioReader.next(scenario)) {
+    trimComments(scenario);
+
+    if (isFirstScenario) {
+      // Change or document this constraint: root state is first state of
+      // first scenario, and terminal state last state from first scenario
+      assert(scenario.size() > 0);
+      intentStoryModel.rootStateId = scenario[0].content;
+      if (!isLine<STATE>(scenario[0].content))
+        interpreterFeedback.push_back(
+            InterpreterMessage(ROOT_STATE_MSG, scenario[0], ERROR));
+
+      if (!isLine<STATE>(scenario[scenario.size() - 1].content))
+        interpreterFeedback.push_back(InterpreterMessage(
+            TERMINAL_STATE_MSG, scenario[scenario.size() - 1], ERROR));
+      isFirstScenario = false;
+    }
+
+    int positionShift = 0;
+    CompiledScenario::SharedPtr compiledScenario;
+    if (cache) compiledScenario = cache->find(scenario, positionShift);
+
+    if (!compiledScenario && threadPool) {
+      scenariosToCompile.push_back(compiledScenarios.size());
+      scenarios.push_back(std::move(scenario));
+    } else if (!compiledScenario) {
+      std::shared_ptr<CompiledScenario> compiled =
+          std::make_shared<CompiledScenario>();
+      compileScenario(scenario, translator, vertexCounter,
+                      anonymousActionCounter, *compiled);
+      if (cache) cache->insert(scenario, compiled);
+      compiledScenario = compiled;
+    }
+
+    if (threadPool) {
+      compiledScenarios.push_back(compiledScenario);
+      positionShifts.push_back(positionShift);
+    } else {
+      mergeScenario(*compiledScenario, positionShift, intentStoryModel,
+                    intentModel, chatbotActionModel, repliesCounter,
+                    vertexIndex, interpreterFeedback);
+    }
+  }
+  assert(!isFirstScenario);
+
+  auto compileScenarios = [&scenarios, &translator, vertexCounter,
+                           anonymousActionCounter, &scenariosToCompile,
+                           &compiledScenarios](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      std::shared_ptr<CompiledScenario> compiledScenario =
+          std::make_shared<CompiledScenario>();
+      compileScenario(scenarios[i], translator, vertexCounter,
+                      anonymousActionCounter, *compiledScenario);
+      compiledScenarios[scenariosToCompile[i]] = compiledScenario;
+    }
+  };
+  if (threadPool)
+    threadPool->parallelFor(scenariosToCompile.size(), 1, compileScenarios);
+
+  if (cache) {
+    for (size_t i = 0; i < scenariosToCompile.size(); ++i)
+      cache->insert(scenarios[i], compiledScenarios[scenariosToCompile[i]]);
+    cache->endBuild();
+  }
+
+  for (size_t i = 0; i < compiledScenarios.size(); ++i) {
+    mergeScenario(*compiledScenarios[i], positionShifts[i], intentStoryModel,
+                  intentModel, chatbotActionModel, repliesCounter, vertexIndex,
+                  interpreterFeedback);
+  }
+  intentStoryModel.graph.freeze();
 
   return chatbotModel;
 }
+}  // anonymous
+
+ChatbotModel Interpreter::build(const std::string& script,
+                                DictionaryModel::SharedPtr dictionaryModel,
+                                InterpreterFeedback& interpreterFeedback) {
+  ScenarioReader scenarioReader(script);
+  return buildModel(scenarioReader, dictionaryModel, interpreterFeedback, NULL,
+                    NULL);
+}
+
+ChatbotModel Interpreter::build(const std::string& script,
+                                DictionaryModel::SharedPtr dictionaryModel,
+                                InterpreterFeedback& interpreterFeedback,
+                                ThreadPool& threadPool) {
+  ScenarioReader scenarioReader(script);
+  return buildModel(scenarioReader, dictionaryModel, interpreterFeedback,
+                    &threadPool, NULL);
+}
+
+ChatbotModel Interpreter::build(const std::string& script,
+                                DictionaryModel::SharedPtr dictionaryModel,
+                                InterpreterFeedback& interpreterFeedback,
+                                InterpreterCache& cache) {
+  ScenarioReader scenarioReader(script);
+  return buildModel(scenarioReader, dictionaryModel, interpreterFeedback, NULL,
+                    &cache);
+}
+
+ChatbotModel Interpreter::build(std::istream& script,
+                                DictionaryModel::SharedPtr dictionaryModel,
+                                InterpreterFeedback& interpreterFeedback) {
+  ScenarioReader scenarioReader(script);
+  return buildModel(scenarioReader, dictionaryModel, interpreterFeedback, NULL,
+                    NULL);
+}
+
+ChatbotModel Interpreter::build(std::istream& script,
+                                DictionaryModel::SharedPtr dictionaryModel,
+                                InterpreterFeedback& interpreterFeedback,
+                                InterpreterCache& cache) {
+  ScenarioReader scenarioReader(script);
+  return buildModel(scenarioReader, dictionaryModel, interpreterFeedback, NULL,
+                    &cache);
+}
 }
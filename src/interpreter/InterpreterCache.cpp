@@ -0,0 +1,161 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "intent/interpreter/InterpreterCache.hpp"
+
+#include "intent/utils/BinaryStream.hpp"
+
+#include <boost/functional/hash.hpp>
+
+#include <sstream>
+
+namespace intent {
+
+namespace {
+uint64_t hashScenario(const Scenario& scenario) {
+  size_t hash = scenario.size();
+  for (const ScriptLine& line : scenario) {
+    boost::hash_combine(hash, line.content);
+    boost::hash_combine(hash, line.position - scenario[0].position);
+  }
+  return hash;
+}
+
+bool isSameScenario(const Scenario& lhs, const Scenario& rhs) {
+  if (lhs.size() != rhs.size()) return false;
+  for (size_t i = 0; i < lhs.size(); ++i) {
+    if (lhs[i].content != rhs[i].content ||
+        lhs[i].position - lhs[0].position != rhs[i].position - rhs[0].position)
+      return false;
+  }
+  return true;
+}
+
+uint64_t hashDictionary(const DictionaryModel& dictionaryModel) {
+  // The order of the entities depends on the history of the hash map.
+  size_t entitiesHash = 0;
+  for (const DictionaryModel::EntityByEntityIdIndex::value_type& entity :
+       dictionaryModel.entitiesByEntityId) {
+    size_t entityHash = 0;
+    boost::hash_combine(entityHash, entity.first);
+    boost::hash_combine(entityHash, entity.second);
+    entitiesHash += entityHash;
+  }
+
+  size_t hash = entitiesHash;
+  for (const DictionaryModel::Regex& regex : dictionaryModel.regexes) {
+    boost::hash_combine(hash, regex.pattern);
+    boost::hash_combine(hash, regex.entityId);
+  }
+
+  std::stringstream terms;
+  BinaryWriter writer(terms);
+  dictionaryModel.dictionary.writeTo(writer);
+  boost::hash_combine(hash, terms.str());
+  return hash;
+}
+}  // anonymous
+
+InterpreterCache::InterpreterCache() : m_dictionaryHash(0) {}
+
+void InterpreterCache::clear() {
+  m_entries.clear();
+  m_nextEntries.clear();
+  m_dictionaryModel.reset();
+  m_dictionaryHash = 0;
+}
+
+size_t InterpreterCache::size() const { return m_entries.size(); }
+
+void InterpreterCache::beginBuild(DictionaryModel::SharedPtr dictionaryModel) {
+  m_nextEntries.clear();
+
+  // The dictionary is only hashed when it is not the one of the last build.
+  if (m_dictionaryModel.lock() == dictionaryModel) return;
+
+  uint64_t dictionaryHash = hashDictionary(*dictionaryModel);
+  if (dictionaryHash != m_dictionaryHash) m_entries.clear();
+  m_dictionaryModel = dictionaryModel;
+  m_dictionaryHash = dictionaryHash;
+}
+
+InterpreterCache::Entries::const_iterator InterpreterCache::findEntry(
+    const Entries& entries, uint64_t hash, const Scenario& scenario) {
+  std::pair<Entries::const_iterator, Entries::const_iterator> range =
+      entries.equal_range(hash);
+  for (Entries::const_iterator it = range.first; it != range.second; ++it) {
+    if (isSameScenario(it->second.scenario, scenario)) return it;
+  }
+  return entries.end();
+}
+
+CompiledScenario::SharedPtr InterpreterCache::find(const Scenario& scenario,
+                                                   int& positionShift) {
+  uint64_t hash = hashScenario(scenario);
+
+  // A scenario repeated in the script has already been moved.
+  Entries::const_iterator it = findEntry(m_nextEntries, hash, scenario);
+  if (it == m_nextEntries.end()) {
+    it = findEntry(m_entries, hash, scenario);
+    if (it == m_entries.end()) return CompiledScenario::SharedPtr();
+    it = m_nextEntries.insert(*it);
+  }
+
+  const Scenario& compiledLines = it->second.scenario;
+  positionShift = 0;
+  if (!scenario.empty())
+    positionShift = static_cast<int>(scenario[0].position) -
+                    static_cast<int>(compiledLines[0].position);
+  return it->second.compiledScenario;
+}
+
+void InterpreterCache::insert(const Scenario& scenario,
+                              CompiledScenario::SharedPtr compiledScenario) {
+  Entry entry;
+  entry.scenario = scenario;
+  entry.compiledScenario = compiledScenario;
+  m_nextEntries.insert(std::make_pair(hashScenario(scenario), entry));
+}
+
+void InterpreterCache::endBuild() {
+  m_entries.swap(m_nextEntries);
+  m_nextEntries.clear();
+}
+}
@@ -43,7 +43,6 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <boost/algorithm/string.hpp>
 
 #include "intent/interpreter/LineTagger.hpp"
-#include "intent/utils/SingleCharacterDelimiterTokenizer.hpp"
 
 namespace intent {
 
@@ -89,39 +88,60 @@ void indexScenario(const Scenario& scenario,
       });
 }
 
-std::vector<ScriptLine> tokenizeInLines(const std::string& input) {
-  std::vector<std::string> lines;
-  std::vector<char> delimiters = {'\n'};
-  SingleCharacterDelimiterTokenizer::tokenize(input, delimiters, lines);
-  std::vector<ScriptLine> scriptLines;
-  for (unsigned int i = 0; i < lines.size(); ++i) {
-    scriptLines.push_back({lines[i], i});
+ScenarioReader::ScenarioReader(std::istream& script)
+    : m_stream(&script), m_position(0), m_braceCounter(0) {}
+
+ScenarioReader::ScenarioReader(boost::string_ref script)
+    : m_stream(NULL), m_script(script), m_position(0), m_braceCounter(0) {}
+
+bool ScenarioReader::nextLine(std::string& line) {
+  // The empty lines are skipped and not numbered.
+  if (m_stream) {
+    while (std::getline(*m_stream, line)) {
+      if (!line.empty()) return true;
+    }
+    return false;
+  }
+
+  while (!m_script.empty()) {
+    size_t end = m_script.find('\n');
+    if (end == boost::string_ref::npos) end = m_script.size();
+    boost::string_ref content = m_script.substr(0, end);
+    m_script.remove_prefix(std::min(end + 1, m_script.size()));
+    if (!content.empty()) {
+      line.assign(content.data(), content.size());
+      return true;
+    }
   }
-  return scriptLines;
+  return false;
+}
+
+bool ScenarioReader::next(Scenario& scenario) {
+  scenario.clear();
+  std::string content;
+  while (nextLine(content)) {
+    ScriptLine line(content, m_position++);
+    boost::trim(line.content);
+    if (isLine<CLOSE_SCENARIO>(line)) {
+      --m_braceCounter;
+    }
+    if (m_braceCounter == 1) {
+      scenario.push_back(line);
+    }
+    if (isLine<START_SCENARIO>(line)) {
+      ++m_braceCounter;
+    }
+    if (m_braceCounter == 0 && !scenario.empty()) return true;
+  }
+
+  // An unclosed scenario is dropped.
+  scenario.clear();
+  return false;
 }
 
 void extractScenarios(const std::string& script, Scenarios& scenarios) {
-  int braceCounter = 0;
+  ScenarioReader reader(script);
   Scenario scenario;
-  std::vector<ScriptLine> lines = tokenizeInLines(script);
-
-  std::for_each(lines.begin(), lines.end(),
-                [&scenarios, &scenario, &braceCounter](ScriptLine& line) {
-                  boost::trim(line.content);
-                  if (isLine<CLOSE_SCENARIO>(line)) {
-                    --braceCounter;
-                  }
-                  if (braceCounter == 1) {
-                    scenario.push_back(line);
-                  }
-                  if (isLine<START_SCENARIO>(line)) {
-                    ++braceCounter;
-                  }
-                  if (braceCounter == 0) {
-                    if (!scenario.empty()) scenarios.push_back(scenario);
-                    scenario.clear();
-                  }
-
-                });
+  while (reader.next(scenario)) scenarios.push_back(std::move(scenario));
 }
 }
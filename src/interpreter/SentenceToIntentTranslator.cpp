@@ -106,13 +106,12 @@ std::string logEntities(const std::vector<int>& entityIds,
   return entitiesString.substr(0, entitiesString.size() - 2);
 }
 
-std::pair<IndexType, Intent> SentenceToIntentTranslator::translate(
-    const std::string& sentence, const DictionaryModel& dictionaryModel) {
+namespace {
+Intent translateTokens(const std::string& sentence,
+                       const std::vector<std::string>& tokens,
+                       const DictionaryModel& dictionaryModel) {
   IntentModel::Intent intent;
 
-  std::vector<std::string> tokens;
-  SentenceTokenizer sentenceTokenizer(dictionaryModel);
-  sentenceTokenizer.tokenize(sentence, tokens);
   std::vector<int> entities =
       extractEntities(EntitiesMatcher::match(tokens, dictionaryModel));
   intent.entities = entities;
@@ -125,9 +124,61 @@ std::pair<IndexType, Intent> SentenceToIntentTranslator::translate(
                            "\" into intent with following entities [" +
                            logEntities(entities, dictionaryModel) + "].";
 
-  std::string intentId = IntentEncoder::encode(entities);
-  intent.intentId = intentId;
+  intent.intentId = IntentEncoder::encode(entities);
+  intent.example = sentence;
+  return intent;
+}
+
+// The tokens fully determine the translation. A script line never contains a
+// new line so it cannot appear in a token.
+std::string normalize(const std::vector<std::string>& tokens) {
+  std::string normalized;
+  for (const std::string& token : tokens) {
+    normalized += token;
+    normalized += '\n';
+  }
+  return normalized;
+}
+}  // anonymous
+
+SentenceToIntentTranslator::SentenceToIntentTranslator(
+    const DictionaryModel& dictionaryModel)
+    : m_dictionaryModel(dictionaryModel),
+      m_sentenceTokenizer(dictionaryModel) {}
+
+std::pair<IndexType, Intent> SentenceToIntentTranslator::translate(
+    const std::string& sentence, const DictionaryModel& dictionaryModel) {
+  std::vector<std::string> tokens;
+  SentenceTokenizer sentenceTokenizer(dictionaryModel);
+  sentenceTokenizer.tokenize(sentence, tokens);
+
+  Intent intent = translateTokens(sentence, tokens, dictionaryModel);
+  return std::pair<IndexType, Intent>(intent.intentId, intent);
+}
+
+std::pair<IndexType, Intent> SentenceToIntentTranslator::translate(
+    const std::string& sentence) {
+  std::vector<std::string> tokens;
+  m_sentenceTokenizer.tokenize(sentence, tokens);
+  std::string normalized = normalize(tokens);
+
+  Intent intent;
+  std::unique_lock<std::mutex> lock(m_mutex);
+  std::unordered_map<std::string, Intent>::const_iterator it =
+      m_intentsByTokens.find(normalized);
+  if (it != m_intentsByTokens.end()) {
+    intent = it->second;
+    lock.unlock();
+  } else {
+    // Other threads keep using the cache during the translation.
+    lock.unlock();
+    intent = translateTokens(sentence, tokens, m_dictionaryModel);
+    lock.lock();
+    m_intentsByTokens.insert(std::make_pair(normalized, intent));
+    lock.unlock();
+  }
+
   intent.example = sentence;
-  return std::pair<std::string, IntentModel::Intent>(intentId, intent);
+  return std::pair<IndexType, Intent>(intent.intentId, intent);
 }
 }
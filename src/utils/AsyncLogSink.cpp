@@ -0,0 +1,156 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "intent/utils/AsyncLogSink.hpp"
+
+#include <chrono>
+#include <utility>
+
+namespace intent {
+namespace log {
+
+namespace {
+// The flusher also wakes up periodically, a notification missed while it
+// goes to sleep then only delays the output.
+const std::chrono::milliseconds FLUSHER_TIMEOUT(50);
+const std::chrono::microseconds FLUSH_POLLING_PERIOD(100);
+}
+
+AsyncLogSink::AsyncLogSink(size_t capacity,
+                           OverflowPolicy::type overflowPolicy, Writer writer)
+    : m_queue(capacity),
+      m_overflowPolicy(overflowPolicy),
+      m_writer(std::move(writer)),
+      m_pushedMessages(0),
+      m_consumedMessages(0),
+      m_droppedMessages(0),
+      m_flusherWaiting(false),
+      m_stopping(false) {
+  m_flusher = std::thread(&AsyncLogSink::run, this);
+}
+
+AsyncLogSink::~AsyncLogSink() {
+  {
+    std::lock_guard<std::mutex> lock(m_wakeMutex);
+    m_stopping = true;
+  }
+  m_wake.notify_one();
+  m_flusher.join();
+}
+
+void AsyncLogSink::push(int severityLevel, std::string message) {
+  Entry entry;
+  entry.severityLevel = severityLevel;
+  entry.message = std::move(message);
+
+  while (!m_queue.tryPush(entry)) {
+    if (m_overflowPolicy == OverflowPolicy::DROP_NEWEST) {
+      m_droppedMessages.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
+    if (m_overflowPolicy == OverflowPolicy::DROP_OLDEST) {
+      Entry oldest;
+      if (m_queue.tryPop(oldest)) {
+        m_droppedMessages.fetch_add(1, std::memory_order_relaxed);
+        m_consumedMessages.fetch_add(1, std::memory_order_release);
+      }
+    } else {
+      wakeFlusher();
+      std::this_thread::yield();
+    }
+  }
+  m_pushedMessages.fetch_add(1, std::memory_order_release);
+
+  // Pairs with the fence of the flusher so that either it sees the message
+  // or the message sees it waiting.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (m_flusherWaiting.load(std::memory_order_relaxed)) wakeFlusher();
+}
+
+void AsyncLogSink::flush() {
+  size_t pushedMessages = m_pushedMessages.load(std::memory_order_acquire);
+  while (m_consumedMessages.load(std::memory_order_acquire) < pushedMessages) {
+    wakeFlusher();
+    std::this_thread::sleep_for(FLUSH_POLLING_PERIOD);
+  }
+}
+
+void AsyncLogSink::wakeFlusher() {
+  std::lock_guard<std::mutex> lock(m_wakeMutex);
+  m_wake.notify_one();
+}
+
+void AsyncLogSink::write(Entry& entry) {
+  try {
+    m_writer(entry.severityLevel, entry.message);
+  } catch (...) {
+    // A failing output must not stop the flusher.
+  }
+  m_consumedMessages.fetch_add(1, std::memory_order_release);
+}
+
+void AsyncLogSink::run() {
+  Entry entry;
+  for (;;) {
+    if (m_queue.tryPop(entry)) {
+      write(entry);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+    if (m_stopping) break;
+
+    m_flusherWaiting.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_queue.tryPop(entry)) {
+      m_flusherWaiting.store(false, std::memory_order_relaxed);
+      lock.unlock();
+      write(entry);
+      continue;
+    }
+    m_wake.wait_for(lock, FLUSHER_TIMEOUT);
+    m_flusherWaiting.store(false, std::memory_order_relaxed);
+  }
+
+  while (m_queue.tryPop(entry)) write(entry);
+}
+}
+}
@@ -46,53 +46,36 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "intent/utils/Deserializer.hpp"
 #include "intent/utils/SingleCharacterDelimiterTokenizer.hpp"
 #include "intent/intent_service/IntentEncoder.hpp"
+#include "intent/utils/JsonReader.hpp"
 #include "json.hpp"
 
+#include <map>
+#include <sstream>
+
 namespace intent {
 const std::string Deserializer::REGEX_SYMBOL = "regex";
 
-bool isTermRegex(const nlohmann::json::object_t::const_iterator& term) {
-  const std::string termText = term->first;
-  return termText == Deserializer::REGEX_SYMBOL;
-}
-
-void deserializeDictionary(const nlohmann::json::object_t& dictionary,
-                           DictionaryModel& dictionaryModel) {
-  nlohmann::json::object_t::const_iterator entitiesIt = dictionary.begin();
-  nlohmann::json::object_t::const_iterator entitiesItEnd = dictionary.end();
-
-  unsigned int termId = 0;
-  for (unsigned int i = 0; entitiesIt != entitiesItEnd; ++entitiesIt, i++) {
-    dictionaryModel.entitiesByEntityId[i] = entitiesIt->first;
-
-    const nlohmann::json::object_t& termsAndAlias = entitiesIt->second;
-    nlohmann::json::object_t::const_iterator termsAndAliasIt =
-        termsAndAlias.begin();
-    nlohmann::json::object_t::const_iterator termsAndAliasItEnd =
-        termsAndAlias.end();
-
-    for (; termsAndAliasIt != termsAndAliasItEnd; ++termsAndAliasIt) {
-      if (isTermRegex(termsAndAliasIt)) {
-        dictionaryModel.regexesByEntityId[termsAndAliasIt->second] = i;
-      } else {
-        Term term;
-
-        term.term = termsAndAliasIt->first;
-        term.termId = termId;
-        term.entityId = i;
+namespace {
+// The slot of the regex among the terms of an entity.
+const int REGEX_SLOT = -1;
 
-        nlohmann::json::array_t alias = termsAndAliasIt->second;
-        nlohmann::json::array_t::const_iterator aliasIt = alias.begin();
-        nlohmann::json::array_t::const_iterator aliasItEnd = alias.end();
+void expectValueType(JsonReader& reader, JsonReader::ValueType::type type) {
+  if (reader.peekValueType() != type)
+    throw DeserializerException("Unexpected JSON value type");
+}
 
-        for (unsigned int k = 0; aliasIt != aliasItEnd; aliasIt++, ++k) {
-          term.alias.push_back(*aliasIt);
-        }
+void readStringValue(JsonReader& reader, std::string& value) {
+  expectValueType(reader, JsonReader::ValueType::STRING);
+  reader.readString(value);
+}
 
-        dictionaryModel.dictionary.pushTerm(term);
-      }
-      termId++;
-    }
+void readStrings(JsonReader& reader, std::vector<std::string>& values) {
+  expectValueType(reader, JsonReader::ValueType::ARRAY);
+  values.clear();
+  reader.beginArray();
+  while (reader.nextElement()) {
+    values.push_back(std::string());
+    readStringValue(reader, values.back());
   }
 }
 
@@ -108,396 +91,495 @@ int findEntity(const std::unordered_map<int, std::string>& entities,
   return -1;
 }
 
-void deserializeIntentSchema(const nlohmann::json::array_t& intentVector,
-                             const DictionaryModel& dictionaryModel,
-                             IntentModel::Intent& intent) {
-  std::unordered_map<std::string, int> entitiesCounter;
-  for (unsigned int i = 0; i < intentVector.size(); ++i) {
-    const std::string& namedEntity = intentVector.at(i);
-    std::vector<std::string> entityTokens;
-    SingleCharacterDelimiterTokenizer::tokenize(namedEntity, ":", entityTokens);
-
-    std::string entity;
-    std::string name;
-    if (entityTokens.size() == 2) {
-      entity = entityTokens[0];
-      name = entityTokens[1];
-    } else if (entityTokens.size() == 1) {
-      entity = entityTokens[0];
-      name = entity + std::to_string(entitiesCounter[entity]);
-      ++entitiesCounter[entity];
-    }
+void appendNamedEntity(const std::string& namedEntity,
+                       const DictionaryModel& dictionaryModel,
+                       std::unordered_map<std::string, int>& entitiesCounter,
+                       IntentModel::Intent& intent) {
+  std::vector<std::string> entityTokens;
+  SingleCharacterDelimiterTokenizer::tokenize(namedEntity, ":", entityTokens);
+
+  std::string entity;
+  std::string name;
+  if (entityTokens.size() == 2) {
+    entity = entityTokens[0];
+    name = entityTokens[1];
+  } else if (entityTokens.size() == 1) {
+    entity = entityTokens[0];
+    name = entity + std::to_string(entitiesCounter[entity]);
+    ++entitiesCounter[entity];
+  }
 
-    if (!entity.empty()) {
-      int entityId = findEntity(dictionaryModel.entitiesByEntityId, entity);
-      intent.entities.push_back(entityId);
+  if (!entity.empty()) {
+    int entityId = findEntity(dictionaryModel.entitiesByEntityId, entity);
+    intent.entities.push_back(entityId);
 
-      // TODO : check if name already in queue
-      intent.entityToVariableNames[entity].push(name);
-    }
+    // TODO : check if name already in queue
+    intent.entityToVariableNames[entity].push(name);
   }
 }
 
-void deserializeIntents(const nlohmann::json::array_t& intents,
-                        const DictionaryModel& dictionaryModel,
-                        IntentModel& intentModel) {
-  nlohmann::json::array_t::const_iterator intentIt = intents.begin();
-  nlohmann::json::array_t::const_iterator intentItEnd = intents.end();
-
-  for (; intentIt != intentItEnd; ++intentIt) {
-    const nlohmann::json& intentJson = *intentIt;
+IntentStoryModel::StoryGraph::Vertex findOrAddVertex(
+    const std::string& stateId, IntentStoryModel& intentStoryModel) {
+  IntentStoryModel::VertexByStateIdIndex::const_iterator it =
+      intentStoryModel.vertexByStateId.find(stateId);
+  if (it != intentStoryModel.vertexByStateId.end()) {
+    return it->second;
+  }
 
-    IntentModel::Intent intent;
-    nlohmann::json::const_iterator intentIt = intentJson.find("intent");
-    const std::string& intentId = intentJson["id"].get<std::string>();
+  IntentStoryModel::VertexInfo vertexInfo;
+  vertexInfo.stateId = stateId;
+  IntentStoryModel::StoryGraph::Vertex vertex =
+      intentStoryModel.graph.addVertex(vertexInfo);
+  intentStoryModel.vertexByStateId[stateId] = vertex;
+  return vertex;
+}
 
-    if (intentIt != intentJson.end()) {
-      deserializeIntentSchema(*intentIt, dictionaryModel, intent);
-    }
+void addStoryEdge(const std::string& sourceId,
+                  const std::string& intentAndAction,
+                  const std::string& targetId,
+                  IntentStoryModel& intentStoryModel) {
+  std::vector<std::string> tokens;
+  SingleCharacterDelimiterTokenizer::tokenize(intentAndAction, ":", tokens);
 
-    nlohmann::json::const_iterator exampleIt = intentJson.find("example");
-    if (exampleIt != intentJson.end()) {
-      intent.example = *exampleIt;
-    }
+  std::string intentName;
+  std::string actionId;
+  intentName = tokens[0];
+  if (tokens.size() == 2) actionId = tokens[1];
 
-    intentModel.intentsByIntentId[intentId] = intent;
-  }
-}
+  IntentStoryModel::EdgeInfo edgeInfo;
+  edgeInfo.intent.intentId = intentName;
+  edgeInfo.actionId = actionId;
 
-void deserializeGraph(const nlohmann::json::object_t& graph,
-                      IntentStoryModel& intentStoryModel) {
-  nlohmann::json::object_t::const_iterator sourceEdgeIt = graph.begin();
-  nlohmann::json::object_t::const_iterator sourceEdgeItEnd = graph.end();
-
-  for (; sourceEdgeIt != sourceEdgeItEnd; ++sourceEdgeIt) {
-    const std::string& sourceId = sourceEdgeIt->first;
-    const nlohmann::json::object_t& edgeTarget = sourceEdgeIt->second;
-
-    nlohmann::json::object_t::const_iterator edgeTargetIt = edgeTarget.begin();
-    nlohmann::json::object_t::const_iterator edgeTargetItEnd = edgeTarget.end();
-
-    for (; edgeTargetIt != edgeTargetItEnd; ++edgeTargetIt) {
-      const std::string& intentAndAction = edgeTargetIt->first;
-      std::vector<std::string> tokens;
-      SingleCharacterDelimiterTokenizer::tokenize(intentAndAction, ":", tokens);
-
-      std::string intentName;
-      std::string actionId;
-      intentName = tokens[0];
-      if (tokens.size() == 2) actionId = tokens[1];
-
-      const std::string& targetId = edgeTargetIt->second;
-
-      IntentStoryModel::EdgeInfo edgeInfo;
-      edgeInfo.intent.intentId = intentName;
-      edgeInfo.actionId = actionId;
-
-      IntentStoryModel::StoryGraph::Vertex source;
-      IntentStoryModel::StoryGraph::Vertex target;
-
-      IntentStoryModel::VertexByStateIdIndex::const_iterator it =
-          intentStoryModel.vertexByStateId.find(sourceId);
-      if (it != intentStoryModel.vertexByStateId.end()) {
-        source = it->second;
-      } else  // Adding vertex
-      {
-        IntentStoryModel::VertexInfo vertexInfo;
-        vertexInfo.stateId = sourceId;
-        source = intentStoryModel.graph.addVertex(vertexInfo);
-        intentStoryModel.vertexByStateId[sourceId] = source;
-      }
+  IntentStoryModel::StoryGraph::Vertex source =
+      findOrAddVertex(sourceId, intentStoryModel);
+  IntentStoryModel::StoryGraph::Vertex target =
+      findOrAddVertex(targetId, intentStoryModel);
 
-      it = intentStoryModel.vertexByStateId.find(targetId);
-      if (it != intentStoryModel.vertexByStateId.end()) {
-        target = it->second;
-      } else  // Adding vertex
-      {
-        IntentStoryModel::VertexInfo vertexInfo;
-        vertexInfo.stateId = targetId;
-        target = intentStoryModel.graph.addVertex(vertexInfo);
-        intentStoryModel.vertexByStateId[targetId] = target;
-      }
+  intentStoryModel.graph.addEdge(source, target, edgeInfo);
+}
 
-      intentStoryModel.graph.addEdge(source, target, edgeInfo);
-    }
-  }
+void setRootState(const std::string& stateId,
+                  IntentStoryModel& intentStoryModel) {
+  IntentStoryModel::VertexInfo vInfo;
+  vInfo.stateId = stateId;
+  IntentStoryModel::StoryGraph::Vertex v =
+      intentStoryModel.graph.addVertex(vInfo);
+  intentStoryModel.vertexByStateId[vInfo.stateId] = v;
+  intentStoryModel.rootStateId = vInfo.stateId;
 }
 
-void deserializeIntentStory(const nlohmann::json& story,
-                            IntentStoryModel& intentStoryModel) {
-  nlohmann::json::const_iterator it;
-
-  it = story.find("root");
-  if (it != story.end() && (*it).is_string()) {
-    IntentStoryModel::VertexInfo vInfo;
-    vInfo.stateId = *it;
-    IntentStoryModel::StoryGraph::Vertex v =
-        intentStoryModel.graph.addVertex(vInfo);
-    intentStoryModel.vertexByStateId[vInfo.stateId] = v;
-    intentStoryModel.rootStateId = vInfo.stateId;
+/**
+ * \brief Builds the models from the events of a JsonReader, neither the
+ * document nor a DOM of it is held in memory.
+ *
+ * The ids are the ones given by walking the sorted objects of a DOM, the
+ * last of duplicated keys winning, whatever the order of the keys in the
+ * stream. The terms are pushed into the dictionary as they are read, under
+ * a temporary id, and renumbered once every entity is read: until then only
+ * the ids of the terms are kept, along with the keys of the entity being
+ * read to sort its terms. The schemas of the intents read before the
+ * entities are kept until the entity ids are known. The story graph is kept
+ * as its keys until the story is read, the vertex ids following the sorted
+ * state ids, it is small next to the dictionary.
+ */
+class ModelBuilder {
+ public:
+  /**
+   * \brief The parts of the document to read, the others are skipped.
+   */
+  enum Part { DICTIONARY = 1, INTENTS = 2, INTENT_STORY = 4, CHATBOT = 8 };
+
+  ModelBuilder(int parts, ChatbotModel& model)
+      : m_parts(parts),
+        m_model(model),
+        m_termCount(0),
+        m_entityCount(0),
+        m_entitiesRead(false),
+        m_intentsBuilt(false) {}
+
+  /**
+   * \brief Read the parts of a document from a stream. A part whose value
+   * does not have the expected type is ignored.
+   */
+  void read(std::istream& is);
+
+ private:
+  struct Entity {
+    int temporaryId;
+    // The temporary ids of the terms in the order of their keys.
+    std::vector<int> termSlots;
+    std::string regex;
+  };
+
+  struct Intent {
+    std::string id;
+    std::vector<std::string> schema;
+    std::string example;
+  };
+
+  DictionaryModel& dictionaryModel() {
+    return *m_model.intentStoryServiceModel.intentServiceModel.dictionaryModel;
   }
 
-  it = story.find("graph");
-  if (it != story.end() && (*it).is_object()) {
-    deserializeGraph(*it, intentStoryModel);
+  IntentModel& intentModel() {
+    return *m_model.intentStoryServiceModel.intentServiceModel.intentModel;
   }
-}
 
-void deserializeIntentModel(const nlohmann::json& input,
-                            const DictionaryModel& dictionaryModel,
-                            IntentModel& intentModel) {
-  nlohmann::json::const_iterator it = input.find("intents");
-  if (it != input.end() && (*it).is_array()) {
-    const nlohmann::json::array_t& intents = *it;
-    deserializeIntents(intents, dictionaryModel, intentModel);
+  IntentStoryModel& intentStoryModel() {
+    return *m_model.intentStoryServiceModel.intentStoryModel;
   }
-}
 
-void deserializeDictionaryModel(const nlohmann::json& input,
-                                DictionaryModel& dictionaryModel) {
-  nlohmann::json::const_iterator it = input.find("entities");
-  if (it != input.end() && (*it).is_object()) {
-    deserializeDictionary(*it, dictionaryModel);
+  ChatbotActionModel& chatbotActionModel() {
+    return *m_model.chatbotActionModel;
   }
-}
 
-DictionaryModel::SharedPtr Deserializer::deserialize(
-    std::istream& is, Type2Type<DictionaryModel::SharedPtr> type) {
-  std::istreambuf_iterator<char> eos;
-  std::string s(std::istreambuf_iterator<char>(is), eos);
-  nlohmann::json document;
-  try {
-    document = nlohmann::json::parse(s);
-  } catch (...) {
-    throw DeserializerException("Error while parsing JSON");
+  void resetEntities();
+  void readEntities(JsonReader& reader);
+  void numberEntities();
+  void readIntents(JsonReader& reader);
+  void buildIntent(const Intent& intent);
+  void readIntentStory(JsonReader& reader);
+  void readChatbot(JsonReader& reader);
+  void readReplyIdsByStateAndAction(JsonReader& reader);
+
+  int m_parts;
+  ChatbotModel& m_model;
+
+  std::map<std::string, Entity> m_entities;
+  int m_termCount;
+  int m_entityCount;
+  bool m_entitiesRead;
+
+  std::vector<Intent> m_stagedIntents;
+  bool m_intentsBuilt;
+};
+
+void ModelBuilder::read(std::istream& is) {
+  JsonReader reader(is);
+  std::string key;
+
+  if (reader.peekValueType() != JsonReader::ValueType::OBJECT) {
+    reader.skipValue();
+    reader.end();
+    return;
   }
-  return deserialize(document, type);
-}
 
-DictionaryModel::SharedPtr Deserializer::deserialize(
-    const nlohmann::json& input, Type2Type<DictionaryModel::SharedPtr>) {
-  DictionaryModel::SharedPtr dictionaryModel(new DictionaryModel());
-
-  try {
-    deserializeDictionaryModel(input, *dictionaryModel);
-  } catch (...) {
-    throw DeserializerException("Error while parsing JSON");
+  reader.beginObject();
+  while (reader.nextKey(key)) {
+    JsonReader::ValueType::type type = reader.peekValueType();
+    if (key == "entities" && (m_parts & DICTIONARY)) {
+      resetEntities();
+      if (type == JsonReader::ValueType::OBJECT) {
+        readEntities(reader);
+        continue;
+      }
+    } else if (key == "intents" && (m_parts & INTENTS)) {
+      intentModel().intentsByIntentId.clear();
+      m_stagedIntents.clear();
+      m_intentsBuilt = false;
+      if (type == JsonReader::ValueType::ARRAY) {
+        readIntents(reader);
+        continue;
+      }
+    } else if (key == "intent_story" && (m_parts & INTENT_STORY)) {
+      m_model.intentStoryServiceModel.intentStoryModel.reset(
+          new IntentStoryModel());
+      if (type == JsonReader::ValueType::OBJECT) {
+        readIntentStory(reader);
+        continue;
+      }
+    } else if (key == "chatbot" && (m_parts & CHATBOT)) {
+      m_model.chatbotActionModel.reset(new ChatbotActionModel());
+      if (type == JsonReader::ValueType::OBJECT) {
+        readChatbot(reader);
+        continue;
+      }
+    }
+    reader.skipValue();
   }
+  reader.end();
 
-  return dictionaryModel;
+  for (const Intent& intent : m_stagedIntents) buildIntent(intent);
+  std::vector<Intent>().swap(m_stagedIntents);
+  if (m_parts & INTENT_STORY) intentStoryModel().graph.freeze();
 }
 
-IntentServiceModel Deserializer::deserialize(
-    std::istream& is, Type2Type<IntentServiceModel> type) {
-  std::istreambuf_iterator<char> eos;
-  std::string s(std::istreambuf_iterator<char>(is), eos);
+void ModelBuilder::resetEntities() {
+  // The intents already built refer to the ids of the previous entities.
+  if (m_intentsBuilt)
+    throw DeserializerException("Entities given again after the intents");
+
+  m_model.intentStoryServiceModel.intentServiceModel.dictionaryModel.reset(
+      new DictionaryModel());
+  m_entities.clear();
+  m_termCount = 0;
+  m_entityCount = 0;
+  m_entitiesRead = false;
+}
 
-  nlohmann::json document;
-  try {
-    document = nlohmann::json::parse(s);
-  } catch (...) {
-    throw DeserializerException("Error while parsing JSON");
-  }
+void ModelBuilder::readEntities(JsonReader& reader) {
+  std::map<std::string, int> slotsByKey;
+  std::string name;
+  std::string key;
+
+  reader.beginObject();
+  while (reader.nextKey(name)) {
+    // A duplicated entity replaces the previous one, whose terms are dropped.
+    Entity& entity = m_entities[name];
+    entity.temporaryId = m_entityCount++;
+    entity.regex.clear();
+    slotsByKey.clear();
+
+    expectValueType(reader, JsonReader::ValueType::OBJECT);
+    reader.beginObject();
+    while (reader.nextKey(key)) {
+      if (key == Deserializer::REGEX_SYMBOL) {
+        readStringValue(reader, entity.regex);
+        slotsByKey[key] = REGEX_SLOT;
+        continue;
+      }
 
-  return deserialize(document, type);
-}
+      Term term;
+      term.term = key;
+      term.termId = m_termCount++;
+      term.entityId = entity.temporaryId;
+      readStrings(reader, term.alias);
 
-IntentServiceModel Deserializer::deserialize(
-    const nlohmann::json& input, Type2Type<IntentServiceModel> type) {
-  IntentServiceModel intentServiceModel;
-  intentServiceModel.dictionaryModel.reset(new DictionaryModel());
-  intentServiceModel.intentModel.reset(new IntentModel());
+      dictionaryModel().dictionary.pushTerm(term);
+      slotsByKey[key] = term.termId;
+    }
 
-  try {
-    deserializeDictionaryModel(input, *intentServiceModel.dictionaryModel);
-    deserializeIntentModel(input, *intentServiceModel.dictionaryModel,
-                           *intentServiceModel.intentModel);
-  } catch (...) {
-    throw DeserializerException("Error while parsing JSON");
+    entity.termSlots.clear();
+    for (const std::map<std::string, int>::value_type& slot : slotsByKey)
+      entity.termSlots.push_back(slot.second);
   }
-
-  return intentServiceModel;
+  numberEntities();
 }
 
-IntentStoryServiceModel Deserializer::deserialize(
-    std::istream& is, Type2Type<IntentStoryServiceModel> type) {
-  std::istreambuf_iterator<char> eos;
-  std::string s(std::istreambuf_iterator<char>(is), eos);
+void ModelBuilder::numberEntities() {
+  DictionaryModel& dictionary = dictionaryModel();
+  std::vector<int> termIdMap(m_termCount, -1);
+  std::vector<int> entityIdMap(m_entityCount, -1);
 
-  nlohmann::json document;
-  try {
-    document = nlohmann::json::parse(s);
-  } catch (...) {
-    throw DeserializerException("Error while parsing JSON");
+  int termId = 0;
+  int entityId = 0;
+  for (const std::map<std::string, Entity>::value_type& entity : m_entities) {
+    dictionary.entitiesByEntityId[entityId] = entity.first;
+    entityIdMap[entity.second.temporaryId] = entityId;
+
+    for (int slot : entity.second.termSlots) {
+      if (slot == REGEX_SLOT) {
+        dictionary.addRegex(entity.second.regex, entityId);
+      } else {
+        termIdMap[slot] = termId;
+      }
+      ++termId;
+    }
+    ++entityId;
   }
+  std::map<std::string, Entity>().swap(m_entities);
 
-  return deserialize(document, type);
+  dictionary.dictionary.renumberTerms(termIdMap, entityIdMap);
+  m_entitiesRead = true;
 }
 
-void deserializeIntentStoryModel(const nlohmann::json& input,
-                                 IntentStoryModel& intentStoryModel) {
-  nlohmann::json::const_iterator it;
+void ModelBuilder::readIntents(JsonReader& reader) {
+  std::string key;
+  reader.beginArray();
+  while (reader.nextElement()) {
+    Intent intent;
+    bool hasId = false;
+
+    expectValueType(reader, JsonReader::ValueType::OBJECT);
+    reader.beginObject();
+    while (reader.nextKey(key)) {
+      if (key == "id") {
+        readStringValue(reader, intent.id);
+        hasId = true;
+      } else if (key == "intent") {
+        readStrings(reader, intent.schema);
+      } else if (key == "example") {
+        readStringValue(reader, intent.example);
+      } else {
+        reader.skipValue();
+      }
+    }
 
-  it = input.find("intent_story");
-  if (it != input.end() && (*it).is_object()) {
-    deserializeIntentStory(*it, intentStoryModel);
+    if (!hasId) throw DeserializerException("Intent without id");
+    if (m_entitiesRead) {
+      buildIntent(intent);
+      m_intentsBuilt = true;
+    } else {
+      m_stagedIntents.push_back(std::move(intent));
+    }
   }
 }
 
-IntentStoryServiceModel Deserializer::deserialize(
-    const nlohmann::json& input, Type2Type<IntentStoryServiceModel> type) {
-  IntentStoryServiceModel intentStoryServiceModel;
-
-  intentStoryServiceModel.intentStoryModel =
-      IntentStoryModel::SharedPtr(new IntentStoryModel());
-  intentStoryServiceModel.intentServiceModel.intentModel =
-      IntentModel::SharedPtr(new IntentModel());
-  intentStoryServiceModel.intentServiceModel.dictionaryModel =
-      DictionaryModel::SharedPtr(new DictionaryModel());
-
-  try {
-    deserializeDictionaryModel(
-        input, *intentStoryServiceModel.intentServiceModel.dictionaryModel);
-    deserializeIntentModel(
-        input, *intentStoryServiceModel.intentServiceModel.dictionaryModel,
-        *intentStoryServiceModel.intentServiceModel.intentModel);
-    deserializeIntentStoryModel(input,
-                                *intentStoryServiceModel.intentStoryModel);
-  } catch (...) {
-    throw DeserializerException("Error while parsing JSON");
+void ModelBuilder::buildIntent(const Intent& intent) {
+  IntentModel::Intent builtIntent;
+  std::unordered_map<std::string, int> entitiesCounter;
+  for (const std::string& namedEntity : intent.schema) {
+    appendNamedEntity(namedEntity, dictionaryModel(), entitiesCounter,
+                      builtIntent);
   }
+  builtIntent.example = intent.example;
 
-  return intentStoryServiceModel;
+  intentModel().intentsByIntentId[intent.id] = builtIntent;
 }
 
-void deserializeReplies(const nlohmann::json::object_t& replies,
-                        ChatbotActionModel& chatbotActionModel) {
-  nlohmann::json::object_t::const_iterator replyIt = replies.begin();
-  nlohmann::json::object_t::const_iterator replyItEnd = replies.end();
+void ModelBuilder::readIntentStory(JsonReader& reader) {
+  typedef std::map<std::string, std::string> Edges;
+  std::map<std::string, Edges> graph;
+  bool hasRoot = false;
+  std::string root;
+
+  std::string key;
+  reader.beginObject();
+  while (reader.nextKey(key)) {
+    JsonReader::ValueType::type type = reader.peekValueType();
+    if (key == "root" && type == JsonReader::ValueType::STRING) {
+      reader.readString(root);
+      hasRoot = true;
+    } else if (key == "root") {
+      hasRoot = false;
+      reader.skipValue();
+    } else if (key == "graph" && type == JsonReader::ValueType::OBJECT) {
+      graph.clear();
+      reader.beginObject();
+      while (reader.nextKey(key)) {
+        Edges& edges = graph[key];
+        edges.clear();
+
+        expectValueType(reader, JsonReader::ValueType::OBJECT);
+        reader.beginObject();
+        while (reader.nextKey(key)) readStringValue(reader, edges[key]);
+      }
+    } else {
+      if (key == "graph") graph.clear();
+      reader.skipValue();
+    }
+  }
 
-  for (; replyIt != replyItEnd; ++replyIt) {
-    const std::string& replyId = replyIt->first;
-    const std::string& reply = replyIt->second;
+  IntentStoryModel& model = intentStoryModel();
+  if (hasRoot) setRootState(root, model);
+  for (const std::map<std::string, Edges>::value_type& source : graph) {
+    for (const Edges::value_type& edge : source.second)
+      addStoryEdge(source.first, edge.first, edge.second, model);
+  }
+}
 
-    chatbotActionModel.replyContentByReplyIdIndex[replyId] = reply;
+void ModelBuilder::readChatbot(JsonReader& reader) {
+  ChatbotActionModel& model = chatbotActionModel();
+  std::string key;
+  reader.beginObject();
+  while (reader.nextKey(key)) {
+    JsonReader::ValueType::type type = reader.peekValueType();
+    if (key == "replies") model.replyContentByReplyIdIndex.clear();
+    if (key == "replies_by_state_action")
+      model.replyIdsByStateAndActionId.clear();
+
+    if (type != JsonReader::ValueType::OBJECT) {
+      reader.skipValue();
+    } else if (key == "replies") {
+      reader.beginObject();
+      while (reader.nextKey(key))
+        readStringValue(reader, model.replyContentByReplyIdIndex[key]);
+    } else if (key == "replies_by_state_action") {
+      readReplyIdsByStateAndAction(reader);
+    } else {
+      reader.skipValue();
+    }
   }
 }
 
-void appendRepliesListByStateAndActionId(
-    const std::string& state, const std::string& actionId,
-    const nlohmann::json::array_t& repliesList,
-    ChatbotActionModel& chatbotActionModel) {
+void ModelBuilder::readReplyIdsByStateAndAction(JsonReader& reader) {
+  ChatbotActionModel::ReplyIdsByStateAndActionIdIndex& replyIds =
+      chatbotActionModel().replyIdsByStateAndActionId;
   ChatbotActionModel::StateAndActionId stateAndActionId;
-  stateAndActionId.state = state;
-  stateAndActionId.actionId = actionId;
 
-  for (const std::string& replyId : repliesList) {
-    chatbotActionModel.replyIdsByStateAndActionId[stateAndActionId].push_back(
-        replyId);
+  reader.beginObject();
+  while (reader.nextKey(stateAndActionId.state)) {
+    // A duplicated state replaces the actions of the previous one.
+    stateAndActionId.actionId.clear();
+    ChatbotActionModel::ReplyIdsByStateAndActionIdIndex::iterator it =
+        replyIds.lower_bound(stateAndActionId);
+    while (it != replyIds.end() && it->first.state == stateAndActionId.state)
+      it = replyIds.erase(it);
+
+    expectValueType(reader, JsonReader::ValueType::OBJECT);
+    reader.beginObject();
+    while (reader.nextKey(stateAndActionId.actionId))
+      readStrings(reader, replyIds[stateAndActionId]);
   }
 }
 
-void deserializeReplyIdsByActionId(
-    const nlohmann::json::object_t& repliesByAction, const std::string& state,
-    ChatbotActionModel& chatbotActionModel) {
-  nlohmann::json::object_t::const_iterator repliesByActionIt =
-      repliesByAction.begin();
-  nlohmann::json::object_t::const_iterator repliesByActionItEnd =
-      repliesByAction.end();
-
-  for (; repliesByActionIt != repliesByActionItEnd; ++repliesByActionIt) {
-    const std::string& actionId = repliesByActionIt->first;
-    const nlohmann::json::array_t& repliesList = repliesByActionIt->second;
+ChatbotModel readModel(std::istream& is, int parts) {
+  ChatbotModel chatbotModel;
+  IntentStoryServiceModel& intentStoryServiceModel =
+      chatbotModel.intentStoryServiceModel;
+  IntentServiceModel& intentServiceModel =
+      intentStoryServiceModel.intentServiceModel;
+  chatbotModel.chatbotActionModel.reset(new ChatbotActionModel());
+  intentStoryServiceModel.intentStoryModel.reset(new IntentStoryModel());
+  intentServiceModel.intentModel.reset(new IntentModel());
+  intentServiceModel.dictionaryModel.reset(new DictionaryModel());
 
-    appendRepliesListByStateAndActionId(state, actionId, repliesList,
-                                        chatbotActionModel);
+  try {
+    ModelBuilder(parts, chatbotModel).read(is);
+  } catch (...) {
+    throw DeserializerException("Error while parsing JSON");
   }
+
+  return chatbotModel;
+}
 }
 
-void deserializeReplyIdsByStateAndActionId(
-    const nlohmann::json::object_t& repliesByStatesAndActions,
-    ChatbotActionModel& chatbotActionModel) {
-  nlohmann::json::object_t::const_iterator repliesByStatesAndActionsIt =
-      repliesByStatesAndActions.begin();
-  nlohmann::json::object_t::const_iterator repliesByStatesAndActionsItEnd =
-      repliesByStatesAndActions.end();
-
-  for (; repliesByStatesAndActionsIt != repliesByStatesAndActionsItEnd;
-       ++repliesByStatesAndActionsIt) {
-    const std::string& state = repliesByStatesAndActionsIt->first;
-    const nlohmann::json::object_t& repliesByActions =
-        repliesByStatesAndActionsIt->second;
-
-    deserializeReplyIdsByActionId(repliesByActions, state, chatbotActionModel);
-  }
+DictionaryModel::SharedPtr Deserializer::deserialize(
+    std::istream& is, Type2Type<DictionaryModel::SharedPtr>) {
+  return readModel(is, ModelBuilder::DICTIONARY)
+      .intentStoryServiceModel.intentServiceModel.dictionaryModel;
 }
 
-void deserializeChatbotActions(const nlohmann::json& chatbot,
-                               ChatbotActionModel& chatbotActionModel) {
-  nlohmann::json::const_iterator it;
+DictionaryModel::SharedPtr Deserializer::deserialize(
+    const nlohmann::json& input, Type2Type<DictionaryModel::SharedPtr> type) {
+  std::istringstream is(input.dump());
+  return deserialize(is, type);
+}
 
-  it = chatbot.find("replies");
-  if (it != chatbot.end() && (*it).is_object()) {
-    deserializeReplies(*it, chatbotActionModel);
-  }
+IntentServiceModel Deserializer::deserialize(std::istream& is,
+                                             Type2Type<IntentServiceModel>) {
+  return readModel(is, ModelBuilder::DICTIONARY | ModelBuilder::INTENTS)
+      .intentStoryServiceModel.intentServiceModel;
+}
 
-  it = chatbot.find("replies_by_state_action");
-  if (it != chatbot.end() && (*it).is_object()) {
-    deserializeReplyIdsByStateAndActionId(*it, chatbotActionModel);
-  }
+IntentServiceModel Deserializer::deserialize(
+    const nlohmann::json& input, Type2Type<IntentServiceModel> type) {
+  std::istringstream is(input.dump());
+  return deserialize(is, type);
 }
 
-void deserializeChatbotActionModel(const nlohmann::json& input,
-                                   ChatbotActionModel& chatbotActionModel) {
-  nlohmann::json::const_iterator it;
+IntentStoryServiceModel Deserializer::deserialize(
+    std::istream& is, Type2Type<IntentStoryServiceModel>) {
+  return readModel(is, ModelBuilder::DICTIONARY | ModelBuilder::INTENTS |
+                           ModelBuilder::INTENT_STORY)
+      .intentStoryServiceModel;
+}
 
-  it = input.find("chatbot");
-  if (it != input.end() && (*it).is_object()) {
-    deserializeChatbotActions(*it, chatbotActionModel);
-  }
+IntentStoryServiceModel Deserializer::deserialize(
+    const nlohmann::json& input, Type2Type<IntentStoryServiceModel> type) {
+  std::istringstream is(input.dump());
+  return deserialize(is, type);
 }
 
 ChatbotModel Deserializer::deserialize(std::istream& is,
-                                       Type2Type<ChatbotModel> type) {
-  std::istreambuf_iterator<char> eos;
-  std::string s(std::istreambuf_iterator<char>(is), eos);
-
-  nlohmann::json document;
-  try {
-    document = nlohmann::json::parse(s);
-  } catch (...) {
-    throw DeserializerException("Error while parsing JSON");
-  }
-
-  return deserialize(document, type);
+                                       Type2Type<ChatbotModel>) {
+  return readModel(is, ModelBuilder::DICTIONARY | ModelBuilder::INTENTS |
+                           ModelBuilder::INTENT_STORY | ModelBuilder::CHATBOT);
 }
 
 ChatbotModel Deserializer::deserialize(const nlohmann::json& input,
                                        Type2Type<ChatbotModel> type) {
-  ChatbotModel chatbotModel;
-  chatbotModel.chatbotActionModel =
-      ChatbotActionModel::SharedPtr(new ChatbotActionModel());
-  chatbotModel.intentStoryServiceModel.intentStoryModel =
-      IntentStoryModel::SharedPtr(new IntentStoryModel());
-  chatbotModel.intentStoryServiceModel.intentServiceModel.intentModel =
-      IntentModel::SharedPtr(new IntentModel());
-  chatbotModel.intentStoryServiceModel.intentServiceModel.dictionaryModel =
-      DictionaryModel::SharedPtr(new DictionaryModel());
-
-  try {
-    deserializeDictionaryModel(input, *chatbotModel.intentStoryServiceModel
-                                           .intentServiceModel.dictionaryModel);
-    deserializeIntentModel(
-        input, *chatbotModel.intentStoryServiceModel.intentServiceModel
-                    .dictionaryModel,
-        *chatbotModel.intentStoryServiceModel.intentServiceModel.intentModel);
-    deserializeIntentStoryModel(
-        input, *chatbotModel.intentStoryServiceModel.intentStoryModel);
-    deserializeChatbotActionModel(input, *chatbotModel.chatbotActionModel);
-  } catch (...) {
-    throw DeserializerException("Error while parsing JSON");
-  }
-
-  return chatbotModel;
+  std::istringstream is(input.dump());
+  return deserialize(is, type);
 }
 }
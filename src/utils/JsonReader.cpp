@@ -0,0 +1,321 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "intent/utils/JsonReader.hpp"
+
+namespace intent {
+
+namespace {
+const size_t BUFFER_SIZE = 64 * 1024;
+
+bool isWhitespace(int c) {
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+bool isDigit(int c) { return c >= '0' && c <= '9'; }
+}
+
+JsonReader::JsonReader(std::istream& is)
+    : m_is(is), m_buffer(BUFFER_SIZE), m_position(0), m_size(0), m_offset(0) {}
+
+bool JsonReader::refill() {
+  m_offset += m_size;
+  m_position = 0;
+  m_is.read(m_buffer.data(), m_buffer.size());
+  m_size = static_cast<size_t>(m_is.gcount());
+  return m_size > 0;
+}
+
+int JsonReader::peek() {
+  if (m_position == m_size && !refill()) return END_OF_STREAM;
+  return static_cast<unsigned char>(m_buffer[m_position]);
+}
+
+int JsonReader::get() {
+  int c = peek();
+  if (c != END_OF_STREAM) ++m_position;
+  return c;
+}
+
+int JsonReader::peekNonWhitespace() {
+  int c = peek();
+  while (isWhitespace(c)) {
+    ++m_position;
+    c = peek();
+  }
+  return c;
+}
+
+void JsonReader::fail(const std::string& error) const {
+  throw JsonReaderException(error + " at offset " +
+                            std::to_string(m_offset + m_position));
+}
+
+void JsonReader::expect(char expected) {
+  if (peekNonWhitespace() != expected)
+    fail(std::string("Expected '") + expected + "'");
+  ++m_position;
+}
+
+void JsonReader::expectLiteral(const char* literal) {
+  for (const char* c = literal; *c; ++c) {
+    if (get() != *c) fail(std::string("Expected ") + literal);
+  }
+}
+
+JsonReader::ValueType::type JsonReader::peekValueType() {
+  int c = peekNonWhitespace();
+  switch (c) {
+    case '{':
+      return ValueType::OBJECT;
+    case '[':
+      return ValueType::ARRAY;
+    case '"':
+      return ValueType::STRING;
+    case 't':
+    case 'f':
+      return ValueType::BOOLEAN;
+    case 'n':
+      return ValueType::NULL_VALUE;
+    default:
+      if (c == '-' || isDigit(c)) return ValueType::NUMBER;
+  }
+  fail("Expected a value");
+  return ValueType::NULL_VALUE;
+}
+
+void JsonReader::beginObject() {
+  expect('{');
+  m_firstItems.push_back(true);
+}
+
+bool JsonReader::nextKey(std::string& key) {
+  if (m_firstItems.empty()) fail("No object to read");
+
+  int c = peekNonWhitespace();
+  if (c == '}') {
+    ++m_position;
+    m_firstItems.pop_back();
+    return false;
+  }
+  if (!m_firstItems.back()) expect(',');
+  m_firstItems.back() = false;
+
+  if (peekNonWhitespace() != '"') fail("Expected a key");
+  readString(key);
+  expect(':');
+  return true;
+}
+
+void JsonReader::beginArray() {
+  expect('[');
+  m_firstItems.push_back(true);
+}
+
+bool JsonReader::nextElement() {
+  if (m_firstItems.empty()) fail("No array to read");
+
+  int c = peekNonWhitespace();
+  if (c == ']') {
+    ++m_position;
+    m_firstItems.pop_back();
+    return false;
+  }
+  if (!m_firstItems.back()) expect(',');
+  m_firstItems.back() = false;
+  return true;
+}
+
+unsigned int JsonReader::readHexQuad() {
+  unsigned int value = 0;
+  for (int i = 0; i < 4; ++i) {
+    int c = get();
+    value <<= 4;
+    if (c >= '0' && c <= '9') {
+      value |= c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+      value |= c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+      value |= c - 'A' + 10;
+    } else {
+      fail("Invalid unicode escape");
+    }
+  }
+  return value;
+}
+
+void JsonReader::appendCodePoint(unsigned int codePoint, std::string& value) {
+  if (codePoint < 0x80) {
+    value += static_cast<char>(codePoint);
+  } else if (codePoint < 0x800) {
+    value += static_cast<char>(0xC0 | (codePoint >> 6));
+    value += static_cast<char>(0x80 | (codePoint & 0x3F));
+  } else if (codePoint < 0x10000) {
+    value += static_cast<char>(0xE0 | (codePoint >> 12));
+    value += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+    value += static_cast<char>(0x80 | (codePoint & 0x3F));
+  } else {
+    value += static_cast<char>(0xF0 | (codePoint >> 18));
+    value += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+    value += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+    value += static_cast<char>(0x80 | (codePoint & 0x3F));
+  }
+}
+
+void JsonReader::readString(std::string& value) {
+  expect('"');
+  value.clear();
+  for (;;) {
+    // Copy the unescaped characters of the buffer in one go.
+    size_t start = m_position;
+    while (m_position < m_size) {
+      char c = m_buffer[m_position];
+      if (c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20) break;
+      ++m_position;
+    }
+    value.append(m_buffer.data() + start, m_position - start);
+
+    int c = get();
+    if (c == END_OF_STREAM) fail("Unterminated string");
+    if (c == '"') return;
+    if (c != '\\') {
+      if (c < 0x20) fail("Control character in string");
+      value += static_cast<char>(c);
+      continue;
+    }
+
+    c = get();
+    switch (c) {
+      case '"':
+      case '\\':
+      case '/':
+        value += static_cast<char>(c);
+        break;
+      case 'b':
+        value += '\b';
+        break;
+      case 'f':
+        value += '\f';
+        break;
+      case 'n':
+        value += '\n';
+        break;
+      case 'r':
+        value += '\r';
+        break;
+      case 't':
+        value += '\t';
+        break;
+      case 'u': {
+        unsigned int codePoint = readHexQuad();
+        if (codePoint >= 0xD800 && codePoint <= 0xDBFF) {
+          expectLiteral("\\u");
+          unsigned int low = readHexQuad();
+          if (low < 0xDC00 || low > 0xDFFF) fail("Invalid surrogate pair");
+          codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+        } else if (codePoint >= 0xDC00 && codePoint <= 0xDFFF) {
+          fail("Invalid surrogate pair");
+        }
+        appendCodePoint(codePoint, value);
+        break;
+      }
+      default:
+        fail("Invalid escape sequence");
+    }
+  }
+}
+
+void JsonReader::readDigits() {
+  if (!isDigit(peek())) fail("Invalid number");
+  while (isDigit(peek())) ++m_position;
+}
+
+void JsonReader::readNumber() {
+  if (peekNonWhitespace() == '-') ++m_position;
+  if (peek() == '0') {
+    ++m_position;
+  } else {
+    readDigits();
+  }
+
+  if (peek() == '.') {
+    ++m_position;
+    readDigits();
+  }
+
+  int c = peek();
+  if (c == 'e' || c == 'E') {
+    ++m_position;
+    c = peek();
+    if (c == '+' || c == '-') ++m_position;
+    readDigits();
+  }
+}
+
+void JsonReader::skipValue() {
+  std::string scratch;
+  switch (peekValueType()) {
+    case ValueType::OBJECT:
+      beginObject();
+      while (nextKey(scratch)) skipValue();
+      break;
+    case ValueType::ARRAY:
+      beginArray();
+      while (nextElement()) skipValue();
+      break;
+    case ValueType::STRING:
+      readString(scratch);
+      break;
+    case ValueType::NUMBER:
+      readNumber();
+      break;
+    case ValueType::BOOLEAN:
+      expectLiteral(peek() == 't' ? "true" : "false");
+      break;
+    case ValueType::NULL_VALUE:
+      expectLiteral("null");
+      break;
+  }
+}
+
+void JsonReader::end() {
+  if (peekNonWhitespace() != END_OF_STREAM) fail("Unexpected content");
+}
+}
@@ -40,8 +40,102 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 #include "intent/utils/Levenshtein.hpp"
 #include <algorithm>
+#include <cstdint>
+#include <vector>
 
 namespace intent {
+namespace {
+
+const std::size_t MAX_BIT_PARALLEL_LENGTH = 64;
+const unsigned int MAX_BANDED_DISTANCE = 31;
+
+/**
+ * \brief Bit-parallel distance, the pattern must not exceed 64 characters.
+ */
+unsigned int bitParallelDistance(const std::string& pattern,
+                                 const std::string& text,
+                                 unsigned int maxDistance) {
+  const std::size_t m = pattern.size();
+  const std::size_t n = text.size();
+  if (m == 0) return std::min<std::size_t>(n, maxDistance + 1);
+
+  // Only the entries of the characters of both strings are initialized.
+  uint64_t peq[256];
+  for (unsigned char c : text) peq[c] = 0;
+  for (unsigned char c : pattern) peq[c] = 0;
+  for (std::size_t i = 0; i < m; ++i)
+    peq[static_cast<unsigned char>(pattern[i])] |= uint64_t(1) << i;
+
+  const uint64_t last = uint64_t(1) << (m - 1);
+  uint64_t pv = m == 64 ? ~uint64_t(0) : (uint64_t(1) << m) - 1;
+  uint64_t mv = 0;
+  std::size_t score = m;
+
+  for (std::size_t j = 0; j < n; ++j) {
+    const uint64_t eq = peq[static_cast<unsigned char>(text[j])];
+    const uint64_t xv = eq | mv;
+    const uint64_t xh = (((eq & pv) + pv) ^ pv) | eq;
+    uint64_t ph = mv | ~(xh | pv);
+    uint64_t mh = pv & xh;
+
+    if (ph & last)
+      ++score;
+    else if (mh & last)
+      --score;
+
+    // Each remaining character of the text lowers the score by one at most.
+    if (score > maxDistance + (n - j - 1)) return maxDistance + 1;
+
+    ph = (ph << 1) | 1;
+    mh <<= 1;
+    pv = mh | ~(xv | ph);
+    mv = ph & xv;
+  }
+  return std::min<std::size_t>(score, maxDistance + 1);
+}
+
+/**
+ * \brief Dynamic programming restricted to the cells at most maxDistance away
+ * from the diagonal. Cell j of the row i is stored at j - i + maxDistance.
+ */
+unsigned int bandedDistance(const std::string& s1, const std::string& s2,
+                            unsigned int maxDistance) {
+  const unsigned int k = maxDistance;
+  const unsigned int infinity = k + 1;
+  const long n = s1.size(), m = s2.size();
+  const int band = 2 * k + 1;
+
+  unsigned int rows[2][2 * MAX_BANDED_DISTANCE + 1];
+  unsigned int* previous = rows[0];
+  unsigned int* current = rows[1];
+
+  for (int d = 0; d < band; ++d) {
+    long j = d - static_cast<long>(k);
+    previous[d] = (j < 0 || j > m) ? infinity : static_cast<unsigned int>(j);
+  }
+
+  for (long i = 1; i <= n; ++i) {
+    unsigned int rowMin = infinity;
+    for (int d = 0; d < band; ++d) {
+      long j = i + d - static_cast<long>(k);
+      unsigned int value = infinity;
+      if (j == 0) {
+        value = std::min<unsigned int>(i, infinity);
+      } else if (j > 0 && j <= m) {
+        value = previous[d] + (s1[i - 1] == s2[j - 1] ? 0 : 1);
+        if (d + 1 < band) value = std::min(value, previous[d + 1] + 1);
+        if (d > 0) value = std::min(value, current[d - 1] + 1);
+        value = std::min(value, infinity);
+      }
+      current[d] = value;
+      rowMin = std::min(rowMin, value);
+    }
+    if (rowMin > k) return infinity;
+    std::swap(previous, current);
+  }
+  return previous[m - n + k];
+}
+}  // anonymous
 
 unsigned int Levenshtein::distance(const std::string& s1,
                                    const std::string& s2) {
@@ -59,4 +153,20 @@ unsigned int Levenshtein::distance(const std::string& s1,
                           d[i - 1][j - 1] + (s1[i - 1] == s2[j - 1] ? 0 : 1)});
   return d[len1][len2];
 }
+
+unsigned int Levenshtein::distance(const std::string& s1,
+                                   const std::string& s2,
+                                   unsigned int maxDistance) {
+  const std::size_t len1 = s1.size(), len2 = s2.size();
+  if ((len1 > len2 ? len1 - len2 : len2 - len1) > maxDistance)
+    return maxDistance + 1;
+
+  if (len1 <= MAX_BIT_PARALLEL_LENGTH)
+    return bitParallelDistance(s1, s2, maxDistance);
+  if (len2 <= MAX_BIT_PARALLEL_LENGTH)
+    return bitParallelDistance(s2, s1, maxDistance);
+  if (maxDistance <= MAX_BANDED_DISTANCE)
+    return bandedDistance(s1, s2, maxDistance);
+  return std::min(distance(s1, s2), maxDistance + 1);
+}
 }
@@ -40,6 +40,9 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 */
 #include "intent/utils/Logger.hpp"
 
+#include <cstdlib>
+#include <utility>
+
 namespace intent {
 namespace log {
 
@@ -72,7 +75,60 @@ Logger::SeverityLevel::type Logger::severityLevelFromString(
   return Logger::SeverityLevel::FATAL;
 }
 
+Logger::Logger()
+    : m_severityLevel(SeverityLevel::FATAL), m_asyncSink(nullptr) {
+  m_console = spdlog::get("console");
+  if (!m_console) m_console = spdlog::stdout_logger_mt("console", false);
+
+  SeverityLevel::type initialLevel = SeverityLevel::FATAL;
+  if (const char* env_p = std::getenv("LOG_LEVEL")) {
+    initialLevel = Logger::severityLevelFromString(env_p);
+  }
+  setSeverityLevel(initialLevel);
+}
+
+Logger::~Logger() { delete m_asyncSink.exchange(nullptr); }
+
+Logger& Logger::getInstance() {
+  // The initialization of a local static is thread safe.
+  static Logger logger;
+  return logger;
+}
+
 void Logger::initialize(SeverityLevel::type severityLevel) {
+  getInstance().setSeverityLevel(severityLevel);
+}
+
+void Logger::initializeAsync(
+    SeverityLevel::type severityLevel, size_t capacity,
+    AsyncLogSink::OverflowPolicy::type overflowPolicy) {
+  Logger& logger = getInstance();
+  {
+    std::lock_guard<std::mutex> lock(logger.m_asyncSinkMutex);
+    if (!logger.m_asyncSink.load(std::memory_order_relaxed)) {
+      AsyncLogSink* sink = new AsyncLogSink(
+          capacity, overflowPolicy,
+          [&logger](int level, const std::string& message) {
+            logger.write(static_cast<SeverityLevel::type>(level), message);
+          });
+      logger.m_asyncSink.store(sink, std::memory_order_release);
+    }
+  }
+  logger.setSeverityLevel(severityLevel);
+}
+
+void Logger::flush() {
+  AsyncLogSink* sink =
+      getInstance().m_asyncSink.load(std::memory_order_acquire);
+  if (sink) sink->flush();
+}
+
+size_t Logger::droppedMessages() const {
+  AsyncLogSink* sink = m_asyncSink.load(std::memory_order_acquire);
+  return sink ? sink->droppedMessages() : 0;
+}
+
+void Logger::setSeverityLevel(SeverityLevel::type severityLevel) {
   spdlog::level::level_enum spdlogSeverity = spdlog::level::err;
   switch (severityLevel) {
     case SeverityLevel::TRACE:
@@ -94,10 +150,42 @@ void Logger::initialize(SeverityLevel::type severityLevel) {
       spdlogSeverity = spdlog::level::critical;
       break;
   }
-  Logger::getInstance();
 
-  spdlog::stdout_logger_mt("console", false);
+  m_severityLevel.store(severityLevel, std::memory_order_relaxed);
   spdlog::set_level(spdlogSeverity);
 }
+
+void Logger::log(SeverityLevel::type severityLevel, std::string message) {
+  AsyncLogSink* sink = m_asyncSink.load(std::memory_order_acquire);
+  if (sink) {
+    sink->push(severityLevel, std::move(message));
+    return;
+  }
+  write(severityLevel, message);
+}
+
+void Logger::write(SeverityLevel::type severityLevel,
+                   const std::string& message) {
+  switch (severityLevel) {
+    case SeverityLevel::TRACE:
+      m_console->trace(message);
+      break;
+    case SeverityLevel::DEBUG:
+      m_console->debug(message);
+      break;
+    case SeverityLevel::INFO:
+      m_console->info(message);
+      break;
+    case SeverityLevel::WARNING:
+      m_console->warn(message);
+      break;
+    case SeverityLevel::ERROR:
+      m_console->error(message);
+      break;
+    case SeverityLevel::FATAL:
+      m_console->critical(message);
+      break;
+  }
+}
 }
 }
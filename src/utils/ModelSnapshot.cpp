@@ -0,0 +1,499 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "intent/utils/ModelSnapshot.hpp"
+#include "intent/utils/BinaryStream.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <regex>
+#include <sstream>
+#include <thread>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/shared_memory_object.hpp>
+
+namespace intent {
+const uint32_t ModelSnapshot::VERSION = 2;
+
+namespace {
+const char MAGIC[8] = {'O', 'I', 'N', 'T', 'S', 'N', 'A', 'P'};
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t byteOrderMark;
+  uint64_t payloadSize;
+  uint64_t checksum;
+};
+
+static_assert(sizeof(MAGIC) == sizeof(std::atomic<uint64_t>) &&
+                  ATOMIC_LLONG_LOCK_FREE == 2,
+              "The magic number must be published with a single store");
+
+// How long an attach waits for a segment being written to be published, and
+// for a segment being replaced to be created again.
+const std::chrono::milliseconds PUBLICATION_TIMEOUT(1000);
+const std::chrono::milliseconds REPLACEMENT_TIMEOUT(10);
+const std::chrono::milliseconds ATTACH_RETRY_DELAY(1);
+const boost::interprocess::offset_t HEADER_SIZE = sizeof(Header);
+
+uint64_t magicWord() {
+  uint64_t word;
+  std::memcpy(&word, MAGIC, sizeof(MAGIC));
+  return word;
+}
+
+/**
+ * \brief The magic number at the start of a shared memory segment. It is
+ * written last, once the rest of the snapshot is visible.
+ */
+std::atomic<uint64_t>& magicOf(void* segment) {
+  return *static_cast<std::atomic<uint64_t>*>(segment);
+}
+
+uint64_t checksum(const char* data, size_t size) {
+  // FNV-1a
+  uint64_t hash = 14695981039346656037ULL;
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+void writeIntent(BinaryWriter& writer, const IntentModel::Intent& intent) {
+  writer.writeString(intent.intentId);
+  writer.writeArray(intent.entities);
+  writer.write<uint64_t>(intent.entityToVariableNames.size());
+  for (const IntentModel::EntityToNames::value_type& entityNames :
+       intent.entityToVariableNames) {
+    writer.writeString(entityNames.first);
+    IntentModel::VariableNames names = entityNames.second;
+    writer.write<uint64_t>(names.size());
+    for (; !names.empty(); names.pop()) writer.writeString(names.front());
+  }
+  writer.writeString(intent.example);
+}
+
+void readIntent(BinaryReader& reader, IntentModel::Intent& intent) {
+  reader.readString(intent.intentId);
+  reader.readArray(intent.entities);
+  size_t entityCount = reader.readSize(16);
+  for (size_t i = 0; i < entityCount; ++i) {
+    std::string entity;
+    reader.readString(entity);
+    IntentModel::VariableNames& names = intent.entityToVariableNames[entity];
+    size_t nameCount = reader.readSize(8);
+    for (size_t j = 0; j < nameCount; ++j) {
+      std::string name;
+      reader.readString(name);
+      names.push(name);
+    }
+  }
+  reader.readString(intent.example);
+}
+
+void writeDictionaryModel(BinaryWriter& writer,
+                          const DictionaryModel& dictionaryModel) {
+  writer.write<uint64_t>(dictionaryModel.entitiesByEntityId.size());
+  for (const DictionaryModel::EntityByEntityIdIndex::value_type& entity :
+       dictionaryModel.entitiesByEntityId) {
+    writer.write<int32_t>(entity.first);
+    writer.writeString(entity.second);
+  }
+
+  // The compiled regexes cannot be stored, they are compiled again.
+  writer.write<uint64_t>(dictionaryModel.regexes.size());
+  for (const DictionaryModel::Regex& regex : dictionaryModel.regexes) {
+    writer.writeString(regex.pattern);
+    writer.write<int32_t>(regex.entityId);
+  }
+
+  dictionaryModel.dictionary.writeTo(writer);
+}
+
+void readDictionaryModel(BinaryReader& reader,
+                         DictionaryModel& dictionaryModel) {
+  size_t entityCount = reader.readSize(12);
+  for (size_t i = 0; i < entityCount; ++i) {
+    int entityId = reader.read<int32_t>();
+    reader.readString(dictionaryModel.entitiesByEntityId[entityId]);
+  }
+
+  size_t regexCount = reader.readSize(12);
+  for (size_t i = 0; i < regexCount; ++i) {
+    std::string pattern;
+    reader.readString(pattern);
+    dictionaryModel.addRegex(pattern, reader.read<int32_t>());
+  }
+
+  dictionaryModel.dictionary.readFrom(reader);
+}
+
+void writeIntentModel(BinaryWriter& writer, const IntentModel& intentModel) {
+  writer.write<uint64_t>(intentModel.intentsByIntentId.size());
+  for (const IntentModel::IntentIndex::value_type& intent :
+       intentModel.intentsByIntentId) {
+    writer.writeString(intent.first);
+    writeIntent(writer, intent.second);
+  }
+}
+
+void readIntentModel(BinaryReader& reader, IntentModel& intentModel) {
+  size_t intentCount = reader.readSize(8);
+  for (size_t i = 0; i < intentCount; ++i) {
+    std::string intentId;
+    reader.readString(intentId);
+    readIntent(reader, intentModel.intentsByIntentId[intentId]);
+  }
+}
+
+void writeIntentStoryModel(BinaryWriter& writer,
+                           const IntentStoryModel& intentStoryModel) {
+  typedef IntentStoryModel::StoryGraph StoryGraph;
+  const StoryGraph& graph = intentStoryModel.graph;
+
+  writer.writeString(intentStoryModel.rootStateId);
+
+  writer.write<uint64_t>(graph.vertexCount());
+  for (size_t i = 0; i < graph.vertexCount(); ++i)
+    writer.writeString(graph.vertexAt(i).getInfo().stateId);
+
+  writer.write<uint64_t>(intentStoryModel.vertexByStateId.size());
+  for (const IntentStoryModel::VertexByStateIdIndex::value_type& vertex :
+       intentStoryModel.vertexByStateId) {
+    writer.writeString(vertex.first);
+    writer.write<uint64_t>(vertex.second.getVertex());
+  }
+
+  // The edges are added back vertex by vertex, in the same order.
+  for (size_t i = 0; i < graph.vertexCount(); ++i) {
+    StoryGraph::Edges edges = graph.nextEdges(graph.vertexAt(i));
+    writer.write<uint64_t>(edges.size());
+    for (const StoryGraph::Edge& edge : edges) {
+      const IntentStoryModel::EdgeInfo& edgeInfo = edge.getInfo();
+      writer.write<uint64_t>(edge.getTarget().getVertex());
+      writeIntent(writer, edgeInfo.intent);
+      writer.writeString(edgeInfo.actionId);
+      writer.writeString(edgeInfo.reply);
+    }
+  }
+}
+
+size_t readVertexIndex(BinaryReader& reader, size_t vertexCount) {
+  uint64_t index = reader.read<uint64_t>();
+  if (index >= vertexCount) throw BinaryStreamException("Invalid vertex");
+  return static_cast<size_t>(index);
+}
+
+void readIntentStoryModel(BinaryReader& reader,
+                          IntentStoryModel& intentStoryModel) {
+  typedef IntentStoryModel::StoryGraph StoryGraph;
+  StoryGraph& graph = intentStoryModel.graph;
+
+  reader.readString(intentStoryModel.rootStateId);
+
+  size_t vertexCount = reader.readSize(8);
+  for (size_t i = 0; i < vertexCount; ++i) {
+    IntentStoryModel::VertexInfo vertexInfo;
+    reader.readString(vertexInfo.stateId);
+    graph.addVertex(vertexInfo);
+  }
+
+  size_t indexedVertexCount = reader.readSize(16);
+  for (size_t i = 0; i < indexedVertexCount; ++i) {
+    std::string stateId;
+    reader.readString(stateId);
+    intentStoryModel.vertexByStateId[stateId] =
+        graph.vertexAt(readVertexIndex(reader, vertexCount));
+  }
+
+  for (size_t i = 0; i < vertexCount; ++i) {
+    StoryGraph::Vertex source = graph.vertexAt(i);
+    size_t edgeCount = reader.readSize(8);
+    for (size_t j = 0; j < edgeCount; ++j) {
+      StoryGraph::Vertex target =
+          graph.vertexAt(readVertexIndex(reader, vertexCount));
+      IntentStoryModel::EdgeInfo edgeInfo;
+      readIntent(reader, edgeInfo.intent);
+      reader.readString(edgeInfo.actionId);
+      reader.readString(edgeInfo.reply);
+      graph.addEdge(source, target, edgeInfo);
+    }
+  }
+  graph.freeze();
+}
+
+void writeChatbotActionModel(BinaryWriter& writer,
+                             const ChatbotActionModel& chatbotActionModel) {
+  writer.write<uint64_t>(chatbotActionModel.replyContentByReplyIdIndex.size());
+  for (const ChatbotActionModel::ReplyContentByReplyIdIndex::value_type&
+           reply : chatbotActionModel.replyContentByReplyIdIndex) {
+    writer.writeString(reply.first);
+    writer.writeString(reply.second);
+  }
+
+  writer.write<uint64_t>(chatbotActionModel.replyIdsByStateAndActionId.size());
+  for (const ChatbotActionModel::ReplyIdsByStateAndActionIdIndex::value_type&
+           replyIds : chatbotActionModel.replyIdsByStateAndActionId) {
+    writer.writeString(replyIds.first.state);
+    writer.writeString(replyIds.first.actionId);
+    writer.write<uint64_t>(replyIds.second.size());
+    for (const std::string& replyId : replyIds.second)
+      writer.writeString(replyId);
+  }
+}
+
+void readChatbotActionModel(BinaryReader& reader,
+                            ChatbotActionModel& chatbotActionModel) {
+  size_t replyCount = reader.readSize(16);
+  for (size_t i = 0; i < replyCount; ++i) {
+    std::string replyId;
+    reader.readString(replyId);
+    reader.readString(chatbotActionModel.replyContentByReplyIdIndex[replyId]);
+  }
+
+  size_t stateAndActionCount = reader.readSize(24);
+  for (size_t i = 0; i < stateAndActionCount; ++i) {
+    ChatbotActionModel::StateAndActionId stateAndActionId;
+    reader.readString(stateAndActionId.state);
+    reader.readString(stateAndActionId.actionId);
+    std::vector<std::string>& replyIds =
+        chatbotActionModel.replyIdsByStateAndActionId[stateAndActionId];
+    replyIds.resize(reader.readSize(8));
+    for (std::string& replyId : replyIds) reader.readString(replyId);
+  }
+}
+
+/**
+ * \brief Check the header of a snapshot and read its payload. The packed
+ * arrays refer to the snapshot if its storage is given.
+ */
+ChatbotModel readSnapshot(const char* data, size_t size,
+                          const std::shared_ptr<const void>& storage,
+                          ModelSnapshot::Verification verification) {
+  Header header;
+  if (size < sizeof(header)) throw ModelSnapshotException("Truncated header");
+  std::memcpy(&header, data, sizeof(header));
+
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+    throw ModelSnapshotException("Not a model snapshot");
+  if (header.version != ModelSnapshot::VERSION)
+    throw ModelSnapshotException("Unsupported snapshot version " +
+                                 std::to_string(header.version));
+  if (header.byteOrderMark != BYTE_ORDER_MARK)
+    throw ModelSnapshotException("Snapshot written with another byte order");
+
+  const char* payload = data + sizeof(header);
+  if (header.payloadSize != size - sizeof(header))
+    throw ModelSnapshotException("Truncated snapshot");
+  if (verification == ModelSnapshot::CHECKSUM &&
+      header.checksum != checksum(payload, header.payloadSize))
+    throw ModelSnapshotException("Corrupted snapshot");
+
+  ChatbotModel chatbotModel;
+  IntentStoryServiceModel& intentStoryServiceModel =
+      chatbotModel.intentStoryServiceModel;
+  IntentServiceModel& intentServiceModel =
+      intentStoryServiceModel.intentServiceModel;
+  chatbotModel.chatbotActionModel.reset(new ChatbotActionModel());
+  intentStoryServiceModel.intentStoryModel.reset(new IntentStoryModel());
+  intentServiceModel.intentModel.reset(new IntentModel());
+  intentServiceModel.dictionaryModel.reset(new DictionaryModel());
+
+  BinaryReader reader(payload, header.payloadSize, storage);
+  try {
+    readDictionaryModel(reader, *intentServiceModel.dictionaryModel);
+    readIntentModel(reader, *intentServiceModel.intentModel);
+    readIntentStoryModel(reader, *intentStoryServiceModel.intentStoryModel);
+    readChatbotActionModel(reader, *chatbotModel.chatbotActionModel);
+  } catch (const BinaryStreamException& e) {
+    throw ModelSnapshotException(e.message());
+  } catch (const std::regex_error& e) {
+    throw ModelSnapshotException(e.what());
+  }
+  if (reader.remaining() != 0)
+    throw ModelSnapshotException("Unexpected data at the end of the snapshot");
+
+  return chatbotModel;
+}
+}
+
+void ModelSnapshot::write(const ChatbotModel& chatbotModel, std::ostream& os) {
+  const IntentStoryServiceModel& intentStoryServiceModel =
+      chatbotModel.intentStoryServiceModel;
+  const IntentServiceModel& intentServiceModel =
+      intentStoryServiceModel.intentServiceModel;
+  if (!chatbotModel.chatbotActionModel ||
+      !intentStoryServiceModel.intentStoryModel ||
+      !intentServiceModel.intentModel || !intentServiceModel.dictionaryModel)
+    throw ModelSnapshotException("Incomplete chatbot model");
+  if (!intentStoryServiceModel.intentStoryModel->graph.isFrozen())
+    throw ModelSnapshotException("The story graph must be frozen");
+
+  std::ostringstream payloadStream;
+  BinaryWriter writer(payloadStream);
+  writeDictionaryModel(writer, *intentServiceModel.dictionaryModel);
+  writeIntentModel(writer, *intentServiceModel.intentModel);
+  writeIntentStoryModel(writer, *intentStoryServiceModel.intentStoryModel);
+  writeChatbotActionModel(writer, *chatbotModel.chatbotActionModel);
+  const std::string payload = payloadStream.str();
+
+  Header header;
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.byteOrderMark = BYTE_ORDER_MARK;
+  header.payloadSize = payload.size();
+  header.checksum = checksum(payload.data(), payload.size());
+
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  os.write(payload.data(), payload.size());
+}
+
+ChatbotModel ModelSnapshot::read(const char* data, size_t size,
+                                 Verification verification) {
+  return readSnapshot(data, size, std::shared_ptr<const void>(),
+                      verification);
+}
+
+ChatbotModel ModelSnapshot::load(const std::string& filename,
+                                 Verification verification) {
+  try {
+    boost::interprocess::file_mapping file(filename.c_str(),
+                                           boost::interprocess::read_only);
+    boost::interprocess::mapped_region region(file,
+                                              boost::interprocess::read_only);
+    return read(static_cast<const char*>(region.get_address()),
+                region.get_size(), verification);
+  } catch (const boost::interprocess::interprocess_exception& e) {
+    throw ModelSnapshotException("Cannot map " + filename + ": " + e.what());
+  }
+}
+
+ChatbotModel ModelSnapshot::attachFile(const std::string& filename,
+                                       Verification verification) {
+  std::shared_ptr<boost::interprocess::mapped_region> region;
+  try {
+    boost::interprocess::file_mapping file(filename.c_str(),
+                                           boost::interprocess::read_only);
+    region = std::make_shared<boost::interprocess::mapped_region>(
+        file, boost::interprocess::read_only);
+  } catch (const boost::interprocess::interprocess_exception& e) {
+    throw ModelSnapshotException("Cannot map " + filename + ": " + e.what());
+  }
+  return readSnapshot(static_cast<const char*>(region->get_address()),
+                      region->get_size(), region, verification);
+}
+
+void ModelSnapshot::createSharedMemory(const ChatbotModel& chatbotModel,
+                                       const std::string& segmentName) {
+  std::ostringstream snapshotStream;
+  write(chatbotModel, snapshotStream);
+  const std::string snapshot = snapshotStream.str();
+
+  try {
+    boost::interprocess::shared_memory_object::remove(segmentName.c_str());
+    boost::interprocess::shared_memory_object segment(
+        boost::interprocess::create_only, segmentName.c_str(),
+        boost::interprocess::read_write);
+    segment.truncate(snapshot.size());
+    boost::interprocess::mapped_region region(segment,
+                                              boost::interprocess::read_write);
+    // The segment is visible under its name while it is filled: the magic
+    // number is written last so that no process attaches a partial model.
+    char* address = static_cast<char*>(region.get_address());
+    std::memcpy(address + sizeof(MAGIC), snapshot.data() + sizeof(MAGIC),
+                snapshot.size() - sizeof(MAGIC));
+    magicOf(address).store(magicWord(), std::memory_order_release);
+  } catch (const boost::interprocess::interprocess_exception& e) {
+    throw ModelSnapshotException("Cannot create the shared memory " +
+                                 segmentName + ": " + e.what());
+  }
+}
+
+ChatbotModel ModelSnapshot::attachSharedMemory(const std::string& segmentName,
+                                               Verification verification) {
+  typedef std::chrono::steady_clock Clock;
+  const Clock::time_point start = Clock::now();
+  for (;;) {
+    const Clock::duration elapsed = Clock::now() - start;
+    std::shared_ptr<boost::interprocess::mapped_region> region;
+    try {
+      boost::interprocess::shared_memory_object segment(
+          boost::interprocess::open_only, segmentName.c_str(),
+          boost::interprocess::read_only);
+      // A segment still empty or without its magic number is being written.
+      boost::interprocess::offset_t size = 0;
+      if (segment.get_size(size) && size >= HEADER_SIZE) {
+        region = std::make_shared<boost::interprocess::mapped_region>(
+            segment, boost::interprocess::read_only);
+      }
+    } catch (const boost::interprocess::interprocess_exception& e) {
+      // The segment does not exist for an instant while it is replaced.
+      if (elapsed < REPLACEMENT_TIMEOUT) {
+        std::this_thread::sleep_for(ATTACH_RETRY_DELAY);
+        continue;
+      }
+      throw ModelSnapshotException("Cannot map the shared memory " +
+                                   segmentName + ": " + e.what());
+    }
+
+    const bool published =
+        region && magicOf(region->get_address())
+                          .load(std::memory_order_acquire) == magicWord();
+    if (published || elapsed >= PUBLICATION_TIMEOUT) {
+      if (!region) throw ModelSnapshotException("Truncated header");
+      return readSnapshot(static_cast<const char*>(region->get_address()),
+                          region->get_size(), region, verification);
+    }
+    std::this_thread::sleep_for(ATTACH_RETRY_DELAY);
+  }
+}
+
+bool ModelSnapshot::removeSharedMemory(const std::string& segmentName) {
+  return boost::interprocess::shared_memory_object::remove(
+      segmentName.c_str());
+}
+}
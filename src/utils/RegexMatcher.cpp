@@ -67,9 +67,16 @@ std::string RegexMatcher::padAroundRegexMarkersInSentence(
   return result;
 }
 
+RegexMatcher::CompiledRegex RegexMatcher::compile(const std::string& expr) {
+  return std::make_shared<const std::regex>(expr);
+}
+
 bool RegexMatcher::match(const std::string& input, const std::string& expr) {
-  std::regex expression(expr);
-  return std::regex_match(input, expression);
+  return match(input, std::regex(expr));
+}
+
+bool RegexMatcher::match(boost::string_ref input, const std::regex& regex) {
+  return std::regex_match(input.begin(), input.end(), regex);
 }
 
 bool RegexMatcher::isRegexMarker(const std::string& input) {
@@ -0,0 +1,96 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "intent/utils/ScoreKernels.hpp"
+
+#include <algorithm>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace intent {
+
+int32_t ScoreKernels::max(const int32_t* scores, size_t size) {
+  size_t i = 0;
+  int32_t maxScore = 0;
+
+#if defined(__SSE2__)
+  __m128i maxScores = _mm_setzero_si128();
+  for (; i + 4 <= size; i += 4) {
+    __m128i s =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(scores + i));
+    // SSE2 has no 32 bits max, select the greatest lanes with a mask.
+    __m128i greater = _mm_cmpgt_epi32(s, maxScores);
+    maxScores = _mm_or_si128(_mm_and_si128(greater, s),
+                             _mm_andnot_si128(greater, maxScores));
+  }
+
+  int32_t lanes[4];
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), maxScores);
+  maxScore = *std::max_element(lanes, lanes + 4);
+#endif
+
+  for (; i < size; ++i) maxScore = std::max(maxScore, scores[i]);
+  return maxScore;
+}
+
+void ScoreKernels::findEqual(const int32_t* scores, size_t size, int32_t value,
+                             std::vector<uint32_t>& positions) {
+  size_t i = 0;
+
+#if defined(__SSE2__)
+  __m128i values = _mm_set1_epi32(value);
+  for (; i + 4 <= size; i += 4) {
+    __m128i s =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(scores + i));
+    int mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(s, values)));
+    for (; mask != 0; mask &= mask - 1) {
+      int lane = 0;
+      while (!(mask & (1 << lane))) ++lane;
+      positions.push_back(i + lane);
+    }
+  }
+#endif
+
+  for (; i < size; ++i)
+    if (scores[i] == value) positions.push_back(i);
+}
+}
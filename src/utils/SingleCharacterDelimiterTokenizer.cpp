@@ -44,16 +44,58 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include <boost/algorithm/string.hpp>
 
 namespace intent {
+namespace {
+enum CharacterClass { REGULAR = 0, DELIMITER, REGEX_MARKER };
+
+struct CharacterClasses {
+  CharacterClasses(const std::string& delimiters) {
+    std::fill(classes, classes + 256, REGULAR);
+    for (const char c : RegexMatcher::REGEX_MARKERS)
+      classes[static_cast<unsigned char>(c)] = REGEX_MARKER;
+    for (const char c : delimiters)
+      classes[static_cast<unsigned char>(c)] = DELIMITER;
+  }
+
+  CharacterClass operator()(char c) const {
+    return classes[static_cast<unsigned char>(c)];
+  }
+
+  CharacterClass classes[256];
+};
+}
+
 void SingleCharacterDelimiterTokenizer::tokenize(const std::string& input,
                                                  const std::string& delimiters,
                                                  Tokens& tokens) {
-  std::string sentence = RegexMatcher::padAroundRegexMarkersInSentence(input);
+  TokenViews views;
+  tokenize(boost::string_ref(input), delimiters, views);
 
-  boost::split(tokens, sentence, boost::is_any_of(delimiters));
+  tokens.clear();
+  tokens.reserve(views.size());
+  for (const TokenView& view : views)
+    tokens.push_back(Token(view.data(), view.size()));
+}
 
-  // Remove empty characters
-  Tokens::iterator itEnd = std::remove(tokens.begin(), tokens.end(), "");
-  tokens.erase(itEnd, tokens.end());
+void SingleCharacterDelimiterTokenizer::tokenize(boost::string_ref message,
+                                                 const std::string& delimiters,
+                                                 TokenViews& tokens) {
+  const CharacterClasses characterClasses(delimiters);
+  const char* data = message.data();
+  size_t tokenStart = 0;
+
+  for (size_t i = 0; i < message.size(); ++i) {
+    CharacterClass characterClass = characterClasses(data[i]);
+    if (characterClass == REGULAR) continue;
+
+    if (i > tokenStart)
+      tokens.push_back(TokenView(data + tokenStart, i - tokenStart));
+    if (characterClass == REGEX_MARKER)
+      tokens.push_back(TokenView(data + i, 1));
+    tokenStart = i + 1;
+  }
+
+  if (message.size() > tokenStart)
+    tokens.push_back(TokenView(data + tokenStart, message.size() - tokenStart));
 }
 
 namespace {
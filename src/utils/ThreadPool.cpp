@@ -0,0 +1,180 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include "intent/utils/ThreadPool.hpp"
+
+#include <algorithm>
+#include <exception>
+
+namespace intent {
+ThreadPool::ThreadPool(size_t threadCount)
+    : m_queuedTasks(0), m_stopping(false) {
+  if (threadCount == 0)
+    threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+  for (size_t i = 0; i < threadCount; ++i)
+    m_workers.push_back(std::unique_ptr<Worker>(new Worker()));
+  for (size_t i = 0; i < threadCount; ++i)
+    m_threads.push_back(std::thread(&ThreadPool::run, this, i));
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(m_wakeMutex);
+    m_stopping = true;
+  }
+  m_wake.notify_all();
+  for (std::thread& thread : m_threads) thread.join();
+}
+
+void ThreadPool::push(size_t workerIndex, Task task) {
+  // The counter is raised first so that it never goes below the number of
+  // tasks that can be taken.
+  m_queuedTasks.fetch_add(1);
+  {
+    Worker& worker = *m_workers[workerIndex];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.tasks.push_back(std::move(task));
+  }
+  // A worker checking the counter before going to sleep does it under the
+  // wake mutex, taking it here ensures the notification is not lost.
+  { std::lock_guard<std::mutex> lock(m_wakeMutex); }
+  m_wake.notify_one();
+}
+
+bool ThreadPool::pop(size_t workerIndex, Task& task) {
+  Worker& worker = *m_workers[workerIndex];
+  std::lock_guard<std::mutex> lock(worker.mutex);
+  if (worker.tasks.empty()) return false;
+
+  task = std::move(worker.tasks.back());
+  worker.tasks.pop_back();
+  m_queuedTasks.fetch_sub(1);
+  return true;
+}
+
+bool ThreadPool::steal(size_t thiefIndex, Task& task) {
+  for (size_t i = 1; i <= m_workers.size(); ++i) {
+    Worker& victim = *m_workers[(thiefIndex + i) % m_workers.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (victim.tasks.empty()) continue;
+
+    task = std::move(victim.tasks.front());
+    victim.tasks.pop_front();
+    m_queuedTasks.fetch_sub(1);
+    return true;
+  }
+  return false;
+}
+
+void ThreadPool::run(size_t workerIndex) {
+  for (;;) {
+    Task task;
+    if (pop(workerIndex, task) || steal(workerIndex, task)) {
+      task();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+    m_wake.wait(lock,
+                [this]() { return m_stopping || m_queuedTasks.load() > 0; });
+    if (m_stopping && m_queuedTasks.load() == 0) return;
+  }
+}
+
+namespace {
+/**
+ * \brief The completion state shared by the ranges of a parallelFor.
+ */
+struct Completion {
+  explicit Completion(size_t remaining) : remaining(remaining) {}
+
+  void done(std::exception_ptr exception) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (exception && !firstException) firstException = exception;
+    if (--remaining == 0) finished.notify_all();
+  }
+
+  size_t remaining;
+  std::exception_ptr firstException;
+  std::mutex mutex;
+  std::condition_variable finished;
+};
+}  // anonymous
+
+void ThreadPool::parallelFor(size_t count, size_t grainSize,
+                             const RangeBody& body) {
+  if (count == 0) return;
+  grainSize = std::max<size_t>(grainSize, 1);
+
+  size_t rangeCount = (count + grainSize - 1) / grainSize;
+  std::shared_ptr<Completion> completion =
+      std::make_shared<Completion>(rangeCount);
+
+  // Contiguous ranges go to the same worker, the others steal what is left.
+  for (size_t range = 0; range < rangeCount; ++range) {
+    size_t begin = range * grainSize;
+    size_t end = std::min(begin + grainSize, count);
+    push(range * m_workers.size() / rangeCount,
+         [completion, &body, begin, end]() {
+           std::exception_ptr exception;
+           try {
+             body(begin, end);
+           } catch (...) {
+             exception = std::current_exception();
+           }
+           completion->done(exception);
+         });
+  }
+
+  // The calling thread helps instead of blocking.
+  Task task;
+  while (steal(0, task)) {
+    task();
+    task = Task();
+  }
+
+  std::unique_lock<std::mutex> lock(completion->mutex);
+  completion->finished.wait(
+      lock, [&completion]() { return completion->remaining == 0; });
+  if (completion->firstException)
+    std::rethrow_exception(completion->firstException);
+}
+}
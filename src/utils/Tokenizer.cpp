@@ -44,125 +44,88 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "intent/utils/Logger.hpp"
 
 #include <regex>
+#include <sstream>
 
 namespace intent {
 
 Tokenizer::Tokenizer(const std::string& delimiters,
                      const std::vector<std::string>& regexpList)
-    : m_delimiters(delimiters), m_regexpList(regexpList) {}
-
-struct Split {
-  std::string part;
-  bool tokenizable;
-};
-typedef std::vector<Split> Splits;
-bool operator==(const Split& s1, const Split& s2) {
-  return s1.part == s2.part && s1.tokenizable == s2.tokenizable;
+    : m_delimiters(delimiters) {
+  for (const std::string& regexp : regexpList)
+    m_regexes.push_back(RegexMatcher::compile(regexp));
 }
 
-void splitMatch(const std::smatch& match, Splits& nextSplits) {
-  Split s1, s2, s3;
-
-  if (match.prefix().length() > 0) {
-    s1.part = match.prefix();
-    s1.tokenizable = true;
-    nextSplits.push_back(s1);
-  }
-
-  s2.part = match[0];
-  s2.tokenizable = false;
-  nextSplits.push_back(s2);
-
-  if (match.suffix().length() > 0) {
-    s3.part = match.suffix();
-    s3.tokenizable = true;
-    nextSplits.push_back(s3);
+Tokenizer::Tokenizer(const std::string& delimiters, const Regexes& regexes)
+    : m_delimiters(delimiters), m_regexes(regexes) {}
+
+namespace {
+bool searchRegexes(Tokenizer::TokenView part,
+                   const Tokenizer::Regexes& regexes, std::cmatch& match) {
+  for (const RegexMatcher::CompiledRegex& regex : regexes) {
+    // An empty match would not split anything, the next regex is tried.
+    if (std::regex_search(part.begin(), part.end(), match, *regex) &&
+        match.length(0) > 0)
+      return true;
   }
+  return false;
 }
 
-Splits splitRegexp(const std::string& message,
-                   const std::vector<std::string>& regexpList) {
-  Splits splits, nextSplits;
-  Split split;
-  split.part = message;
-  split.tokenizable = true;
-  nextSplits.push_back(split);
-
-  while (splits != nextSplits) {
-    bool splitted = false;
-    splits = nextSplits;
-    nextSplits.clear();
-
-    Splits::const_iterator it = splits.begin();
-    Splits::const_iterator itEnd = splits.end();
-    for (; it != itEnd; ++it) {
-      bool found_matching = false;
-      const Split& split = *it;
-
-      if (split.tokenizable && !regexpList.empty()) {
-        for (const std::string& regexStr : regexpList) {
-          std::regex expression(regexStr);
-          std::smatch match;
-          splitted = std::regex_search(split.part, match, expression);
-          found_matching |= splitted;
-
-          if (splitted) {
-            splitMatch(match, nextSplits);
-            break;
-          }
-        }
-        if (!found_matching) {
-          nextSplits.push_back(split);
-        }
-      } else {
-        nextSplits.push_back(split);
-      }
+void tokenizePart(Tokenizer::TokenView part, const std::string& delimiters,
+                  const Tokenizer::Regexes& regexes,
+                  Tokenizer::TokenViews& tokens) {
+  std::cmatch match;
+  while (!part.empty()) {
+    if (!searchRegexes(part, regexes, match)) {
+      SingleCharacterDelimiterTokenizer::tokenize(part, delimiters, tokens);
+      return;
     }
-  }
-
-  return splits;
-}
 
-void tokenizeSplitsWithSingleCharacterDelimiter(const Splits& splits,
-                                                const std::string& delimiters,
-                                                Tokenizer::Tokens& tokens) {
-  Splits::const_iterator it = splits.begin();
-  Splits::const_iterator itEnd = splits.end();
-  for (; it != itEnd; ++it) {
-    const Split& split = *it;
-
-    if (split.tokenizable) {
-      std::vector<std::string> partTokens;
-      SingleCharacterDelimiterTokenizer::tokenize(split.part, delimiters,
-                                                  partTokens);
-      tokens.insert(tokens.end(), partTokens.begin(), partTokens.end());
-    } else {
-      tokens.push_back(split.part);
-    }
+    // The prefix may still contain matches of the other regexes while the
+    // suffix may contain further matches of any of them.
+    size_t position = match.position(0);
+    size_t length = match.length(0);
+    tokenizePart(part.substr(0, position), delimiters, regexes, tokens);
+    tokens.push_back(part.substr(position, length));
+    part = part.substr(position + length);
   }
 }
 
-template <typename T>
-std::string join(const std::vector<T>& v) {
+template <typename Iterator>
+std::string join(Iterator begin, Iterator end) {
   std::stringstream ss;
-  for (size_t i = 0; i < v.size(); ++i) {
-    if (i != 0) ss << ",";
-    ss << v[i];
+  for (Iterator it = begin; it != end; ++it) {
+    if (it != begin) ss << ",";
+    ss << *it;
   }
   return ss.str();
 }
 
-std::string logTokenization(const std::string& message,
-                            const Tokenizer::Tokens& tokens) {
+template <typename Iterator>
+std::string logTokenization(boost::string_ref message, Iterator begin,
+                            Iterator end) {
   std::stringstream ss;
-  ss << "Tokenization of \"" << message << "\" gives \"" << join(tokens)
+  ss << "Tokenization of \"" << message << "\" gives \"" << join(begin, end)
      << "\"";
   return ss.str();
 }
 
-void Tokenizer::tokenize(const std::string& message, Tokens& tokens) {
-  Splits splits = splitRegexp(message, m_regexpList);
-  tokenizeSplitsWithSingleCharacterDelimiter(splits, m_delimiters, tokens);
-  INTENT_LOG_TRACE() << logTokenization(message, tokens);
+}  // anonymous
+
+void Tokenizer::tokenize(const std::string& message, Tokens& tokens) const {
+  TokenViews views;
+  tokenizePart(message, m_delimiters, m_regexes, views);
+
+  tokens.reserve(tokens.size() + views.size());
+  for (const TokenView& view : views)
+    tokens.push_back(Token(view.data(), view.size()));
+  INTENT_LOG_TRACE() << logTokenization(message, tokens.begin(),
+                                        tokens.end());
+}
+
+void Tokenizer::tokenize(boost::string_ref message, TokenViews& tokens) const {
+  size_t firstToken = tokens.size();
+  tokenizePart(message, m_delimiters, m_regexes, tokens);
+  INTENT_LOG_TRACE() << logTokenization(message, tokens.begin() + firstToken,
+                                        tokens.end());
 }
 }
@@ -0,0 +1,186 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "intent/utils/AsyncLogSink.hpp"
+
+namespace intent
+{
+    namespace test
+    {
+        namespace
+        {
+            /**
+             * Records the written messages and can hold the flusher in the
+             * middle of a write until it is released.
+             */
+            class GatedOutput
+            {
+            public:
+                GatedOutput() : m_closed(false), m_waiting(false) {}
+
+                log::AsyncLogSink::Writer writer()
+                {
+                    return [this](int, const std::string& message)
+                    {
+                        std::unique_lock<std::mutex> lock(m_mutex);
+                        m_messages.push_back(message);
+                        m_waiting = true;
+                        m_gate.wait(lock, [this]() { return !m_closed; });
+                        m_waiting = false;
+                    };
+                }
+
+                void close() { std::lock_guard<std::mutex> lock(m_mutex); m_closed = true; }
+                void open()
+                {
+                    {
+                        std::lock_guard<std::mutex> lock(m_mutex);
+                        m_closed = false;
+                    }
+                    m_gate.notify_all();
+                }
+
+                void waitForTheFlusher()
+                {
+                    while(!m_waiting) std::this_thread::yield();
+                }
+
+                std::vector<std::string> messages()
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    return m_messages;
+                }
+
+            private:
+                std::mutex m_mutex;
+                std::condition_variable m_gate;
+                std::vector<std::string> m_messages;
+                bool m_closed;
+                std::atomic<bool> m_waiting;
+            };
+
+            std::vector<std::string> fillWhileTheFlusherIsHeld(log::AsyncLogSink::OverflowPolicy::type policy,
+                                                              size_t& droppedMessages)
+            {
+                GatedOutput output;
+                output.close();
+                log::AsyncLogSink sink(2, policy, output.writer());
+
+                sink.push(0, "held");
+                output.waitForTheFlusher();
+                for(const std::string message : {"a", "b", "c", "d", "e"})
+                    sink.push(0, message);
+
+                droppedMessages = sink.droppedMessages();
+                output.open();
+                sink.flush();
+                return output.messages();
+            }
+        }
+
+        TEST(AsyncLogSinkTest, write_the_messages_in_order)
+        {
+            GatedOutput output;
+            std::vector<std::string> expectedMessages;
+            {
+                log::AsyncLogSink sink(4, log::AsyncLogSink::OverflowPolicy::BLOCK, output.writer());
+                for(int i = 0; i < 100; ++i)
+                {
+                    expectedMessages.push_back(std::to_string(i));
+                    sink.push(0, std::to_string(i));
+                }
+                EXPECT_EQ(0u, sink.droppedMessages());
+            }
+
+            EXPECT_EQ(expectedMessages, output.messages());
+        }
+
+        TEST(AsyncLogSinkTest, drop_the_newest_messages_when_the_queue_is_full)
+        {
+            size_t droppedMessages = 0;
+            std::vector<std::string> messages =
+                fillWhileTheFlusherIsHeld(log::AsyncLogSink::OverflowPolicy::DROP_NEWEST, droppedMessages);
+
+            EXPECT_EQ(3u, droppedMessages);
+            EXPECT_EQ(std::vector<std::string>({"held", "a", "b"}), messages);
+        }
+
+        TEST(AsyncLogSinkTest, drop_the_oldest_messages_when_the_queue_is_full)
+        {
+            size_t droppedMessages = 0;
+            std::vector<std::string> messages =
+                fillWhileTheFlusherIsHeld(log::AsyncLogSink::OverflowPolicy::DROP_OLDEST, droppedMessages);
+
+            EXPECT_EQ(3u, droppedMessages);
+            EXPECT_EQ(std::vector<std::string>({"held", "d", "e"}), messages);
+        }
+
+        TEST(AsyncLogSinkTest, lose_no_message_of_concurrent_producers_when_blocking)
+        {
+            std::atomic<size_t> writtenMessages(0);
+            {
+                log::AsyncLogSink sink(8, log::AsyncLogSink::OverflowPolicy::BLOCK,
+                                       [&writtenMessages](int, const std::string&) { ++writtenMessages; });
+                std::vector<std::thread> producers;
+                for(int p = 0; p < 4; ++p)
+                {
+                    producers.emplace_back([&sink]()
+                    {
+                        for(int i = 0; i < 1000; ++i) sink.push(0, "message");
+                    });
+                }
+                for(std::thread& producer : producers) producer.join();
+
+                sink.flush();
+                EXPECT_EQ(4000u, writtenMessages.load());
+                EXPECT_EQ(0u, sink.droppedMessages());
+            }
+        }
+    }
+}
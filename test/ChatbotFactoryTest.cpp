@@ -48,10 +48,14 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "launcher/TestContext.hpp"
 
 #include "intent/chatbot/ChatbotFactory.hpp"
+#include "intent/utils/Deserializer.hpp"
+#include "intent/utils/ModelSnapshot.hpp"
 
 #include "mock/ChatbotMock.hpp"
 
+#include <cstdio>
 #include <fstream>
+#include <sstream>
 
 namespace intent
 {
@@ -134,6 +138,59 @@ namespace intent
                         ElementsAre("Veuillez récupérer vos consommations au bar.", "Au revoir et à bientôt."));
         }
 
+        TEST(ChatbotFactoryTest, create_single_session_chatbot_from_snapshot)
+        {
+            const intent::test::ResourceManager &resourceManager = intent::test::gTestContext->getResourceManager();
+
+            std::string interpreterModel = resourceManager.getResource(
+                    test::ResourceManager::ResourceId::INTERPRETER_MODEL);
+            std::stringstream dictionaryModel(resourceManager.getResource(
+                    test::ResourceManager::ResourceId::CHATBOT_MODEL_JSON_WITHOUT_INTENT_STORY));
+
+            Deserializer deserializer;
+            InterpreterFeedback feedback;
+            ChatbotModel chatbotModel = Interpreter::build(
+                    interpreterModel, deserializer.deserialize<DictionaryModel::SharedPtr>(dictionaryModel), feedback);
+
+            const std::string snapshotPath = "chatbot_model.snapshot";
+            {
+                std::ofstream snapshotFile(snapshotPath, std::ios::binary);
+                ModelSnapshot::write(chatbotModel, snapshotFile);
+            }
+
+            NiceMock<UserDefinedCommandMock> *userDefinedCommandMock = new NiceMock<UserDefinedCommandMock>();
+            Chatbot::UserDefinedActionHandler::SharedPtr userDefinedActionHandler(userDefinedCommandMock);
+
+            SingleSessionChatbot::SharedPtr chatbot =
+                    ChatbotFactory::createSingleSessionChatbotFromSnapshot(snapshotPath, userDefinedActionHandler);
+            std::remove(snapshotPath.c_str());
+
+            ASSERT_THAT(chatbot, NotNull());
+
+            ON_CALL(*userDefinedCommandMock, execute(_, _, _)).WillByDefault(Invoke(pushVariables));
+
+            std::vector<std::string> reply1 = chatbot->treatMessage("Bob!");
+            std::vector<std::string> reply2 = chatbot->treatMessage("Je veux un Coca et une Kro");
+            std::vector<std::string> reply3 = chatbot->treatMessage("Rien");
+
+            EXPECT_THAT(reply1, ElementsAre("Que puis-je vous offrir ?"));
+            EXPECT_THAT(reply2, ElementsAre("Vous-voulez quelque chose d'autre ?"));
+            EXPECT_THAT(reply3,
+                        ElementsAre("Veuillez récupérer vos consommations au bar. Vous devrez payer 10.5€."));
+        }
+
+        TEST(ChatbotFactoryTest, create_chatbot_from_unexisting_snapshot)
+        {
+            NiceMock<UserDefinedCommandMock> *userDefinedCommandMock = new NiceMock<UserDefinedCommandMock>();
+            Chatbot::UserDefinedActionHandler::SharedPtr userDefinedActionHandler(userDefinedCommandMock);
+
+            SingleSessionChatbot::SharedPtr chatbot =
+                    ChatbotFactory::createSingleSessionChatbotFromSnapshot("unexisting_file.snapshot",
+                                                                           userDefinedActionHandler);
+
+            ASSERT_THAT(chatbot, IsNull());
+        }
+
         TEST(ChatbotFactoryTest, create_chatbot_from_unexisting_file)
         {
             NiceMock<UserDefinedCommandMock> *userDefinedCommandMock = new NiceMock<UserDefinedCommandMock>();
@@ -64,7 +64,7 @@ void test_simple_deserialization(const DictionaryModel &dictionaryModel, const I
 
     EXPECT_EQ_SIGNED(19, dictionaryModel.dictionary.size());
     EXPECT_EQ_SIGNED(91, dictionaryModel.dictionary.index_size());
-    EXPECT_EQ_SIGNED(1, dictionaryModel.regexesByEntityId.size());
+    EXPECT_EQ_SIGNED(1, dictionaryModel.regexes.size());
 
     EXPECT_THAT(dictionaryModel.entitiesByEntityId, UnorderedElementsAre(std::pair<int, std::string>(0, "@beverage"),
                                                                    std::pair<int, std::string>(1, "@number"),
@@ -213,3 +213,164 @@ TEST(IntentDictionaryDeserializerTest, test_chatbot_deserialization)
                 ElementsAre("grab_it_reply", "bye_reply"));
 
 }
+
+namespace
+{
+    /**
+     * A document whose keys are not sorted, with duplicated keys, escaped
+     * strings and sections the models do not use.
+     */
+    std::string unsortedChatbotDocument(size_t termCount)
+    {
+        std::stringstream ss;
+        ss << "{\n\"chatbot\": {\"replies_by_state_action\": {\"s1\": {\"b\": [\"r2\"], \"a\": [\"r1\", \"r2\"]},"
+           << " \"root\": {\"go\": [\"r1\"]}},"
+           << " \"replies\": {\"r2\": \"Bye\\n\", \"r1\": \"Caf\\u00e9 \\ud83c\\udf7a\"}},\n"
+           << "\"version\": 1.5e0, \"unused\": [true, false, null, {\"x\": -0.25}],\n"
+           << "\"intent_story\": {\"graph\": {\"s1\": {\"b_intent:b\": \"s2\", \"a_intent:a\": \"s1\"},"
+           << " \"root\": {\"a_intent:go\": \"s1\"}}, \"root\": \"root\"},\n"
+           << "\"intents\": [{\"example\": \"one coke\", \"intent\": [\"@number\", \"@beverage:drink\"], \"id\": \"a_intent\"},"
+           << " {\"id\": \"b_intent\", \"intent\": [\"@number\", \"@number\"]},"
+           << " {\"id\": \"a_intent\", \"intent\": [\"@beverage\"]}],\n"
+           << "\"entities\": {\"@number\": {\"regex\": \"[0-9]+\", \"one\": [\"1\"]},"
+           << " \"@beverage\": {";
+        for(size_t i = termCount; i > 0; --i)
+        {
+            ss << "\"term" << i << "\": [\"alias" << i << "\", \"other alias" << i << "\"], ";
+        }
+        ss << "\"Coca-Cola\": [\"coke\"], \"Coca-Cola\": [\"coca\", \"cola\"]},"
+           << " \"@empty\": {}}\n}";
+        return ss.str();
+    }
+}
+
+namespace
+{
+    /**
+     * The ids of the unsorted document are the ones of its keys sorted, the
+     * last of duplicated keys winning.
+     */
+    void expectUnsortedChatbotModel(const ChatbotModel& chatbotModel)
+    {
+        const IntentServiceModel& intentServiceModel = chatbotModel.intentStoryServiceModel.intentServiceModel;
+
+        const DictionaryModel& dictionaryModel = *intentServiceModel.dictionaryModel;
+        ASSERT_THAT(dictionaryModel.entitiesByEntityId, SizeIs(3));
+        EXPECT_EQ("@beverage", dictionaryModel.entitiesByEntityId.at(0));
+        EXPECT_EQ("@empty", dictionaryModel.entitiesByEntityId.at(1));
+        EXPECT_EQ("@number", dictionaryModel.entitiesByEntityId.at(2));
+        ASSERT_THAT(dictionaryModel.regexes, SizeIs(1));
+        EXPECT_EQ("[0-9]+", dictionaryModel.regexes[0].pattern);
+        EXPECT_EQ(2, dictionaryModel.regexes[0].entityId);
+
+        const TermIndex& dictionary = dictionaryModel.dictionary;
+        Term cocaCola = dictionary.findTerm(0);
+        EXPECT_EQ("Coca-Cola", cocaCola.term);
+        EXPECT_EQ(0, cocaCola.entityId);
+        EXPECT_THAT(cocaCola.alias, ElementsAre("coca", "cola"));
+        EXPECT_EQ("term1", dictionary.findTerm(1).term);
+        EXPECT_EQ("term10", dictionary.findTerm(2).term);
+        EXPECT_EQ("term2", dictionary.findTerm(112).term);
+        Term lastTerm = dictionary.findTerm(200);
+        EXPECT_EQ("term99", lastTerm.term);
+        EXPECT_EQ(0, lastTerm.entityId);
+        EXPECT_THAT(lastTerm.alias, ElementsAre("alias99", "other alias99"));
+        Term one = dictionary.findTerm(201);
+        EXPECT_EQ("one", one.term);
+        EXPECT_EQ(2, one.entityId);
+        EXPECT_THAT(one.alias, ElementsAre("1"));
+        // The regex takes the next term id.
+        EXPECT_EQ(-1, dictionary.findTerm(202).termId);
+        EXPECT_EQ(0, dictionary.findTerm("coca").termId);
+
+        const IntentModel::IntentIndex& intents = intentServiceModel.intentModel->intentsByIntentId;
+        ASSERT_THAT(intents, SizeIs(2));
+        EXPECT_THAT(intents.at("a_intent").entities, ElementsAre(0));
+        EXPECT_EQ("", intents.at("a_intent").example);
+        EXPECT_THAT(intents.at("b_intent").entities, ElementsAre(2, 2));
+
+        const IntentStoryModel& story = *chatbotModel.intentStoryServiceModel.intentStoryModel;
+        EXPECT_EQ("root", story.rootStateId);
+        ASSERT_THAT(story.vertexByStateId, SizeIs(3));
+        EXPECT_EQ(0u, story.vertexByStateId.at("root").getVertex());
+        EXPECT_EQ(1u, story.vertexByStateId.at("s1").getVertex());
+        EXPECT_EQ(2u, story.vertexByStateId.at("s2").getVertex());
+
+        IntentStoryModel::StoryGraph::Edges rootEdges = story.graph.nextEdges(story.vertexByStateId.at("root"));
+        ASSERT_THAT(rootEdges, SizeIs(1));
+        EXPECT_EQ(1u, rootEdges[0].getTarget().getVertex());
+        EXPECT_EQ("a_intent", rootEdges[0].getInfo().intent.intentId);
+        EXPECT_EQ("go", rootEdges[0].getInfo().actionId);
+
+        IntentStoryModel::StoryGraph::Edges s1Edges = story.graph.nextEdges(story.vertexByStateId.at("s1"));
+        ASSERT_THAT(s1Edges, SizeIs(2));
+        EXPECT_EQ(1u, s1Edges[0].getTarget().getVertex());
+        EXPECT_EQ("a_intent", s1Edges[0].getInfo().intent.intentId);
+        EXPECT_EQ("a", s1Edges[0].getInfo().actionId);
+        EXPECT_EQ(2u, s1Edges[1].getTarget().getVertex());
+        EXPECT_EQ("b_intent", s1Edges[1].getInfo().intent.intentId);
+        EXPECT_EQ("b", s1Edges[1].getInfo().actionId);
+
+        const ChatbotActionModel& actions = *chatbotModel.chatbotActionModel;
+        ASSERT_THAT(actions.replyContentByReplyIdIndex, SizeIs(2));
+        EXPECT_EQ("Caf\xc3\xa9 \xf0\x9f\x8d\xba", actions.replyContentByReplyIdIndex.at("r1"));
+        EXPECT_EQ("Bye\n", actions.replyContentByReplyIdIndex.at("r2"));
+        ASSERT_THAT(actions.replyIdsByStateAndActionId, SizeIs(3));
+        ChatbotActionModel::StateAndActionId stateAndActionId;
+        stateAndActionId.state = "s1";
+        stateAndActionId.actionId = "a";
+        EXPECT_THAT(actions.replyIdsByStateAndActionId.at(stateAndActionId), ElementsAre("r1", "r2"));
+        stateAndActionId.actionId = "b";
+        EXPECT_THAT(actions.replyIdsByStateAndActionId.at(stateAndActionId), ElementsAre("r2"));
+        stateAndActionId.state = "root";
+        stateAndActionId.actionId = "go";
+        EXPECT_THAT(actions.replyIdsByStateAndActionId.at(stateAndActionId), ElementsAre("r1"));
+    }
+}
+
+TEST(IntentDictionaryDeserializerTest, number_an_unsorted_document_with_duplicated_keys_in_key_order)
+{
+    std::string document = unsortedChatbotDocument(200);
+    Deserializer deserializer;
+
+    std::stringstream ss(document);
+    expectUnsortedChatbotModel(deserializer.deserialize<ChatbotModel>(ss));
+    expectUnsortedChatbotModel(deserializer.deserialize<ChatbotModel>(nlohmann::json::parse(document)));
+}
+
+TEST(IntentDictionaryDeserializerTest, reject_a_truncated_stream)
+{
+    std::string document = unsortedChatbotDocument(10);
+    std::stringstream ss(document.substr(0, document.size() / 2));
+
+    Deserializer deserializer;
+    EXPECT_THROW(deserializer.deserialize<ChatbotModel>(ss), DeserializerException);
+}
+
+TEST(IntentDictionaryDeserializerTest, a_duplicated_entity_replaces_the_previous_one)
+{
+    std::stringstream ss;
+    ss << "{\"entities\": {\"@drink\": {\"beer\": [], \"wine\": []},"
+       << " \"@food\": {\"pizza\": []}, \"@drink\": {\"water\": [\"h2o\"]}}}";
+
+    Deserializer deserializer;
+    DictionaryModel::SharedPtr dictionaryModel = deserializer.deserialize<DictionaryModel::SharedPtr>(ss);
+
+    EXPECT_EQ("water", dictionaryModel->dictionary.findTerm(0).term);
+    EXPECT_EQ(0, dictionaryModel->dictionary.findTerm(0).entityId);
+    EXPECT_EQ("pizza", dictionaryModel->dictionary.findTerm(1).term);
+    EXPECT_EQ(1, dictionaryModel->dictionary.findTerm(1).entityId);
+    EXPECT_EQ(-1, dictionaryModel->dictionary.findTerm(2).termId);
+    EXPECT_EQ(-1, dictionaryModel->dictionary.findTerm("beer").termId);
+}
+
+TEST(IntentDictionaryDeserializerTest, reject_entities_given_again_after_the_intents)
+{
+    std::stringstream ss;
+    ss << "{\"entities\": {\"@drink\": {\"beer\": []}},"
+       << " \"intents\": [{\"id\": \"order\", \"intent\": [\"@drink\"]}],"
+       << " \"entities\": {\"@food\": {\"pizza\": []}}}";
+
+    Deserializer deserializer;
+    EXPECT_THROW(deserializer.deserialize<IntentServiceModel>(ss), DeserializerException);
+}
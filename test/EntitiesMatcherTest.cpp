@@ -80,6 +80,30 @@ public:
     DictionaryModel m_dictionaryModel;
 };
 
+class EntitiesMatcherVitaminBeerTest : public ::testing::Test
+{
+public:
+    void SetUp()
+    {
+        Term t1, t2;
+        t1.term = "vitamin c";
+        t1.entityId = 0;
+        t1.termId = 0;
+
+        t2.term = "beer";
+        t2.entityId = 1;
+        t2.termId = 1;
+
+        m_dictionaryModel.dictionary.pushTerm(t1);
+        m_dictionaryModel.dictionary.pushTerm(t2);
+
+        m_dictionaryModel.entitiesByEntityId[0] = "@product";
+        m_dictionaryModel.entitiesByEntityId[1] = "@drink";
+    }
+
+    DictionaryModel m_dictionaryModel;
+};
+
 class RegexMatcherTest : public ::testing::Test
 {};
 
@@ -90,7 +114,7 @@ public:
     void SetUp()
     {
         std::string phone_expression = "^[0-9]{10,}$";
-        m_dictionaryModel.regexesByEntityId[phone_expression] = 0;
+        m_dictionaryModel.addRegex(phone_expression, 0);
         m_dictionaryModel.entitiesByEntityId[0] = "@phonenumber";
     }
 
@@ -189,6 +213,72 @@ TEST_F(EntitiesMatcherWishCoffeeTest, find_entities_even_the_case_is_different)
     ASSERT_THAT(variables, ElementsAre(v1));
 }
 
+TEST_F(EntitiesMatcherWishCoffeeTest, find_entities_in_views_of_the_sentence)
+{
+    std::string sentence("I want to order a STARBUCKS");
+
+    Tokenizer::TokenViews tokens;
+    tokens.push_back(Tokenizer::TokenView(sentence.data(), 1));
+    tokens.push_back(Tokenizer::TokenView(sentence.data() + 2, 4));
+    tokens.push_back(Tokenizer::TokenView(sentence.data() + 7, 2));
+    tokens.push_back(Tokenizer::TokenView(sentence.data() + 10, 5));
+    tokens.push_back(Tokenizer::TokenView(sentence.data() + 16, 1));
+    tokens.push_back(Tokenizer::TokenView(sentence.data() + 18, 9));
+
+    EntitiesMatcher::Variables variables = EntitiesMatcher::match(tokens, m_dictionaryModel);
+
+    EntitiesMatcher::Variable v1, v2;
+    v1.term = 1;
+    v1.entity = 1;
+    v1.text = "want";
+
+    v2.term = 0;
+    v2.entity = 0;
+    v2.text = "STARBUCKS";
+
+    ASSERT_THAT(variables, ElementsAre(v1, v2));
+}
+
+TEST_F(EntitiesMatcherVitaminBeerTest, do_not_fuzzy_match_an_alias_over_the_next_exact_term)
+{
+    Tokenizer::Tokens tokens = {"vitamin", "beer", "now"};
+
+    EntitiesMatcher::Variables variables = EntitiesMatcher::match(tokens, m_dictionaryModel);
+
+    EntitiesMatcher::Variable beer;
+    beer.term = 1;
+    beer.entity = 1;
+    beer.text = "beer";
+
+    ASSERT_THAT(variables, ElementsAre(beer));
+}
+
+TEST_F(EntitiesMatcherVitaminBeerTest, fuzzy_match_an_alias_before_the_next_exact_term)
+{
+    Tokenizer::Tokens tokens = {"vitamn", "c", "beer"};
+
+    EntitiesMatcher::Variables variables = EntitiesMatcher::match(tokens, m_dictionaryModel);
+
+    EntitiesMatcher::Variable vitamin, beer;
+    vitamin.term = 0;
+    vitamin.entity = 0;
+    vitamin.text = "vitamn";
+    beer.term = 1;
+    beer.entity = 1;
+    beer.text = "beer";
+
+    ASSERT_THAT(variables, ElementsAre(vitamin, beer));
+}
+
+TEST_F(EntitiesMatcherVitaminBeerTest, do_not_fuzzy_match_an_alias_past_the_end_of_the_sentence)
+{
+    Tokenizer::Tokens tokens = {"some", "vitamin"};
+
+    EntitiesMatcher::Variables variables = EntitiesMatcher::match(tokens, m_dictionaryModel);
+
+    ASSERT_THAT(variables, IsEmpty());
+}
+
 TEST_F(RegexMatcherTest, test_phone_number)
 {
     std::string number("0612345678");
@@ -218,6 +308,16 @@ TEST_F(RegexMatcherTest, test_simple)
     ASSERT_TRUE(RegexMatcher::match(simple, regexp));
 }
 
+TEST_F(RegexMatcherTest, test_compiled_regex)
+{
+    std::string regexp("^[0-9]{10,}$");
+
+    RegexMatcher::CompiledRegex compiledRegex = RegexMatcher::compile(regexp);
+
+    ASSERT_TRUE(RegexMatcher::match("0612345678", *compiledRegex));
+    ASSERT_FALSE(RegexMatcher::match("0x000000", *compiledRegex));
+}
+
 TEST_F(EntitiesMatcherRegexTest, test_simple_regex_match)
 {
     EntitiesMatcher entitiesMatcher;
@@ -96,11 +96,48 @@ namespace intent
             g.addEdge(v1, v2, 3);
             g.addEdge(v1, v3, 3);
             g.addEdge(v1, v4, 3);
+            g.freeze();
 
             G::Edges edges = g.nextEdges(v2);
 
             EXPECT_THAT(g.nextEdges(v2), IsEmpty());
             EXPECT_THAT(g.nextEdges(v1), SizeIs(3));
         }
+
+        TEST(GraphTest, keep_the_order_of_the_edges_of_each_vertex_when_frozen)
+        {
+            typedef Graph<int, int> G;
+            G g;
+
+            G::Vertex v1 = g.addVertex(1);
+            G::Vertex v2 = g.addVertex(2);
+            G::Vertex v3 = g.addVertex(3);
+
+            g.addEdge(v2, v3, 21);
+            g.addEdge(v1, v2, 11);
+            g.addEdge(v2, v1, 22);
+            g.addEdge(v1, v3, 12);
+            EXPECT_FALSE(g.isFrozen());
+            EXPECT_THROW(g.nextEdges(v1), GraphException);
+
+            g.freeze();
+            G::Vertex v4 = g.addVertex(4);
+            EXPECT_TRUE(g.isFrozen());
+
+            std::vector<int> infos;
+            for (const G::Edge& e : g.nextEdges(v1))
+                infos.push_back(e.getInfo());
+            EXPECT_THAT(infos, ElementsAre(11, 12));
+
+            G::Edges edges = g.nextEdges(v2);
+            ASSERT_EQ(2, static_cast<int>(edges.size()));
+            EXPECT_EQ(21, edges[0].getInfo());
+            EXPECT_EQ(3, edges[0].getTarget().getInfo());
+            EXPECT_EQ(22, edges[1].getInfo());
+            EXPECT_EQ(2, edges[1].getSource().getInfo());
+
+            EXPECT_THAT(g.nextEdges(v3), IsEmpty());
+            EXPECT_THAT(g.nextEdges(v4), IsEmpty());
+        }
     }
 }
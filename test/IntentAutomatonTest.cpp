@@ -0,0 +1,210 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "intent/intent_service/IntentAutomaton.hpp"
+#include "intent/utils/RegexMatcher.hpp"
+
+using namespace ::testing;
+
+namespace intent
+{
+    namespace test
+    {
+        namespace
+        {
+            int marker(char c)
+            {
+                return RegexMatcher::regexMarkerToEntityId(std::string(1, c));
+            }
+
+            void addIntent(IntentModel::IntentIndex& intentIndex, const std::string& intentId,
+                           const std::vector<int>& entities)
+            {
+                IntentModel::Intent intent;
+                intent.intentId = intentId;
+                intent.entities = entities;
+                intentIndex[intentId] = intent;
+            }
+
+            std::vector<std::string> matchingIntentIds(const IntentAutomaton& automaton,
+                                                       const std::vector<int>& entityIds)
+            {
+                IntentAutomaton::IntentRefs intentRefs;
+                automaton.match(entityIds, intentRefs);
+
+                std::vector<std::string> intentIds;
+                for(IntentAutomaton::IntentRef intentRef : intentRefs)
+                    intentIds.push_back(automaton.getIntentId(intentRef));
+                return intentIds;
+            }
+        }
+
+        TEST(IntentAutomatonTest, match_plain_sequences)
+        {
+            IntentModel::IntentIndex intentIndex;
+            addIntent(intentIndex, "order", {1, 0});
+            addIntent(intentIndex, "order2", {1, 0, 1, 0});
+            addIntent(intentIndex, "hello", {2});
+
+            IntentAutomaton automaton(intentIndex);
+
+            EXPECT_THAT(matchingIntentIds(automaton, {1, 0}), ElementsAre("order"));
+            EXPECT_THAT(matchingIntentIds(automaton, {1, 0, 1, 0}), ElementsAre("order2"));
+            EXPECT_THAT(matchingIntentIds(automaton, {2}), ElementsAre("hello"));
+            EXPECT_THAT(matchingIntentIds(automaton, {1, 0, 1}), IsEmpty());
+            EXPECT_THAT(matchingIntentIds(automaton, {}), IsEmpty());
+            EXPECT_THAT(matchingIntentIds(automaton, {42}), IsEmpty());
+        }
+
+        TEST(IntentAutomatonTest, match_regex_markers_at_entity_level)
+        {
+            IntentModel::IntentIndex intentIndex;
+            // ( 1 0 ) *
+            addIntent(intentIndex, "orders", {marker('('), 1, 0, marker(')'), marker('*')});
+            // [ 3 4 ] 5
+            addIntent(intentIndex, "one_of", {marker('['), 3, 4, marker(']'), 5});
+            // 6 | 7 8
+            addIntent(intentIndex, "either", {6, marker('|'), 7, 8});
+            // 9 10 *
+            addIntent(intentIndex, "repeat_last", {9, 10, marker('*')});
+
+            IntentAutomaton automaton(intentIndex);
+
+            EXPECT_THAT(matchingIntentIds(automaton, {}), ElementsAre("orders"));
+            EXPECT_THAT(matchingIntentIds(automaton, {1, 0, 1, 0, 1, 0}), ElementsAre("orders"));
+            EXPECT_THAT(matchingIntentIds(automaton, {1, 0, 1}), IsEmpty());
+
+            EXPECT_THAT(matchingIntentIds(automaton, {3, 5}), ElementsAre("one_of"));
+            EXPECT_THAT(matchingIntentIds(automaton, {4, 5}), ElementsAre("one_of"));
+            EXPECT_THAT(matchingIntentIds(automaton, {3, 4, 5}), IsEmpty());
+
+            EXPECT_THAT(matchingIntentIds(automaton, {6}), ElementsAre("either"));
+            EXPECT_THAT(matchingIntentIds(automaton, {7, 8}), ElementsAre("either"));
+            EXPECT_THAT(matchingIntentIds(automaton, {6, 8}), IsEmpty());
+
+            EXPECT_THAT(matchingIntentIds(automaton, {9}), ElementsAre("repeat_last"));
+            EXPECT_THAT(matchingIntentIds(automaton, {9, 10, 10, 10}), ElementsAre("repeat_last"));
+            EXPECT_THAT(matchingIntentIds(automaton, {9, 10, 9}), IsEmpty());
+        }
+
+        TEST(IntentAutomatonTest, report_every_accepting_intent)
+        {
+            IntentModel::IntentIndex intentIndex;
+            addIntent(intentIndex, "a", {1, 2});
+            addIntent(intentIndex, "b", {1, marker('['), 2, 3, marker(']')});
+            addIntent(intentIndex, "c", {1, 3});
+
+            IntentAutomaton automaton(intentIndex);
+
+            EXPECT_THAT(matchingIntentIds(automaton, {1, 2}), ElementsAre("a", "b"));
+            EXPECT_THAT(matchingIntentIds(automaton, {1, 3}), ElementsAre("b", "c"));
+
+            IntentAutomaton::IntentRefs allowedIntents = {automaton.findIntent("c")};
+            IntentAutomaton::IntentRefs intentRefs;
+            automaton.match({1, 3}, allowedIntents, intentRefs);
+            EXPECT_THAT(intentRefs, ElementsAre(automaton.findIntent("c")));
+
+            automaton.match({1, 2}, allowedIntents, intentRefs);
+            EXPECT_THAT(intentRefs, IsEmpty());
+        }
+
+        TEST(IntentAutomatonTest, hash_plain_intents_out_of_the_dfa)
+        {
+            IntentModel::IntentIndex intentIndex;
+            addIntent(intentIndex, "a", {1, 2});
+            addIntent(intentIndex, "b", {1, 2});
+            addIntent(intentIndex, "c", {2});
+
+            IntentAutomaton automaton(intentIndex);
+
+            EXPECT_EQ(1, static_cast<int>(automaton.stateCount()));
+            EXPECT_THAT(matchingIntentIds(automaton, {1, 2}), ElementsAre("a", "b"));
+            EXPECT_THAT(matchingIntentIds(automaton, {2}), ElementsAre("c"));
+            EXPECT_THAT(matchingIntentIds(automaton, {2, 1}), IsEmpty());
+            EXPECT_THAT(matchingIntentIds(automaton, {}), IsEmpty());
+        }
+
+        TEST(IntentAutomatonTest, merge_plain_and_pattern_intents_in_order)
+        {
+            IntentModel::IntentIndex intentIndex;
+            addIntent(intentIndex, "a", {1, 2});
+            addIntent(intentIndex, "b", {1, 2, marker('*')});
+            addIntent(intentIndex, "c", {1, 2});
+            addIntent(intentIndex, "d", {1});
+
+            IntentAutomaton automaton(intentIndex);
+
+            EXPECT_THAT(matchingIntentIds(automaton, {1, 2}), ElementsAre("a", "b", "c"));
+            EXPECT_THAT(matchingIntentIds(automaton, {1}), ElementsAre("b", "d"));
+            EXPECT_THAT(matchingIntentIds(automaton, {1, 2, 2}), ElementsAre("b"));
+        }
+
+        TEST(IntentAutomatonTest, malformed_intents_never_match)
+        {
+            IntentModel::IntentIndex intentIndex;
+            addIntent(intentIndex, "unbalanced", {marker('('), 1});
+            addIntent(intentIndex, "dangling_star", {marker('*'), 1});
+            addIntent(intentIndex, "empty_class", {marker('['), marker(']')});
+            addIntent(intentIndex, "valid", {1});
+
+            IntentAutomaton automaton(intentIndex);
+
+            EXPECT_EQ(4, static_cast<int>(automaton.intentCount()));
+            EXPECT_THAT(matchingIntentIds(automaton, {1}), ElementsAre("valid"));
+            EXPECT_THAT(matchingIntentIds(automaton, {}), IsEmpty());
+        }
+
+        TEST(IntentAutomatonTest, find_intent_by_id)
+        {
+            IntentModel::IntentIndex intentIndex;
+            addIntent(intentIndex, "a", {1});
+            addIntent(intentIndex, "b", {2});
+
+            IntentAutomaton automaton(intentIndex);
+
+            ASSERT_GE(automaton.findIntent("b"), 0);
+            EXPECT_EQ("b", automaton.getIntentId(automaton.findIntent("b")));
+            EXPECT_EQ(-1, automaton.findIntent("unknown"));
+        }
+    }
+}
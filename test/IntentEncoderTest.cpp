@@ -0,0 +1,95 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <gtest/gtest.h>
+
+#include <random>
+#include <sstream>
+
+#include "intent/intent_service/IntentEncoder.hpp"
+#include "intent/utils/RegexMatcher.hpp"
+
+namespace intent
+{
+    namespace test
+    {
+        namespace
+        {
+            // The encoding built with streams the intent ids have always used.
+            std::string encodeWithStreams(const std::vector<int>& entities)
+            {
+                std::stringstream result;
+                for(int entity : entities)
+                {
+                    if(RegexMatcher::isEntityRegexMarker(entity))
+                    {
+                        result << RegexMatcher::REGEX_MARKERS[0xFFFF - entity];
+                        continue;
+                    }
+                    std::stringstream stream;
+                    stream << std::hex << entity;
+                    std::string hex = stream.str();
+                    result << std::string(hex.size() < 4 ? 4 - hex.size() : 0, '0') << hex;
+                }
+                return result.str();
+            }
+        }
+
+        TEST(IntentEncoderTest, encode_entities_as_padded_hexadecimal)
+        {
+            EXPECT_EQ("00010000", IntentEncoder::encode({1, 0}));
+            EXPECT_EQ("(0001abcd)*", IntentEncoder::encode({0xFFFD, 1, 0xABCD, 0xFFFC, 0xFFFA}));
+            EXPECT_EQ("12345", IntentEncoder::encode({0x12345}));
+            EXPECT_EQ("", IntentEncoder::encode(std::vector<int>()));
+        }
+
+        TEST(IntentEncoderTest, encode_like_the_stream_based_encoding)
+        {
+            std::mt19937 generator(7);
+            std::uniform_int_distribution<int> entity(0, 0x1FFFF);
+            for(int i = 0; i < 1000; ++i)
+            {
+                std::vector<int> entities(generator() % 6);
+                for(int& e : entities) e = entity(generator);
+                EXPECT_EQ(encodeWithStreams(entities), IntentEncoder::encode(entities));
+            }
+        }
+    }
+}
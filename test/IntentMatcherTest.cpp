@@ -109,8 +109,8 @@ namespace intent
             variables.push_back(beverage);
 
             const EntitiesMatcher::Variables& const_variables = const_cast<const EntitiesMatcher::Variables&>(variables);
-            const IntentModel::IntentIndex intentModel = m_intentModel->intentsByIntentId;
-            const IntentMatcher::IntentResult intentResult = IntentMatcher::match(*m_dictionaryModel, const_variables, intentModel);
+            const IntentAutomaton intentAutomaton(m_intentModel->intentsByIntentId);
+            const IntentMatcher::IntentResult intentResult = IntentMatcher::match(*m_dictionaryModel, const_variables, intentAutomaton);
 
             ASSERT_TRUE(intentResult.found);
 
@@ -150,8 +150,8 @@ namespace intent
             variables.push_back(alcohol);
 
             const EntitiesMatcher::Variables& const_variables = const_cast<const EntitiesMatcher::Variables&>(variables);
-            const IntentModel::IntentIndex intentModel = m_intentModel->intentsByIntentId;
-            const IntentMatcher::IntentResult intentResult = IntentMatcher::match(*m_dictionaryModel, const_variables, intentModel);
+            const IntentAutomaton intentAutomaton(m_intentModel->intentsByIntentId);
+            const IntentMatcher::IntentResult intentResult = IntentMatcher::match(*m_dictionaryModel, const_variables, intentAutomaton);
 
             ASSERT_TRUE(intentResult.found);
 
@@ -201,7 +201,8 @@ namespace intent
             intent.entities = {0xFFFD, 1, 0, 0xFFFC, 0xFFFA};
             intentModel.insert(std::make_pair(IntentEncoder::encode({0xFFFD, 1, 0, 0xFFFC, 0xFFFA}), intent));
 
-            const IntentMatcher::IntentResult intentResult = IntentMatcher::match(*m_dictionaryModel, const_variables, intentModel);
+            const IntentAutomaton intentAutomaton(intentModel);
+            const IntentMatcher::IntentResult intentResult = IntentMatcher::match(*m_dictionaryModel, const_variables, intentAutomaton);
 
             ASSERT_TRUE(intentResult.found);
             ASSERT_EQ(IntentEncoder::encode({0xFFFD, 1, 0, 0xFFFC, 0xFFFA}), intentResult.intent.intentId);
@@ -130,6 +130,26 @@ namespace intent
         }
 
 
+        TEST_F(IntentServiceBeverageTest, evaluate_a_batch_in_the_order_of_the_inputs)
+        {
+            IntentService intentService(m_intentServiceModel);
+            ThreadPool threadPool(3);
+
+            std::vector<std::string> messages;
+            for(int i = 0; i < 50; ++i)
+            {
+                messages.push_back("Bonjour, j'aimerais 2 Coca-Cola");
+                messages.push_back("Coucou, je m'appelle John");
+                messages.push_back("Bonjour, j'aimerais 2 pintes de Kro");
+            }
+            IntentService::Inputs inputs(messages.begin(), messages.end());
+
+            IntentService::Results results = intentService.evaluateBatch(inputs, threadPool);
+
+            ASSERT_EQ(messages.size(), results.size());
+            for(size_t i = 0; i < messages.size(); ++i)
+                EXPECT_EQ(intentService.evaluate(messages[i]), results[i]);
+        }
 
     }
 }
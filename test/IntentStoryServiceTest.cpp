@@ -140,6 +140,32 @@ namespace intent
 
             EXPECT_FALSE(intentStoryService.evaluate("root", "Bonjour, je voudrais de la Kro").found);
         }
+
+        TEST_F(IntentStoryServiceBeverageTest, matching_from_a_state_handle)
+        {
+            IntentStoryService intentStoryService(m_intentStoryServiceModel);
+
+            IntentStoryService::StateHandle root = intentStoryService.findState("root");
+            ASSERT_EQ(root, intentStoryService.getRootState());
+            EXPECT_EQ("root", intentStoryService.getStateId(root));
+
+            IntentStoryService::Result result = intentStoryService.evaluate(root, "Bonjour, je voudrais 2 Kro");
+
+            ASSERT_TRUE(result.found);
+            EXPECT_EQ("order1", result.intent.intentId);
+            EXPECT_EQ(intentStoryService.findState("credit_card"), result.nextState);
+            EXPECT_EQ("", result.nextStateId);
+        }
+
+        TEST_F(IntentStoryServiceBeverageTest, not_matching_from_an_unknown_state)
+        {
+            IntentStoryService intentStoryService(m_intentStoryServiceModel);
+
+            EXPECT_EQ(IntentStoryModel::NO_STATE, intentStoryService.findState("unknown"));
+            EXPECT_EQ("", intentStoryService.getStateId(IntentStoryModel::NO_STATE));
+            EXPECT_FALSE(intentStoryService.evaluate(IntentStoryModel::NO_STATE, "Bonjour, je voudrais 2 Kro").found);
+            EXPECT_FALSE(intentStoryService.evaluate("unknown", "Bonjour, je voudrais 2 Kro").found);
+        }
     }
 
 
@@ -183,4 +209,18 @@ namespace intent
         ASSERT_TRUE(appendAnswer.found);
         EXPECT_EQ("nothing", appendAnswer.intent.intentId);
     }
+
+    TEST_F(OrderBeverageStoryTest, require_a_frozen_story_graph)
+    {
+        IntentStoryModel::StoryGraph &graph = m_intentStoryServiceModel.intentStoryModel->graph;
+        IntentStoryModel::StoryGraph::Vertex init = m_intentStoryServiceModel.intentStoryModel->vertexByStateId.at("init");
+        graph.addEdge(init, init, IntentStoryModel::EdgeInfo());
+
+        EXPECT_THROW(IntentStoryService intentStoryService(m_intentStoryServiceModel), GraphException);
+        EXPECT_FALSE(graph.isFrozen());
+
+        graph.freeze();
+        IntentStoryService intentStoryService(m_intentStoryServiceModel);
+        EXPECT_TRUE(intentStoryService.evaluate("init", "Bob!").found);
+    }
 }
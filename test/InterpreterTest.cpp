@@ -47,6 +47,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "intent/intent_story_service/IntentStoryService.hpp"
 #include "intent/interpreter/SentenceToIntentTranslator.hpp"
 #include "intent/interpreter/EdgeParser.hpp"
+#include "intent/interpreter/InterpreterCache.hpp"
+#include "intent/interpreter/ScenarioIndexer.hpp"
 #include "intent/interpreter/ReplyTemplateInterpreter.hpp"
 #include "intent/chatbot/SingleSessionChatbot.hpp"
 #include "mock/ChatbotMock.hpp"
@@ -55,6 +57,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "intent/interpreter/Interpreter.hpp"
 #include "intent/utils/Deserializer.hpp"
+#include "intent/utils/ModelSnapshot.hpp"
+#include "intent/utils/ThreadPool.hpp"
 
 #include <string>
 #include <sstream>
@@ -100,6 +104,19 @@ TEST_F(InterpreterTest, check_that_intent_is_defined_by_entities)
     EXPECT_EQ(IntentEncoder::encode({1,0,1,0}), intent.first);
 }
 
+TEST_F(InterpreterTest, check_that_a_memoized_translation_keeps_the_sentence)
+{
+    SentenceToIntentTranslator translator(m_dictionaryModel);
+    std::pair<IntentModel::IndexType, IntentModel::Intent> intent =
+            translator.translate("Je voudrais une Kronenbourg et un coca");
+    std::pair<IntentModel::IndexType, IntentModel::Intent> memoizedIntent =
+            translator.translate("Je voudrais une Kronenbourg, et un coca !");
+
+    EXPECT_EQ(IntentEncoder::encode({1,0,1,0}), memoizedIntent.first);
+    EXPECT_EQ(intent.second.entities, memoizedIntent.second.entities);
+    EXPECT_EQ("Je voudrais une Kronenbourg, et un coca !", memoizedIntent.second.example);
+}
+
 TEST_F(InterpreterTest, check_that_an_edge_is_parsed)
 {
     const Scenario lines = {ScriptLine("@root"),
@@ -479,4 +496,170 @@ TEST_F(InterpreterIncorrectModelTest, check_interpreter_feedback_when_wrong_mode
     EXPECT_EQ_SIGNED(3, m_interpreterFeedback[2].line.position);
 }
 
+TEST(InterpreterParallelBuildTest, build_the_same_model_with_a_thread_pool)
+{
+    const intent::test::ResourceManager &resourceManager = intent::test::gTestContext->getResourceManager();
+    std::stringstream ss(resourceManager.getResource(test::ResourceManager::ResourceId::
+                                                     CHATBOT_MODEL_JSON_WITHOUT_INTENT_STORY));
+    Deserializer deserializer;
+    DictionaryModel::SharedPtr dictionaryModel = deserializer.deserialize<DictionaryModel::SharedPtr>(ss);
+
+    // Many scenarios, some of them with anonymous states and actions.
+    std::string script;
+    for(int i = 0; i < 20; ++i)
+    {
+        script += resourceManager.getResource(test::ResourceManager::ResourceId::INTERPRETER_MODEL);
+        script += resourceManager.getResource(test::ResourceManager::ResourceId::INTERPRETER_MODEL_W_ERRORS);
+    }
+
+    InterpreterFeedback serialFeedback;
+    ChatbotModel serialModel = Interpreter::build(script, dictionaryModel, serialFeedback);
+
+    ThreadPool threadPool(4);
+    InterpreterFeedback parallelFeedback;
+    ChatbotModel parallelModel = Interpreter::build(script, dictionaryModel, parallelFeedback, threadPool);
+
+    ASSERT_EQ(serialFeedback.size(), parallelFeedback.size());
+    for(size_t i = 0; i < serialFeedback.size(); ++i)
+    {
+        EXPECT_EQ(serialFeedback[i].message, parallelFeedback[i].message);
+        EXPECT_EQ(serialFeedback[i].line.content, parallelFeedback[i].line.content);
+        EXPECT_EQ(serialFeedback[i].line.position, parallelFeedback[i].line.position);
+        EXPECT_EQ(serialFeedback[i].level, parallelFeedback[i].level);
+    }
+
+    std::stringstream serialSnapshot, parallelSnapshot;
+    ModelSnapshot::write(serialModel, serialSnapshot);
+    ModelSnapshot::write(parallelModel, parallelSnapshot);
+    EXPECT_TRUE(serialSnapshot.str() == parallelSnapshot.str());
+}
+
+class InterpreterCacheTest : public ::testing::Test
+{
+public:
+    void SetUp()
+    {
+        const intent::test::ResourceManager &resourceManager = intent::test::gTestContext->getResourceManager();
+        std::stringstream ss(resourceManager.getResource(test::ResourceManager::ResourceId::
+                                                         CHATBOT_MODEL_JSON_WITHOUT_INTENT_STORY));
+        Deserializer deserializer;
+        m_dictionaryModel = deserializer.deserialize<DictionaryModel::SharedPtr>(ss);
+
+        m_script = resourceManager.getResource(test::ResourceManager::ResourceId::INTERPRETER_MODEL) +
+                   resourceManager.getResource(test::ResourceManager::ResourceId::INTERPRETER_MODEL_W_ERRORS);
+    }
+
+    void expectSameBuild(const std::string &script, InterpreterCache &cache)
+    {
+        InterpreterFeedback fullFeedback;
+        ChatbotModel fullModel = Interpreter::build(script, m_dictionaryModel, fullFeedback);
+
+        InterpreterFeedback feedback;
+        ChatbotModel model = Interpreter::build(script, m_dictionaryModel, feedback, cache);
+
+        ASSERT_EQ(fullFeedback.size(), feedback.size());
+        for(size_t i = 0; i < fullFeedback.size(); ++i)
+        {
+            EXPECT_EQ(fullFeedback[i].message, feedback[i].message);
+            EXPECT_EQ(fullFeedback[i].line.content, feedback[i].line.content);
+            EXPECT_EQ(fullFeedback[i].line.position, feedback[i].line.position);
+        }
+
+        std::stringstream fullSnapshot, snapshot;
+        ModelSnapshot::write(fullModel, fullSnapshot);
+        ModelSnapshot::write(model, snapshot);
+        EXPECT_TRUE(fullSnapshot.str() == snapshot.str());
+    }
+
+    DictionaryModel::SharedPtr m_dictionaryModel;
+    std::string m_script;
+};
+
+TEST_F(InterpreterCacheTest, build_the_same_model_when_a_scenario_is_edited)
+{
+    InterpreterCache cache;
+    expectSameBuild(m_script, cache);
+    size_t scenarioCount = cache.size();
+    EXPECT_LT(0u, scenarioCount);
+
+    std::string editedScript = m_script;
+    size_t position = editedScript.find("-Rien");
+    ASSERT_NE(std::string::npos, position);
+    editedScript.replace(position, 5, "-Rien du tout");
+    expectSameBuild(editedScript, cache);
+    EXPECT_EQ(scenarioCount, cache.size());
+}
+
+TEST_F(InterpreterCacheTest, shift_the_feedback_of_the_moved_scenarios)
+{
+    InterpreterCache cache;
+    expectSameBuild(m_script, cache);
+
+    // The lines inserted in the first scenario move the following ones.
+    std::string editedScript = m_script;
+    size_t position = editedScript.find("@wait_order");
+    ASSERT_NE(std::string::npos, position);
+    editedScript.insert(position, "    -Bonjour\n        #hello\n    -Bonjour !\n");
+    expectSameBuild(editedScript, cache);
+}
+
+TEST_F(InterpreterCacheTest, compile_again_with_another_dictionary)
+{
+    InterpreterCache cache;
+    expectSameBuild(m_script, cache);
+
+    m_dictionaryModel = std::make_shared<DictionaryModel>();
+    expectSameBuild(m_script, cache);
+}
+
+TEST(ScenarioReaderTest, read_the_scenarios_of_a_stream_one_by_one)
+{
+    std::stringstream script("{\n@root\n\n    -Bonjour\n}\n\nignored\n{\n@end\n}\n{\n@unclosed\n");
+    ScenarioReader reader(script);
+    Scenario scenario;
+
+    ASSERT_TRUE(reader.next(scenario));
+    ASSERT_EQ(2u, scenario.size());
+    EXPECT_EQ("@root", scenario[0].content);
+    EXPECT_EQ(1u, scenario[0].position);
+    EXPECT_EQ("-Bonjour", scenario[1].content);
+    EXPECT_EQ(2u, scenario[1].position);
+
+    ASSERT_TRUE(reader.next(scenario));
+    ASSERT_EQ(1u, scenario.size());
+    EXPECT_EQ("@end", scenario[0].content);
+    EXPECT_EQ(6u, scenario[0].position);
+
+    EXPECT_FALSE(reader.next(scenario));
+}
+
+TEST(InterpreterStreamBuildTest, build_the_same_model_from_a_stream)
+{
+    const intent::test::ResourceManager &resourceManager = intent::test::gTestContext->getResourceManager();
+    std::stringstream ss(resourceManager.getResource(test::ResourceManager::ResourceId::
+                                                     CHATBOT_MODEL_JSON_WITHOUT_INTENT_STORY));
+    Deserializer deserializer;
+    DictionaryModel::SharedPtr dictionaryModel = deserializer.deserialize<DictionaryModel::SharedPtr>(ss);
+
+    std::string script = resourceManager.getResource(test::ResourceManager::ResourceId::INTERPRETER_MODEL_W_ERRORS);
+    InterpreterFeedback feedback;
+    ChatbotModel model = Interpreter::build(script, dictionaryModel, feedback);
+
+    std::stringstream scriptStream(script);
+    InterpreterFeedback streamFeedback;
+    ChatbotModel streamModel = Interpreter::build(scriptStream, dictionaryModel, streamFeedback);
+
+    ASSERT_EQ(feedback.size(), streamFeedback.size());
+    for(size_t i = 0; i < feedback.size(); ++i)
+    {
+        EXPECT_EQ(feedback[i].message, streamFeedback[i].message);
+        EXPECT_EQ(feedback[i].line.position, streamFeedback[i].line.position);
+    }
+
+    std::stringstream snapshot, streamSnapshot;
+    ModelSnapshot::write(model, snapshot);
+    ModelSnapshot::write(streamModel, streamSnapshot);
+    EXPECT_TRUE(snapshot.str() == streamSnapshot.str());
+}
+
 }}
@@ -0,0 +1,120 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <string>
+
+#include "intent/utils/JsonReader.hpp"
+
+namespace intent
+{
+    namespace test
+    {
+        TEST(JsonReaderTest, walk_the_values_of_a_document)
+        {
+            std::stringstream ss(" {\"name\": \"a\\\"b\\u0041\", \"list\": [1, -2.5e3, true, null], \"empty\": {}} ");
+            JsonReader reader(ss);
+            std::string key;
+            std::string value;
+
+            ASSERT_EQ(JsonReader::ValueType::OBJECT, reader.peekValueType());
+            reader.beginObject();
+
+            ASSERT_TRUE(reader.nextKey(key));
+            EXPECT_EQ("name", key);
+            reader.readString(value);
+            EXPECT_EQ("a\"bA", value);
+
+            ASSERT_TRUE(reader.nextKey(key));
+            EXPECT_EQ("list", key);
+            reader.beginArray();
+            ASSERT_TRUE(reader.nextElement());
+            EXPECT_EQ(JsonReader::ValueType::NUMBER, reader.peekValueType());
+            reader.skipValue();
+            ASSERT_TRUE(reader.nextElement());
+            reader.skipValue();
+            ASSERT_TRUE(reader.nextElement());
+            EXPECT_EQ(JsonReader::ValueType::BOOLEAN, reader.peekValueType());
+            reader.skipValue();
+            ASSERT_TRUE(reader.nextElement());
+            EXPECT_EQ(JsonReader::ValueType::NULL_VALUE, reader.peekValueType());
+            reader.skipValue();
+            EXPECT_FALSE(reader.nextElement());
+
+            ASSERT_TRUE(reader.nextKey(key));
+            EXPECT_EQ("empty", key);
+            reader.skipValue();
+
+            EXPECT_FALSE(reader.nextKey(key));
+            EXPECT_NO_THROW(reader.end());
+        }
+
+        TEST(JsonReaderTest, read_strings_across_buffer_refills)
+        {
+            std::string longString(200000, 'x');
+            longString[100000] = 'y';
+            std::stringstream ss("[\"" + longString + "\", \"\\u00e9\"]");
+            JsonReader reader(ss);
+            std::string value;
+
+            reader.beginArray();
+            ASSERT_TRUE(reader.nextElement());
+            reader.readString(value);
+            EXPECT_EQ(longString, value);
+            ASSERT_TRUE(reader.nextElement());
+            reader.readString(value);
+            EXPECT_EQ("\xc3\xa9", value);
+            EXPECT_FALSE(reader.nextElement());
+        }
+
+        TEST(JsonReaderTest, reject_invalid_documents)
+        {
+            for(const std::string document : {"{\"a\" 1}", "[1 2]", "[1,]x", "\"unterminated", "[01a]", "{} {}",
+                                              "[tru]", "\"\\ud800\""})
+            {
+                std::stringstream ss(document);
+                JsonReader reader(ss);
+                EXPECT_THROW(reader.skipValue(); reader.end(), JsonReaderException) << document;
+            }
+        }
+    }
+}
@@ -0,0 +1,121 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+
+#include "intent/utils/Levenshtein.hpp"
+
+namespace intent
+{
+    namespace test
+    {
+        namespace
+        {
+            std::string randomString(std::mt19937& generator, size_t length)
+            {
+                std::uniform_int_distribution<int> letter('a', 'd');
+                std::string s(length, ' ');
+                for(char& c : s) c = static_cast<char>(letter(generator));
+                return s;
+            }
+
+            std::string mutate(std::mt19937& generator, std::string s, int edits)
+            {
+                std::uniform_int_distribution<int> letter('a', 'd');
+                for(int i = 0; i < edits; ++i)
+                {
+                    size_t position = s.empty() ? 0 : generator() % s.size();
+                    switch(generator() % 3)
+                    {
+                        case 0: s.insert(s.begin() + position, static_cast<char>(letter(generator))); break;
+                        case 1: if(!s.empty()) s.erase(s.begin() + position); break;
+                        default: if(!s.empty()) s[position] = static_cast<char>(letter(generator)); break;
+                    }
+                }
+                return s;
+            }
+        }
+
+        TEST(LevenshteinTest, compute_the_full_distance)
+        {
+            EXPECT_EQ(3u, Levenshtein::distance("kitten", "sitting"));
+            EXPECT_EQ(0u, Levenshtein::distance("", ""));
+            EXPECT_EQ(4u, Levenshtein::distance("", "abcd"));
+        }
+
+        TEST(LevenshteinTest, bounded_distance_is_capped)
+        {
+            EXPECT_EQ(3u, Levenshtein::distance("kitten", "sitting", 3));
+            EXPECT_EQ(3u, Levenshtein::distance("kitten", "sitting", 2));
+            EXPECT_EQ(1u, Levenshtein::distance("kitten", "sitting", 0));
+            EXPECT_EQ(0u, Levenshtein::distance("kitten", "kitten", 0));
+            EXPECT_EQ(2u, Levenshtein::distance("", "abcd", 1));
+            EXPECT_EQ(3u, Levenshtein::distance("abc", "", 3));
+        }
+
+        TEST(LevenshteinTest, bounded_distance_matches_the_full_distance)
+        {
+            std::mt19937 generator(3);
+            const size_t lengths[] = {0, 1, 5, 20, 63, 64, 65, 100, 150};
+
+            for(size_t length : lengths)
+            {
+                for(int i = 0; i < 50; ++i)
+                {
+                    std::string s1 = randomString(generator, length);
+                    std::string s2 = mutate(generator, s1, generator() % 5);
+                    unsigned int expected = Levenshtein::distance(s1, s2);
+
+                    for(unsigned int maxDistance = 0; maxDistance < 6; ++maxDistance)
+                    {
+                        ASSERT_EQ(std::min(expected, maxDistance + 1),
+                                  Levenshtein::distance(s1, s2, maxDistance))
+                            << s1 << " / " << s2 << " bounded to " << maxDistance;
+                        ASSERT_EQ(std::min(expected, maxDistance + 1),
+                                  Levenshtein::distance(s2, s1, maxDistance));
+                    }
+                }
+            }
+        }
+    }
+}
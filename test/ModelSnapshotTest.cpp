@@ -0,0 +1,285 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include "launcher/TestContext.hpp"
+
+#include "intent/utils/Deserializer.hpp"
+#include "intent/utils/ModelSnapshot.hpp"
+
+#include <atomic>
+#include <sstream>
+#include <thread>
+
+namespace intent
+{
+    namespace test
+    {
+        using namespace ::testing;
+
+        namespace
+        {
+            ChatbotModel loadChatbotModel()
+            {
+                const intent::test::ResourceManager &resourceManager = intent::test::gTestContext->getResourceManager();
+                std::stringstream ss(resourceManager.getResource(test::ResourceManager::ResourceId::CHATBOT_MODEL_JSON));
+
+                Deserializer deserializer;
+                return deserializer.deserialize<ChatbotModel>(ss);
+            }
+
+            std::string writeSnapshot(const ChatbotModel &chatbotModel)
+            {
+                std::stringstream ss;
+                ModelSnapshot::write(chatbotModel, ss);
+                return ss.str();
+            }
+
+            void expectSnapshotError(const std::string &snapshot)
+            {
+                EXPECT_THROW(ModelSnapshot::read(snapshot.data(), snapshot.size()), ModelSnapshotException);
+            }
+        }
+
+        TEST(ModelSnapshotTest, restore_the_model_written)
+        {
+            ChatbotModel chatbotModel = loadChatbotModel();
+            std::string snapshot = writeSnapshot(chatbotModel);
+            ChatbotModel restoredModel = ModelSnapshot::read(snapshot.data(), snapshot.size());
+
+            const IntentServiceModel &intentServiceModel = chatbotModel.intentStoryServiceModel.intentServiceModel;
+            const IntentServiceModel &restoredServiceModel = restoredModel.intentStoryServiceModel.intentServiceModel;
+
+            const DictionaryModel &dictionaryModel = *intentServiceModel.dictionaryModel;
+            const DictionaryModel &restoredDictionary = *restoredServiceModel.dictionaryModel;
+            EXPECT_EQ(dictionaryModel.entitiesByEntityId, restoredDictionary.entitiesByEntityId);
+            ASSERT_EQ(dictionaryModel.regexes.size(), restoredDictionary.regexes.size());
+            for(size_t i = 0; i < dictionaryModel.regexes.size(); ++i)
+            {
+                EXPECT_EQ(dictionaryModel.regexes[i].pattern, restoredDictionary.regexes[i].pattern);
+                EXPECT_EQ(dictionaryModel.regexes[i].entityId, restoredDictionary.regexes[i].entityId);
+            }
+            EXPECT_EQ(dictionaryModel.dictionary.size(), restoredDictionary.dictionary.size());
+            EXPECT_EQ(dictionaryModel.dictionary.index_size(), restoredDictionary.dictionary.index_size());
+            for(int termId = 0; termId < static_cast<int>(dictionaryModel.dictionary.size()) - 3; ++termId)
+            {
+                EXPECT_EQ(dictionaryModel.dictionary.findTerm(termId), restoredDictionary.dictionary.findTerm(termId));
+            }
+
+            // Both the phrase trie and the trigram index are usable as they are read.
+            int tokensPopped = 0;
+            EXPECT_EQ(dictionaryModel.dictionary.findTerm("coca", std::vector<std::string>({"coca"}), tokensPopped),
+                      restoredDictionary.dictionary.findTerm("coca", std::vector<std::string>({"coca"}),
+                                                             tokensPopped));
+            EXPECT_EQ(dictionaryModel.dictionary.findTerm("koka", std::vector<std::string>({"koka"}), tokensPopped),
+                      restoredDictionary.dictionary.findTerm("koka", std::vector<std::string>({"koka"}),
+                                                             tokensPopped));
+
+            const IntentModel::IntentIndex &intents = intentServiceModel.intentModel->intentsByIntentId;
+            const IntentModel::IntentIndex &restoredIntents = restoredServiceModel.intentModel->intentsByIntentId;
+            ASSERT_EQ(intents.size(), restoredIntents.size());
+            for(const IntentModel::IntentIndex::value_type &intent : intents)
+            {
+                const IntentModel::Intent &restoredIntent = restoredIntents.at(intent.first);
+                EXPECT_EQ(intent.second.entities, restoredIntent.entities);
+                EXPECT_EQ(intent.second.entityToVariableNames, restoredIntent.entityToVariableNames);
+                EXPECT_EQ(intent.second.example, restoredIntent.example);
+            }
+
+            const IntentStoryModel &story = *chatbotModel.intentStoryServiceModel.intentStoryModel;
+            const IntentStoryModel &restoredStory = *restoredModel.intentStoryServiceModel.intentStoryModel;
+            EXPECT_EQ(story.rootStateId, restoredStory.rootStateId);
+            ASSERT_EQ(story.graph.vertexCount(), restoredStory.graph.vertexCount());
+            EXPECT_EQ(story.graph.edgeCount(), restoredStory.graph.edgeCount());
+            for(const IntentStoryModel::VertexByStateIdIndex::value_type &vertex : story.vertexByStateId)
+            {
+                const IntentStoryModel::StoryGraph::Vertex &restoredVertex = restoredStory.vertexByStateId.at(vertex.first);
+                EXPECT_EQ(vertex.second.getVertex(), restoredVertex.getVertex());
+
+                IntentStoryModel::StoryGraph::Edges edges = story.graph.nextEdges(vertex.second);
+                IntentStoryModel::StoryGraph::Edges restoredEdges = restoredStory.graph.nextEdges(restoredVertex);
+                ASSERT_EQ(edges.size(), restoredEdges.size());
+                for(size_t i = 0; i < edges.size(); ++i)
+                {
+                    EXPECT_EQ(edges[i].getTarget().getVertex(), restoredEdges[i].getTarget().getVertex());
+                    EXPECT_EQ(edges[i].getInfo().intent.intentId, restoredEdges[i].getInfo().intent.intentId);
+                    EXPECT_EQ(edges[i].getInfo().actionId, restoredEdges[i].getInfo().actionId);
+                }
+            }
+
+            const ChatbotActionModel &actions = *chatbotModel.chatbotActionModel;
+            const ChatbotActionModel &restoredActions = *restoredModel.chatbotActionModel;
+            EXPECT_EQ(actions.replyContentByReplyIdIndex, restoredActions.replyContentByReplyIdIndex);
+            ASSERT_EQ(actions.replyIdsByStateAndActionId.size(), restoredActions.replyIdsByStateAndActionId.size());
+            for(const ChatbotActionModel::ReplyIdsByStateAndActionIdIndex::value_type &replyIds :
+                actions.replyIdsByStateAndActionId)
+            {
+                EXPECT_EQ(replyIds.second, restoredActions.replyIdsByStateAndActionId.at(replyIds.first));
+            }
+        }
+
+        TEST(ModelSnapshotTest, reject_an_invalid_snapshot)
+        {
+            std::string snapshot = writeSnapshot(loadChatbotModel());
+
+            expectSnapshotError("");
+            expectSnapshotError(snapshot.substr(0, snapshot.size() - 1));
+            expectSnapshotError(snapshot + "x");
+
+            std::string corrupted = snapshot;
+            corrupted[corrupted.size() / 2] ^= 0x40;
+            EXPECT_THROW(ModelSnapshot::read(corrupted.data(), corrupted.size(), ModelSnapshot::CHECKSUM),
+                         ModelSnapshotException);
+
+            std::string otherVersion = snapshot;
+            otherVersion[8] = static_cast<char>(ModelSnapshot::VERSION + 1);
+            expectSnapshotError(otherVersion);
+
+            std::string notASnapshot = snapshot;
+            notASnapshot[0] = '{';
+            expectSnapshotError(notASnapshot);
+        }
+
+        TEST(ModelSnapshotTest, verify_the_checksum_on_demand)
+        {
+            std::string snapshot = writeSnapshot(loadChatbotModel());
+            size_t position = snapshot.find("Quoi ?");
+            ASSERT_NE(std::string::npos, position);
+            snapshot[position] = 'q';
+
+            ChatbotModel restoredModel = ModelSnapshot::read(snapshot.data(), snapshot.size());
+            EXPECT_EQ("quoi ?", restoredModel.chatbotActionModel->replyContentByReplyIdIndex.at("what_else_reply"));
+            EXPECT_THROW(ModelSnapshot::read(snapshot.data(), snapshot.size(), ModelSnapshot::CHECKSUM),
+                         ModelSnapshotException);
+        }
+
+        TEST(ModelSnapshotTest, reject_an_unfrozen_story_graph)
+        {
+            ChatbotModel chatbotModel = loadChatbotModel();
+            IntentStoryModel &story = *chatbotModel.intentStoryServiceModel.intentStoryModel;
+            IntentStoryModel::StoryGraph::Vertex root = story.vertexByStateId.at(story.rootStateId);
+            story.graph.addEdge(root, root, IntentStoryModel::EdgeInfo());
+
+            EXPECT_THROW(writeSnapshot(chatbotModel), ModelSnapshotException);
+
+            story.graph.freeze();
+            EXPECT_NO_THROW(writeSnapshot(chatbotModel));
+        }
+
+        TEST(ModelSnapshotTest, reject_an_unexisting_file)
+        {
+            EXPECT_THROW(ModelSnapshot::load("unexisting_file.snapshot"), ModelSnapshotException);
+        }
+   
+        TEST(ModelSnapshotTest, attach_a_model_in_shared_memory)
+        {
+            const std::string segmentName = "intent-model-snapshot-test";
+            ChatbotModel chatbotModel = loadChatbotModel();
+            ModelSnapshot::createSharedMemory(chatbotModel, segmentName);
+            ChatbotModel attachedModel = ModelSnapshot::attachSharedMemory(segmentName);
+            // The model stays usable once the segment is removed.
+            EXPECT_TRUE(ModelSnapshot::removeSharedMemory(segmentName));
+            EXPECT_THROW(ModelSnapshot::attachSharedMemory(segmentName), ModelSnapshotException);
+
+            const TermIndex &dictionary =
+                chatbotModel.intentStoryServiceModel.intentServiceModel.dictionaryModel->dictionary;
+            TermIndex attachedDictionary =
+                attachedModel.intentStoryServiceModel.intentServiceModel.dictionaryModel->dictionary;
+            ASSERT_EQ(dictionary.size(), attachedDictionary.size());
+            for(int termId = 0; termId < static_cast<int>(dictionary.size()) - 3; ++termId)
+            {
+                EXPECT_EQ(dictionary.findTerm(termId), attachedDictionary.findTerm(termId));
+            }
+            int tokensPopped = 0;
+            EXPECT_EQ(dictionary.findTerm("koka", std::vector<std::string>({"koka"}), tokensPopped),
+                      attachedDictionary.findTerm("koka", std::vector<std::string>({"koka"}), tokensPopped));
+
+            // A term pushed into the copy of an attached dictionary is indexed with the mapped ones.
+            Term term;
+            term.term = "Orangina";
+            term.termId = 1000;
+            term.entityId = dictionary.findTerm("coca").entityId;
+            attachedDictionary.pushTerm(term);
+            EXPECT_EQ("orangina", attachedDictionary.findTerm("oranjina").lowerCaseTerm);
+            EXPECT_EQ(dictionary.findTerm("koka"), attachedDictionary.findTerm("koka"));
+            EXPECT_EQ(dictionary.size() + 1, attachedDictionary.size());
+        }
+
+        TEST(ModelSnapshotTest, attach_a_segment_being_replaced)
+        {
+            const std::string segmentName = "intent-model-snapshot-replaced-test";
+            ChatbotModel chatbotModel = loadChatbotModel();
+            const size_t dictionarySize =
+                chatbotModel.intentStoryServiceModel.intentServiceModel.dictionaryModel->dictionary.size();
+            ModelSnapshot::createSharedMemory(chatbotModel, segmentName);
+
+            std::atomic<bool> replacing(true);
+            std::thread writer([&]()
+            {
+                while(replacing)
+                {
+                    ModelSnapshot::createSharedMemory(chatbotModel, segmentName);
+                }
+            });
+
+            int failures = 0;
+            for(int i = 0; i < 200; ++i)
+            {
+                try
+                {
+                    ChatbotModel attachedModel = ModelSnapshot::attachSharedMemory(segmentName);
+                    EXPECT_EQ(dictionarySize,
+                              attachedModel.intentStoryServiceModel.intentServiceModel.dictionaryModel->dictionary.size());
+                }
+                catch(const ModelSnapshotException &)
+                {
+                    ++failures;
+                }
+            }
+            replacing = false;
+            writer.join();
+
+            EXPECT_EQ(0, failures);
+            EXPECT_TRUE(ModelSnapshot::removeSharedMemory(segmentName));
+        }
+    }
+}
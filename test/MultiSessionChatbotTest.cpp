@@ -52,6 +52,8 @@ CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 
 #include "mock/ChatbotMock.hpp"
 
+#include <thread>
+
 
 #define EXPECT_EQ_SIGNED(v1, v2) EXPECT_EQ(v1, static_cast<int>(v2))
 #define ASSERT_EQ_SIGNED(v1, v2) ASSERT_EQ(v1, static_cast<int>(v2))
@@ -126,5 +128,46 @@ namespace intent
             chatbot.addSession("sess3");
             EXPECT_EQ_SIGNED(1, chatbot.sessionCount());
         }
+
+        TEST_F(OrderMultiSessionChatbotTest, treat_messages_of_sessions_from_several_threads)
+        {
+            typedef MultiSessionChatbot<std::string> MyChatbot;
+
+            MyChatbot::UserDefinedActionHandler::SharedPtr userDefinedActionHandler(
+                    new NiceMock<MultiSessionUserDefinedCommandMock >());
+
+            MyChatbot chatbot(m_chatbotModel, userDefinedActionHandler);
+
+            chatbot.addSession("serial");
+            const std::vector<std::string> firstReplies = chatbot.treatMessage("serial", "Bob!");
+            const std::vector<std::string> secondReplies = chatbot.treatMessage("serial", "Je voudrais une Kro");
+            chatbot.removeSession("serial");
+            ASSERT_THAT(firstReplies, ElementsAre("Que puis-je vous offrir ?"));
+            ASSERT_THAT(secondReplies, Not(IsEmpty()));
+
+            const int threadCount = 4;
+            const int sessionsPerThread = 50;
+            std::vector<std::thread> threads;
+            std::vector<int> wrongReplies(threadCount, 0);
+            for(int t = 0; t < threadCount; ++t)
+            {
+                threads.push_back(std::thread([&, t]()
+                {
+                    for(int i = 0; i < sessionsPerThread; ++i)
+                    {
+                        std::string sessionId = "sess" + std::to_string(t * sessionsPerThread + i);
+                        chatbot.addSession(sessionId);
+                        if(chatbot.treatMessage(sessionId, "Bob!") != firstReplies)
+                            ++wrongReplies[t];
+                        if(chatbot.treatMessage(sessionId, "Je voudrais une Kro") != secondReplies)
+                            ++wrongReplies[t];
+                    }
+                }));
+            }
+            for(std::thread& thread : threads) thread.join();
+
+            EXPECT_THAT(wrongReplies, Each(0));
+            EXPECT_EQ_SIGNED(threadCount * sessionsPerThread, chatbot.sessionCount());
+        }
     }
 }
@@ -0,0 +1,143 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <gtest/gtest.h>
+
+#include "intent/intent_service/PhraseTrie.hpp"
+
+namespace intent
+{
+    namespace test
+    {
+        namespace
+        {
+            std::vector<PhraseTrie::Word> words(const std::vector<std::string>& tokens)
+            {
+                return std::vector<PhraseTrie::Word>(tokens.begin(), tokens.end());
+            }
+        }
+
+        TEST(PhraseTrieTest, find_the_longest_phrase)
+        {
+            PhraseTrie trie;
+            trie.insert("eau", 0);
+            trie.insert("eau de vie", 1);
+            trie.insert("eau de zilia", 2);
+            trie.pack();
+
+            std::vector<std::string> tokens({"eau", "de", "vie", "please"});
+            std::vector<PhraseTrie::Word> sentence = words(tokens);
+
+            int value = -1;
+            EXPECT_EQ(3u, trie.longestMatch(sentence.begin(), sentence.end(), value));
+            EXPECT_EQ(1, value);
+
+            EXPECT_EQ(1u, trie.longestMatch(sentence.begin(), sentence.begin() + 2, value));
+            EXPECT_EQ(0, value);
+            EXPECT_EQ(3u, trie.size());
+        }
+
+        TEST(PhraseTrieTest, compare_the_words_case_insensitively)
+        {
+            PhraseTrie trie;
+            trie.insert("boisson non alcoolisee", 4);
+            trie.pack();
+
+            std::vector<std::string> tokens({"Boisson", "NON", "alcoolisee"});
+            std::vector<PhraseTrie::Word> sentence = words(tokens);
+
+            int value = -1;
+            EXPECT_EQ(3u, trie.longestMatch(sentence.begin(), sentence.end(), value));
+            EXPECT_EQ(4, value);
+        }
+
+        TEST(PhraseTrieTest, do_not_match_the_prefix_of_a_phrase)
+        {
+            PhraseTrie trie;
+            trie.insert("eau de vie", 1);
+            trie.pack();
+
+            std::vector<std::string> tokens({"eau", "de", "zilia"});
+            std::vector<PhraseTrie::Word> sentence = words(tokens);
+
+            int value = -1;
+            EXPECT_EQ(0u, trie.longestMatch(sentence.begin(), sentence.end(), value));
+            EXPECT_EQ(-1, value);
+        }
+
+        TEST(PhraseTrieTest, replace_the_value_of_a_phrase)
+        {
+            PhraseTrie trie;
+            trie.insert("coca", 1);
+            trie.insert("coca", 2);
+            trie.pack();
+
+            std::vector<std::string> tokens({"coca"});
+            std::vector<PhraseTrie::Word> sentence = words(tokens);
+
+            int value = -1;
+            EXPECT_EQ(1u, trie.longestMatch(sentence.begin(), sentence.end(), value));
+            EXPECT_EQ(2, value);
+            EXPECT_EQ(1u, trie.size());
+        }
+
+        TEST(PhraseTrieTest, find_the_phrases_inserted_after_a_pack)
+        {
+            PhraseTrie trie;
+            for(int i = 0; i < 100; ++i) trie.insert("word" + std::to_string(99 - i), i);
+            trie.pack();
+            trie.insert("word50 bis", 100);
+            trie.insert("aaa", 101);
+            trie.pack();
+
+            std::vector<std::string> tokens({"word50", "bis", "aaa", "word7"});
+            std::vector<PhraseTrie::Word> sentence = words(tokens);
+
+            int value = -1;
+            EXPECT_EQ(2u, trie.longestMatch(sentence.begin(), sentence.end(), value));
+            EXPECT_EQ(100, value);
+            EXPECT_EQ(1u, trie.longestMatch(sentence.begin() + 2, sentence.end(), value));
+            EXPECT_EQ(101, value);
+            EXPECT_EQ(1u, trie.longestMatch(sentence.begin() + 3, sentence.end(), value));
+            EXPECT_EQ(92, value);
+            EXPECT_EQ(102u, trie.size());
+        }
+    }
+}
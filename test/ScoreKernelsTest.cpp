@@ -0,0 +1,96 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <algorithm>
+#include <random>
+
+#include "intent/utils/ScoreKernels.hpp"
+
+using namespace ::testing;
+
+namespace intent
+{
+    namespace test
+    {
+        TEST(ScoreKernelsTest, max_of_empty_scores_is_zero)
+        {
+            EXPECT_EQ(0, ScoreKernels::max(NULL, 0));
+        }
+
+        TEST(ScoreKernelsTest, find_max_and_ties)
+        {
+            std::vector<int32_t> scores = {1, 3, 0, 2, 3, 1, 1};
+
+            EXPECT_EQ(3, ScoreKernels::max(scores.data(), scores.size()));
+
+            std::vector<uint32_t> positions;
+            ScoreKernels::findEqual(scores.data(), scores.size(), 3, positions);
+            EXPECT_THAT(positions, ElementsAre(1, 4));
+
+            positions.clear();
+            ScoreKernels::findEqual(scores.data(), scores.size(), 1, positions);
+            EXPECT_THAT(positions, ElementsAre(0, 5, 6));
+        }
+
+        TEST(ScoreKernelsTest, match_the_scalar_implementation)
+        {
+            std::mt19937 generator(7);
+            std::uniform_int_distribution<int32_t> score(0, 20);
+
+            for(size_t size = 0; size < 67; ++size)
+            {
+                std::vector<int32_t> scores(size);
+                std::generate(scores.begin(), scores.end(), [&]() { return score(generator); });
+
+                int32_t expectedMax = scores.empty() ? 0 : *std::max_element(scores.begin(), scores.end());
+                ASSERT_EQ(expectedMax, ScoreKernels::max(scores.data(), scores.size()));
+
+                std::vector<uint32_t> expectedPositions, positions;
+                for(size_t i = 0; i < size; ++i)
+                    if(scores[i] == expectedMax) expectedPositions.push_back(i);
+                ScoreKernels::findEqual(scores.data(), scores.size(), expectedMax, positions);
+                ASSERT_EQ(expectedPositions, positions);
+            }
+        }
+    }
+}
@@ -0,0 +1,232 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <exception>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "launcher/TestContext.hpp"
+
+#include "json.hpp"
+
+#include "intent/utils/Deserializer.hpp"
+#include "intent/chatbot/SessionScheduler.hpp"
+
+#include "mock/ChatbotMock.hpp"
+
+using namespace ::testing;
+
+namespace intent
+{
+    namespace test
+    {
+        class SessionSchedulerTest : public ::testing::Test
+        {
+        public:
+            typedef MultiSessionChatbot<std::string> MyChatbot;
+            typedef SessionScheduler<std::string> MyScheduler;
+
+            void SetUp()
+            {
+                const intent::test::ResourceManager &resourceManager = intent::test::gTestContext->getResourceManager();
+
+                std::string jsonContent = resourceManager.getResource(
+                        test::ResourceManager::ResourceId::CHATBOT_MODEL_JSON);
+
+                nlohmann::json json = nlohmann::json::parse(jsonContent);
+
+                Deserializer deserializer;
+                ChatbotModel chatbotModel = deserializer.deserialize<ChatbotModel>(json);
+
+                m_actionHandler = new NiceMock<MultiSessionUserDefinedCommandMock>();
+                m_chatbot.reset(new MyChatbot(chatbotModel, MyChatbot::UserDefinedActionHandler::SharedPtr(m_actionHandler)));
+
+                // The replies of a session receiving both messages in order.
+                m_chatbot->addSession("serial");
+                m_firstReplies = m_chatbot->treatMessage("serial", "Bob!");
+                m_secondReplies = m_chatbot->treatMessage("serial", "Je voudrais une Kro");
+                m_chatbot->removeSession("serial");
+            }
+
+            NiceMock<MultiSessionUserDefinedCommandMock> *m_actionHandler;
+            MyChatbot::SharedPtr m_chatbot;
+            std::vector<std::string> m_firstReplies;
+            std::vector<std::string> m_secondReplies;
+        };
+
+        TEST_F(SessionSchedulerTest, treat_the_messages_of_a_session_in_order)
+        {
+            ASSERT_THAT(m_firstReplies, ElementsAre("Que puis-je vous offrir ?"));
+            ASSERT_THAT(m_secondReplies, Not(IsEmpty()));
+
+            const int sessionCount = 200;
+            for(int i = 0; i < sessionCount; ++i)
+                m_chatbot->addSession("sess" + std::to_string(i));
+
+            MyScheduler scheduler(m_chatbot, 4);
+            EXPECT_EQ(4u, scheduler.workerCount());
+
+            std::vector<std::future<MyScheduler::Replies>> firstReplies;
+            std::vector<std::future<MyScheduler::Replies>> secondReplies;
+            for(int i = 0; i < sessionCount; ++i)
+                firstReplies.push_back(scheduler.submit("sess" + std::to_string(i), "Bob!"));
+            for(int i = 0; i < sessionCount; ++i)
+                secondReplies.push_back(scheduler.submit("sess" + std::to_string(i), "Je voudrais une Kro"));
+
+            int wrongReplies = 0;
+            for(int i = 0; i < sessionCount; ++i)
+            {
+                if(firstReplies[i].get() != m_firstReplies) ++wrongReplies;
+                if(secondReplies[i].get() != m_secondReplies) ++wrongReplies;
+            }
+            EXPECT_EQ(0, wrongReplies);
+        }
+
+        TEST_F(SessionSchedulerTest, call_back_with_the_replies_of_messages_submitted_from_several_threads)
+        {
+            MyScheduler scheduler(m_chatbot, 3);
+
+            const int threadCount = 4;
+            const int sessionsPerThread = 50;
+            std::atomic<int> wrongReplies(0);
+            std::vector<std::thread> threads;
+            for(int t = 0; t < threadCount; ++t)
+            {
+                threads.push_back(std::thread([&, t]()
+                {
+                    for(int i = 0; i < sessionsPerThread; ++i)
+                    {
+                        std::string sessionId = "sess" + std::to_string(t * sessionsPerThread + i);
+                        m_chatbot->addSession(sessionId);
+                        scheduler.submit(sessionId, "Bob!", [&](const MyScheduler::Replies &replies, std::exception_ptr error)
+                        {
+                            if(error || replies != m_firstReplies) ++wrongReplies;
+                        });
+                        scheduler.submit(sessionId, "Je voudrais une Kro", [&](const MyScheduler::Replies &replies, std::exception_ptr error)
+                        {
+                            if(error || replies != m_secondReplies) ++wrongReplies;
+                        });
+                    }
+                }));
+            }
+            for(std::thread &thread : threads) thread.join();
+            scheduler.flush();
+
+            EXPECT_EQ(0, wrongReplies.load());
+            EXPECT_EQ(2u * threadCount * sessionsPerThread, scheduler.treatedMessages());
+            EXPECT_EQ(0u, scheduler.queueDepth());
+        }
+
+        TEST_F(SessionSchedulerTest, route_a_session_to_a_single_worker_and_report_the_queue_depths)
+        {
+            MyScheduler scheduler(m_chatbot, 2);
+            m_chatbot->addSession("sess");
+            const size_t worker = scheduler.workerOf("sess");
+            ASSERT_LT(worker, 2u);
+
+            // The worker is kept busy until the other messages are queued.
+            std::promise<void> release;
+            std::shared_future<void> released = release.get_future().share();
+            scheduler.submit("sess", "Bob!", [released](const MyScheduler::Replies &, std::exception_ptr)
+            {
+                released.wait();
+            });
+            while(scheduler.queueDepth(worker) != 0) std::this_thread::yield();
+
+            scheduler.submit("sess", "Je voudrais une Kro", MyScheduler::ReplyCallback());
+            scheduler.submit("unknown", "Bob!", MyScheduler::ReplyCallback());
+            EXPECT_EQ(scheduler.workerOf("unknown") == worker ? 2u : 1u, scheduler.queueDepth(worker));
+            EXPECT_EQ(2u, scheduler.queueDepth());
+
+            release.set_value();
+            scheduler.flush();
+            EXPECT_EQ(0u, scheduler.queueDepth());
+            EXPECT_EQ(3u, scheduler.treatedMessages());
+        }
+
+        TEST_F(SessionSchedulerTest, pass_the_exception_of_a_message_to_its_future)
+        {
+            ON_CALL(*m_actionHandler, execute(_, _, _, _))
+                    .WillByDefault(Throw(std::runtime_error("unavailable")));
+            m_chatbot->addSession("sess");
+
+            MyScheduler scheduler(m_chatbot, 1);
+            std::future<MyScheduler::Replies> replies = scheduler.submit("sess", "Bob!");
+            EXPECT_THROW(replies.get(), std::runtime_error);
+
+            // The worker keeps treating the next messages.
+            scheduler.submit("sess", "Bob!", MyScheduler::ReplyCallback());
+            EXPECT_THAT(scheduler.submit("unknown", "Bob!").get(), IsEmpty());
+        }
+
+        TEST_F(SessionSchedulerTest, pass_the_exception_of_a_message_to_its_callback)
+        {
+            ON_CALL(*m_actionHandler, execute(_, _, _, _))
+                    .WillByDefault(Throw(std::runtime_error("unavailable")));
+            m_chatbot->addSession("sess");
+
+            MyScheduler scheduler(m_chatbot, 1);
+            std::promise<std::exception_ptr> failure;
+            scheduler.submit("sess", "Bob!", [&failure](const MyScheduler::Replies &replies, std::exception_ptr error)
+            {
+                EXPECT_THAT(replies, IsEmpty());
+                failure.set_value(error);
+            });
+            std::exception_ptr thrown = failure.get_future().get();
+            ASSERT_TRUE(static_cast<bool>(thrown));
+            EXPECT_THROW(std::rethrow_exception(thrown), std::runtime_error);
+
+            // A message treated successfully is called back without error.
+            std::promise<std::exception_ptr> success;
+            scheduler.submit("unknown", "Bob!", [&success](const MyScheduler::Replies &, std::exception_ptr error)
+            {
+                success.set_value(error);
+            });
+            EXPECT_FALSE(static_cast<bool>(success.get_future().get()));
+        }
+    }
+}
@@ -0,0 +1,212 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "intent/chatbot/SessionStore.hpp"
+
+using namespace ::testing;
+
+namespace intent
+{
+    namespace test
+    {
+        TEST(SessionStoreTest, insert_find_update_and_erase_sessions)
+        {
+            SessionStore<std::string, int> store(4);
+            int value = 0;
+
+            EXPECT_TRUE(store.insert("sess1", 1));
+            EXPECT_FALSE(store.insert("sess1", 2));
+            EXPECT_TRUE(store.insert("sess2", 3));
+            EXPECT_EQ(2u, store.size());
+
+            ASSERT_TRUE(store.find("sess1", value));
+            EXPECT_EQ(1, value);
+            EXPECT_FALSE(store.find("sess3", value));
+
+            EXPECT_TRUE(store.update("sess2", 4));
+            ASSERT_TRUE(store.find("sess2", value));
+            EXPECT_EQ(4, value);
+
+            EXPECT_TRUE(store.erase("sess2"));
+            EXPECT_FALSE(store.erase("sess2"));
+            EXPECT_FALSE(store.update("sess2", 5));
+            EXPECT_FALSE(store.find("sess2", value));
+            EXPECT_EQ(1u, store.size());
+        }
+
+        TEST(SessionStoreTest, use_sessions_from_several_threads)
+        {
+            const int threadCount = 4;
+            const int sessionsPerThread = 1000;
+            SessionStore<int, int> store;
+
+            std::vector<std::thread> threads;
+            for(int t = 0; t < threadCount; ++t)
+            {
+                threads.push_back(std::thread([&store, t]()
+                {
+                    for(int i = 0; i < sessionsPerThread; ++i)
+                    {
+                        int session = t * sessionsPerThread + i;
+                        store.insert(session, 0);
+                        for(int step = 1; step <= 10; ++step)
+                        {
+                            int value = -1;
+                            if(store.find(session, value)) store.update(session, value + 1);
+                        }
+                        if(i % 2 == 0) store.erase(session);
+                    }
+                }));
+            }
+            for(std::thread& thread : threads) thread.join();
+
+            EXPECT_EQ(static_cast<size_t>(threadCount * sessionsPerThread / 2), store.size());
+            for(int session = 1; session < threadCount * sessionsPerThread; session += 2)
+            {
+                int value = -1;
+                ASSERT_TRUE(store.find(session, value));
+                EXPECT_EQ(10, value);
+            }
+        }
+
+        TEST(SessionStoreTest, keep_every_session_when_growing_and_removing)
+        {
+            SessionStore<int, int> store(1);
+
+            for(int session = 0; session < 10000; ++session)
+                ASSERT_TRUE(store.insert(session, session * 2));
+            for(int session = 0; session < 10000; session += 3)
+                ASSERT_TRUE(store.erase(session));
+
+            EXPECT_EQ(6666u, store.size());
+            for(int session = 0; session < 10000; ++session)
+            {
+                int value = -1;
+                if(session % 3 == 0)
+                {
+                    EXPECT_FALSE(store.find(session, value));
+                }
+                else
+                {
+                    ASSERT_TRUE(store.find(session, value));
+                    EXPECT_EQ(session * 2, value);
+                }
+            }
+        }
+
+        class SessionStoreEvictionTest : public ::testing::Test
+        {
+        public:
+            typedef SessionStore<std::string, int> Store;
+            typedef std::pair<std::string, Store::EvictionReason> Eviction;
+
+            Store::Options options()
+            {
+                Store::Options options;
+                options.shardCount = 1;
+                options.evictionCallback = [this](const std::string &key, const int &, Store::EvictionReason reason)
+                {
+                    m_evictions.push_back(Eviction(key, reason));
+                };
+                options.clock = [this]() { return m_now; };
+                return options;
+            }
+
+            std::chrono::steady_clock::time_point m_now;
+            std::vector<Eviction> m_evictions;
+        };
+
+        TEST_F(SessionStoreEvictionTest, remove_the_idle_sessions)
+        {
+            Store::Options storeOptions = options();
+            storeOptions.idleTimeout = std::chrono::seconds(10);
+            Store store(storeOptions);
+            int value = 0;
+
+            store.insert("sess1", 1);
+            store.insert("sess2", 2);
+            m_now += std::chrono::seconds(5);
+            ASSERT_TRUE(store.find("sess1", value));
+
+            m_now += std::chrono::seconds(6);
+            EXPECT_EQ(1u, store.expire());
+            EXPECT_THAT(m_evictions, ElementsAre(Eviction("sess2", Store::EvictionReason::IDLE_TIMEOUT)));
+            EXPECT_FALSE(store.find("sess2", value));
+
+            m_now += std::chrono::seconds(10);
+            EXPECT_FALSE(store.find("sess1", value));
+            EXPECT_EQ(2u, m_evictions.size());
+            EXPECT_EQ(0u, store.size());
+        }
+
+        TEST_F(SessionStoreEvictionTest, evict_the_least_recently_used_sessions_at_the_memory_cap)
+        {
+            Store::Options storeOptions = options();
+            storeOptions.maxBytes = 10 * Store::recordSize();
+            Store store(storeOptions);
+            int value = 0;
+
+            for(int session = 0; session < 8; ++session)
+                ASSERT_TRUE(store.insert("sess" + std::to_string(session), session));
+            ASSERT_TRUE(store.find("sess0", value));
+            EXPECT_TRUE(store.update("sess1", 1));
+            EXPECT_TRUE(m_evictions.empty());
+
+            ASSERT_TRUE(store.insert("sess8", 8));
+            ASSERT_TRUE(store.insert("sess9", 9));
+
+            EXPECT_THAT(m_evictions, ElementsAre(Eviction("sess2", Store::EvictionReason::MEMORY_CAP),
+                                                 Eviction("sess3", Store::EvictionReason::MEMORY_CAP)));
+            EXPECT_EQ(8u, store.size());
+            EXPECT_TRUE(store.find("sess0", value));
+            EXPECT_TRUE(store.find("sess1", value));
+            EXPECT_LE(store.recordBytes(), storeOptions.maxBytes);
+        }
+    }
+}
@@ -201,3 +201,67 @@ TEST(TermIndexTest, test_recognize_multi_words_even_if_greedy_perfect_match)
     EXPECT_EQ(1, termIndex.findTerm("eau", std::vector<std::string>({"eau", "de", "zilia"}), tokensPopped).termId);
     EXPECT_EQ(3, tokensPopped);
 }
+
+TEST(TermIndexTest, find_exact_terms_with_longest_match_in_one_scan)
+{
+    Term eau, eauDeZilia, invalid;
+    eau.term = "Eau";
+    eau.entityId = 1;
+    eau.termId = 0;
+
+    eauDeZilia.term = "eau de zilia";
+    eauDeZilia.alias.push_back("zilia");
+    eauDeZilia.entityId = 2;
+    eauDeZilia.termId = 1;
+
+    invalid.term = "et";
+    invalid.termId = 2;
+
+    TermIndex termIndex;
+    termIndex.pushTerm(eau);
+    termIndex.pushTerm(eauDeZilia);
+    termIndex.pushTerm(invalid);
+
+    std::vector<std::string> sentence({"EAU", "de", "zilia", "et", "eau", "zilia"});
+    TermIndex::TokenViews tokens(sentence.begin(), sentence.end());
+    TermIndex::PhraseMatches matches;
+    termIndex.findExactTerms(tokens.begin(), tokens.end(), matches);
+
+    ASSERT_EQ(3u, matches.size());
+    EXPECT_EQ(0u, matches[0].position);
+    EXPECT_EQ(3u, matches[0].length);
+    EXPECT_EQ(1, matches[0].termId);
+    EXPECT_EQ(2, matches[0].entityId);
+    EXPECT_EQ(4u, matches[1].position);
+    EXPECT_EQ(1u, matches[1].length);
+    EXPECT_EQ(0, matches[1].termId);
+    EXPECT_EQ(5u, matches[2].position);
+    EXPECT_EQ(1, matches[2].termId);
+}
+
+TEST(TermIndexTest, push_terms_after_a_lookup)
+{
+    Term coca, fanta;
+    coca.term = "Coca";
+    coca.entityId = 1;
+    coca.termId = 3;
+
+    fanta.term = "Fanta";
+    fanta.entityId = 1;
+    fanta.termId = 1;
+
+    TermIndex termIndex;
+    termIndex.pushTerm(coca);
+    EXPECT_EQ(3, termIndex.findTerm("coca").termId);
+
+    termIndex.pushTerm(fanta);
+    EXPECT_EQ(3, termIndex.findTerm("coca").termId);
+    EXPECT_EQ(1, termIndex.findTerm("fanta").termId);
+
+    TermIndex copiedIndex(termIndex);
+    std::set<int> termsSet;
+    copiedIndex.getTermSet("nta", termsSet);
+    EXPECT_THAT(termsSet, ElementsAre(1));
+    copiedIndex.getTermSet(" co", termsSet);
+    EXPECT_THAT(termsSet, ElementsAre(3));
+}
@@ -0,0 +1,95 @@
+/*
+|---------------------------------------------------------|
+|    ___                   ___       _             _      |
+|   / _ \ _ __   ___ _ __ |_ _|_ __ | |_ ___ _ __ | |_    |
+|  | | | | '_ \ / _ \ '_ \ | || '_ \| __/ _ \ '_ \| __|   |
+|  | |_| | |_) |  __/ | | || || | | | ||  __/ | | | |_    |
+|   \___/| .__/ \___|_| |_|___|_| |_|\__\___|_| |_|\__|   |
+|        |_|                                              |
+|                                                         |
+|     - The users first...                                |
+|                                                         |
+|     Authors:                                            |
+|        - Clement Michaud                                |
+|        - Sergei Kireev                                  |
+|                                                         |
+|     Version: 1.0.0                                      |
+|                                                         |
+|---------------------------------------------------------|
+
+The MIT License (MIT)
+Copyright (c) 2016 - Clement Michaud, Sergei Kireev
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY,
+WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+
+#include "intent/utils/ThreadPool.hpp"
+
+namespace intent
+{
+    namespace test
+    {
+        TEST(ThreadPoolTest, run_every_index_exactly_once)
+        {
+            ThreadPool threadPool(4);
+            std::vector<std::atomic<int>> runs(1000);
+            for(std::atomic<int>& run : runs) run = 0;
+
+            threadPool.parallelFor(runs.size(), 7, [&runs](size_t begin, size_t end)
+            {
+                for(size_t i = begin; i < end; ++i) ++runs[i];
+            });
+
+            for(const std::atomic<int>& run : runs) EXPECT_EQ(1, run.load());
+        }
+
+        TEST(ThreadPoolTest, run_several_loops_on_the_same_pool)
+        {
+            ThreadPool threadPool(2);
+            std::atomic<size_t> sum(0);
+
+            for(size_t loop = 0; loop < 20; ++loop)
+            {
+                threadPool.parallelFor(100, 1, [&sum](size_t begin, size_t end)
+                {
+                    for(size_t i = begin; i < end; ++i) sum += i;
+                });
+            }
+
+            EXPECT_EQ(20u * 4950u, sum.load());
+        }
+
+        TEST(ThreadPoolTest, rethrow_the_exception_of_a_range)
+        {
+            ThreadPool threadPool(2);
+            std::atomic<size_t> runs(0);
+
+            EXPECT_THROW(threadPool.parallelFor(10, 1, [&runs](size_t begin, size_t)
+            {
+                ++runs;
+                if(begin == 3) throw std::runtime_error("failure");
+            }), std::runtime_error);
+            EXPECT_EQ(10u, runs.load());
+        }
+    }
+}
@@ -88,5 +88,23 @@ namespace intent
             EXPECT_THAT(tokens, ElementsAre("Hello", "phone", "number", "06 78 66 55 44", "and",
                                             "email", "john.doe@gmail.com", "yeah"));
         }
+
+        TEST(TokenizerTest, split_string_into_views_of_the_input_buffer)
+        {
+            Tokenizer::TokenViews tokens;
+            std::string input = "Call 06 78 66 55 44 (home), please.";
+            std::vector<std::string> regexpList;
+            regexpList.push_back("([0-9]{2}\\s){4}[0-9]{2}");
+            Tokenizer tokenizer(",. ", regexpList);
+
+            tokenizer.tokenize(input, tokens);
+
+            EXPECT_THAT(tokens, ElementsAre("Call", "06 78 66 55 44", "(", "home", ")", "please"));
+            for (const Tokenizer::TokenView& token : tokens)
+            {
+                EXPECT_GE(token.data(), input.data());
+                EXPECT_LE(token.data() + token.size(), input.data() + input.size());
+            }
+        }
     }
 }